@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import glob
+import json
+import time
+import shutil
+import argparse
+import subprocess
+
+# Compile time precision policies of the helix fits of the alpaka program,
+# see src/alpaka/plugin-PixelTriplets/alpaka/FitResult.h
+precision_flags = {
+    "double": "",
+    "mixed": "-DRFIT_PRECISION_MIXED",
+    "float": "-DRFIT_PRECISION_FLOAT",
+}
+default_precision = "double"
+
+# HistoValidator histograms of the quantities that come out of the fits
+fit_histograms = ["track_pt", "track_tip", "track_tip_zoom", "track_zip", "track_zip_zoom", "track_chi2"]
+
+result_re = re.compile("Processed (?P<events>\d+) events in (?P<time>\S+) seconds, throughput (?P<throughput>\S+) events/s")
+
+
+def printMessage(*args):
+    print(time.strftime("%y-%m-%d %H:%M:%S"), *args)
+
+def throughput(output):
+    for line in output:
+        m = result_re.search(line)
+        if m:
+            printMessage(line.rstrip())
+            return float(m.group("throughput"))
+
+    raise Exception("Did not find throughput from the log")
+
+class Histo:
+    def __init__(self, content):
+        self._name = content[0]
+        nbins = int(content[1])-2
+        self._min = float(content[2])
+        self._max = float(content[3])
+        # includes the underflow and overflow bins
+        self._counts = [int(x) for x in content[4:]]
+        self._binWidth = (self._max-self._min) / nbins
+
+    def name(self):
+        return self._name
+
+    def counts(self):
+        return self._counts
+
+    def entries(self):
+        return sum(self._counts)
+
+    def meanRms(self):
+        # over the bin centers, without the underflow and overflow
+        data = self._counts[1:-1]
+        n = sum(data)
+        if n == 0:
+            return (0., 0.)
+        centers = [self._min + (i+0.5)*self._binWidth for i in range(len(data))]
+        mean = sum(c*x for c, x in zip(data, centers)) / n
+        var = sum(c*(x-mean)**2 for c, x in zip(data, centers)) / n
+        return (mean, var**0.5)
+
+def readHistograms(fname):
+    histos = {}
+    with open(fname) as f:
+        for line in f:
+            histo = Histo(line.split())
+            histos[histo.name()] = histo
+    return histos
+
+def compare(ref, histo):
+    (refMean, refRms) = ref.meanRms()
+    (mean, rms) = histo.meanRms()
+    # fraction of the tracks that moved to another bin, assuming the changes to be small
+    migrated = 0.
+    if ref.entries() > 0:
+        migrated = 0.5*sum(abs(a-b) for a, b in zip(ref.counts(), histo.counts())) / ref.entries()
+    return dict(
+        entries=histo.entries(),
+        entriesReference=ref.entries(),
+        mean=mean,
+        meanReference=refMean,
+        rms=rms,
+        rmsReference=refRms,
+        migrated=migrated
+    )
+
+def build(opts, precision):
+    program = os.path.basename(opts.program)
+    flag = precision_flags[precision]
+    # make does not track the compilation flags, the fits have to be recompiled explicitly
+    objDir = os.path.join(opts.baseDir, "obj", program, "plugin-PixelTriplets")
+    command = ["make", "-j", str(opts.jobs), "-C", opts.baseDir, program,
+               "USER_CXXFLAGS="+flag, "USER_CUDAFLAGS="+flag] + opts.makeArgs
+    printMessage("Building", program, "with", precision, "precision fits")
+    if opts.dryRun:
+        print("rm -r", objDir)
+        print(" ".join(command))
+        return
+    if os.path.exists(objDir):
+        shutil.rmtree(objDir)
+    with open(opts.output+"_build_%s.txt" % precision, "w") as logfile:
+        if subprocess.call(command, stdout=logfile, stderr=subprocess.STDOUT) != 0:
+            raise Exception("Build failed, see output in the log file %s" % logfile.name)
+
+def run(opts, precision, workdir, logfilename):
+    os.makedirs(workdir, exist_ok=True)
+    for fname in glob.glob(os.path.join(workdir, "histograms_*.txt")):
+        os.remove(fname)
+    command = [os.path.abspath(opts.program), "--"+opts.backend, "--maxEvents", str(opts.maxEvents),
+               "--numberOfStreams", str(opts.numberOfStreams), "--numberOfThreads", str(opts.numberOfThreads),
+               "--histogram"] + opts.args
+    with open(logfilename, "w") as logfile:
+        logfile.write(" ".join(command))
+        logfile.write("\n----\n")
+        logfile.flush()
+        if opts.dryRun:
+            print(" ".join(command))
+            return (0, None)
+        p = subprocess.Popen(command, cwd=workdir, stdout=logfile, stderr=subprocess.STDOUT, universal_newlines=True)
+        p.wait()
+        if p.returncode != 0:
+            raise Exception("Got return code %d, see output in the log file %s" % (p.returncode, logfilename))
+    with open(logfilename) as logfile:
+        th = throughput(logfile)
+    histoFiles = glob.glob(os.path.join(workdir, "histograms_*.txt"))
+    if len(histoFiles) != 1:
+        raise Exception("Expected one histogram file in %s, found %d" % (workdir, len(histoFiles)))
+    return (th, histoFiles[0])
+
+def main(opts):
+    data = dict(
+        program=opts.program,
+        backend=opts.backend,
+        events=opts.maxEvents,
+        args=" ".join(opts.args),
+        results={}
+    )
+    histoFiles = {}
+    built = None
+    try:
+        for precision in opts.precisions:
+            if opts.build:
+                built = precision
+                build(opts, precision)
+            throughputs = []
+            for i in range(opts.repeat):
+                printMessage("Running with %s precision fits (%d/%d)" % (precision, i+1, opts.repeat))
+                (th, histoFiles[precision]) = run(opts, precision, opts.output+"_"+precision,
+                                                  opts.output+"_log_%s_n%d.txt" % (precision, i))
+                throughputs.append(th)
+            data["results"][precision] = dict(throughput=sum(throughputs)/len(throughputs))
+    finally:
+        # leave the program built with the default precision, also if a build or a run failed
+        if built is not None and built != default_precision:
+            build(opts, default_precision)
+    if opts.dryRun:
+        return
+
+    reference = opts.precisions[0]
+    refHistos = readHistograms(histoFiles[reference])
+    refThroughput = data["results"][reference]["throughput"]
+    print()
+    for precision in opts.precisions:
+        res = data["results"][precision]
+        res["speedup"] = res["throughput"]/refThroughput
+        print("%s: throughput %.2f events/s, %.3f times %s" % (precision, res["throughput"], res["speedup"], reference))
+        if precision == reference:
+            continue
+        histos = readHistograms(histoFiles[precision])
+        res["histograms"] = {}
+        print("  %-16s %12s %12s %12s %12s %10s" % ("histogram", "mean "+reference, "mean", "rms "+reference, "rms", "migrated"))
+        for name in fit_histograms:
+            cmp = compare(refHistos[name], histos[name])
+            res["histograms"][name] = cmp
+            print("  %-16s %12.5g %12.5g %12.5g %12.5g %9.3f%%" % (name, cmp["meanReference"], cmp["mean"],
+                                                                 cmp["rmsReference"], cmp["rms"], 100*cmp["migrated"]))
+            if cmp["entries"] != cmp["entriesReference"]:
+                print("  %-16s number of tracks differs: %d vs %d" % ("", cmp["entries"], cmp["entriesReference"]))
+
+    with open(opts.output+".json", "w") as out:
+        json.dump(data, out, indent=2)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="""Compare the throughput and the track parameters of the alpaka program
+built with the different precision policies of the helix fits. The track parameters are compared with the
+histograms of HistoValidator, against those of the first precision.""")
+    parser.add_argument("program", type=str,
+                        help="Path to the test program to run (e.g. ./alpaka)")
+    parser.add_argument("-o", "--output", type=str, default="fitprecision",
+                        help="Prefix of output JSON, log files, and working directories (default: 'fitprecision')")
+    parser.add_argument("--precisions", type=str, default="double,mixed,float",
+                        help="Comma separated list of the precisions to compare, the first is the reference (default: 'double,mixed,float')")
+    parser.add_argument("--no-build", dest="build", action="store_false",
+                        help="Do not rebuild the program for each precision, e.g. to compare the same build with itself")
+    parser.add_argument("--baseDir", type=str, default=os.path.dirname(os.path.abspath(__file__)),
+                        help="Top level directory of the build (default: directory of this script)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(),
+                        help="Number of parallel jobs for make (default: number of cores)")
+    parser.add_argument("--makeArgs", type=str, default="",
+                        help="Space separated list of additional make arguments (e.g. 'CUDA_BASE=...')")
+    parser.add_argument("--backend", type=str, default="serial", choices=["serial", "tbb", "cuda"],
+                        help="Backend to run (default: 'serial')")
+    parser.add_argument("--maxEvents", type=int, default=1000,
+                        help="Number of events to process (default: 1000, i.e. the full dataset)")
+    parser.add_argument("--numberOfThreads", type=int, default=1,
+                        help="Number of threads (default: 1)")
+    parser.add_argument("--numberOfStreams", type=int, default=1,
+                        help="Number of concurrent events (default: 1)")
+    parser.add_argument("--repeat", type=int, default=1,
+                        help="Repeat each measurement N times, the throughput is averaged (default: 1)")
+    parser.add_argument("--dryRun", action="store_true",
+                        help="Print out commands, don't actually run anything")
+
+    parser.add_argument("args", nargs=argparse.REMAINDER)
+
+    opts = parser.parse_args()
+    if opts.repeat < 1:
+        parser.error("Need at least one repetition")
+    if len(opts.args) > 0 and opts.args[0] == "--":
+        opts.args = opts.args[1:]
+    opts.precisions = opts.precisions.split(",")
+    for p in opts.precisions:
+        if p not in precision_flags:
+            parser.error("Unknown precision %s, possible values are %s" % (p, ",".join(precision_flags.keys())))
+    opts.makeArgs = opts.makeArgs.split()
+
+    main(opts)
@@ -0,0 +1,386 @@
+#!/usr/bin/env python3
+
+import os
+import re
+import json
+import time
+import socket
+import argparse
+import subprocess
+import multiprocessing
+
+# Number of events for each application, in units of the 1000 events of the input file
+n_events_unit = 1000
+n_blocks_per_stream = {
+    "fwtest": 1,
+    "cuda": {"": 100, "transfer": 100},
+    "cudadev": {"": 100, "transfer": 100},
+    "cudauvm": {"": 100, "transfer": 100},
+    "cudacompat": {"": 8},
+    "alpaka": {"": 8, "transfer": 8},
+    "kokkos": {"": 8, "transfer": 8},
+}
+
+# Backends that are chosen at run time with a command line option. A program lists in its --help only the
+# backends it was built with (e.g. kokkos without KOKKOS_HOST_PARALLEL has no --pthread or --openmp), see
+# supportedBackends()
+program_backends = {
+    "alpaka": ["serial", "tbb", "cuda"],
+    "kokkos": ["serial", "pthread", "openmp", "cuda", "hip"],
+}
+cpu_backends = ["serial", "tbb", "pthread", "openmp"]
+
+result_re = re.compile("Processed (?P<events>\d+) events in (?P<time>\S+) seconds, throughput (?P<throughput>\S+) events/s")
+
+
+def printMessage(*args):
+    print(time.strftime("%y-%m-%d %H:%M:%S"), *args)
+
+def throughput(output):
+    for line in output:
+        m = result_re.search(line)
+        if m:
+            printMessage(line.rstrip())
+            return (float(m.group("throughput")), float(m.group("time")))
+
+    raise Exception("Did not find throughput from the log")
+
+def parseCpuList(cpulist):
+    # e.g. "0-3,8-11"
+    cores = []
+    for item in cpulist.strip().split(","):
+        if item == "":
+            continue
+        if "-" in item:
+            (first, last) = item.split("-")
+            cores.extend(range(int(first), int(last)+1))
+        else:
+            cores.append(int(item))
+    return cores
+
+def numaNodes():
+    # map of NUMA node to its cores, a single node with all the cores if the information is not available
+    nodeDir = "/sys/devices/system/node"
+    nodes = {}
+    if os.path.isdir(nodeDir):
+        for name in os.listdir(nodeDir):
+            m = re.match("node(?P<node>\d+)$", name)
+            if m:
+                with open(os.path.join(nodeDir, name, "cpulist")) as f:
+                    cores = parseCpuList(f.read())
+                if len(cores) > 0:
+                    nodes[int(m.group("node"))] = cores
+    if len(nodes) == 0:
+        nodes[0] = list(range(0, multiprocessing.cpu_count()))
+    return nodes
+
+def percentile(values, fraction):
+    # linear interpolation between the closest ranks
+    s = sorted(values)
+    pos = fraction*(len(s)-1)
+    low = int(pos)
+    high = min(low+1, len(s)-1)
+    return s[low] + (s[high]-s[low])*(pos-low)
+
+def statistics(values):
+    n = len(values)
+    mean = sum(values)/n
+    stdev = (sum((x-mean)**2 for x in values)/(n-1))**0.5 if n > 1 else 0.
+    return dict(
+        trials=n,
+        median=percentile(values, 0.5),
+        mean=mean,
+        stdev=stdev,
+        min=min(values),
+        max=max(values),
+        p10=percentile(values, 0.1),
+        p90=percentile(values, 0.9),
+    )
+
+def commandOutput(command, cwd=None):
+    try:
+        return subprocess.check_output(command, cwd=cwd, stderr=subprocess.DEVNULL, universal_newlines=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+def supportedBackends(opts):
+    # the backend options listed in the --help of the program, None if the program can not be run
+    backends = program_backends.get(os.path.basename(opts.program), [])
+    output = commandOutput([opts.program, "--help"])
+    if output is None:
+        return None
+    options = set(re.findall("\\[--(\\w+)\\]", output))
+    return [b for b in backends if b in options]
+
+def environment(opts):
+    # to tell apart the results of different commits and nodes
+    baseDir = os.path.dirname(os.path.abspath(__file__))
+    cpuModel = None
+    if os.path.exists("/proc/cpuinfo"):
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    cpuModel = line.split(":", 1)[1].strip()
+                    break
+    status = commandOutput(["git", "status", "--porcelain", "--untracked-files=no"], cwd=baseDir)
+    return dict(
+        date=time.strftime("%Y-%m-%d %H:%M:%S"),
+        host=socket.gethostname(),
+        cpu=cpuModel,
+        cores=multiprocessing.cpu_count(),
+        numaNodes=len(numaNodes()),
+        commit=commandOutput(["git", "rev-parse", "HEAD"], cwd=baseDir),
+        dirty=(status is not None and status != ""),
+    )
+
+def pinning(opts, nth):
+    # run on the first nth cores of the NUMA node, and allocate the memory there
+    if opts.numaNode is None:
+        return ([], None)
+    cores = numaNodes()[opts.numaNode]
+    if nth > len(cores):
+        raise Exception("NUMA node %d has only %d cores, asked for %d threads" % (opts.numaNode, len(cores), nth))
+    cores = ",".join(str(x) for x in cores[0:nth])
+    if opts.numactl:
+        return (["numactl", "--physcpubind="+cores, "--membind="+str(opts.numaNode)], cores)
+    return (["taskset", "-c", cores], cores)
+
+def run(backend, nev, nstr, nth, opts, logfilename):
+    with open(logfilename, "w") as logfile:
+        (pin, cores) = pinning(opts, nth)
+        command = [opts.program, "--maxEvents", str(nev), "--numberOfStreams", str(nstr), "--numberOfThreads", str(nth)]
+        if backend != "":
+            command.append("--"+backend)
+        command += opts.args
+
+        logfile.write(" ".join(pin+command))
+        logfile.write("\n----\n")
+        logfile.flush()
+        if opts.dryRun:
+            print(" ".join(pin+command))
+            return (0, 0)
+        p = subprocess.Popen(pin+command, stdout=logfile, stderr=subprocess.STDOUT, universal_newlines=True)
+        try:
+            p.wait()
+        except KeyboardInterrupt:
+            try:
+                p.terminate()
+            except OSError:
+                pass
+            p.wait()
+            raise
+        if p.returncode != 0:
+            raise Exception("Got return code %d, see output in the log file %s" % (p.returncode, logfilename))
+    with open(logfilename) as logfile:
+        return throughput(logfile)
+
+def eventsPerStream(opts):
+    if opts.eventsPerStream is not None:
+        return opts.eventsPerStream
+    tmp = n_blocks_per_stream.get(os.path.basename(opts.program), None)
+    if tmp is None:
+        raise Exception("No default number of event blocks for program %s, and --eventsPerStream was not given" % opts.program)
+    if isinstance(tmp, dict):
+        if "--transfer" in opts.args:
+            tmp = tmp["transfer"]
+        else:
+            tmp = tmp[""]
+    return tmp * n_events_unit
+
+def key(res):
+    return (res["program"], res["backend"], res["args"], res["streams"], res["threads"])
+
+def compare(data, reference, tolerance):
+    # compare the median throughputs with those of a previous benchmark, e.g. of another commit
+    refResults = {key(res): res for res in reference["results"]}
+    regressions = 0
+    print("Comparison to %s (commit %s, host %s)" % (reference["filename"], reference["environment"]["commit"],
+                                                     reference["environment"]["host"]))
+    for res in data["results"]:
+        ref = refResults.get(key(res), None)
+        if ref is None:
+            continue
+        ratio = res["median"]/ref["median"]
+        # a change within the spread of the trials is not significant
+        spread = (ref["p90"]-ref["p10"])/ref["median"]
+        flag = ""
+        if ratio < 1-max(tolerance, spread):
+            flag = "REGRESSION"
+            regressions += 1
+        elif ratio > 1+max(tolerance, spread):
+            flag = "improvement"
+        res["reference"] = dict(median=ref["median"], ratio=ratio)
+        print("  %-8s streams %3d threads %3d: median %10.2f events/s, reference %10.2f, ratio %.3f %s" % (
+            res["backend"], res["streams"], res["threads"], res["median"], ref["median"], ratio, flag))
+    return regressions
+
+def main(opts):
+    program = os.path.basename(opts.program)
+    nev_per_stream = eventsPerStream(opts)
+
+    backends = opts.backends
+    if backends is None:
+        backends = [b for b in program_backends.get(program, [""]) if b in cpu_backends or b == ""]
+    elif program not in program_backends:
+        raise Exception("Program %s does not support choosing the backend at run time" % program)
+    if program in program_backends:
+        supported = supportedBackends(opts)
+        if supported is None:
+            if not opts.dryRun:
+                raise Exception("Unable to run %s --help to find its backends" % opts.program)
+        elif opts.backends is not None:
+            missing = [b for b in backends if b not in supported]
+            if len(missing) > 0:
+                raise Exception("Program %s was not built with the backend(s) %s, it supports %s" % (
+                    opts.program, ",".join(missing), ",".join(supported)))
+        else:
+            for b in backends:
+                if b not in supported:
+                    printMessage("Skipping backend %s, program %s was not built with it" % (b, opts.program))
+            backends = [b for b in backends if b in supported]
+        if len(backends) == 0:
+            raise Exception("None of the requested backends is supported by program %s" % opts.program)
+
+    nthreads = opts.numThreads
+    if len(nthreads) == 0:
+        nthreads = [1]
+    n_streams_threads = [(t, t) for t in nthreads]
+    if len(opts.numStreams) > 0:
+        n_streams_threads = [(s, t) for t in nthreads for s in opts.numStreams]
+
+    data = dict(
+        program=opts.program,
+        args=" ".join(opts.args),
+        numaNode=opts.numaNode,
+        warmup=opts.warmup,
+        environment=environment(opts),
+        results=[]
+    )
+    outputJson = opts.output+".json"
+    logDir = opts.output+"_logs"
+    os.makedirs(logDir, exist_ok=True)
+
+    for backend in backends:
+        for nstr, nth in n_streams_threads:
+            if opts.maxStreamsToAddEvents > 0 and nstr > opts.maxStreamsToAddEvents:
+                nev = nev_per_stream * opts.maxStreamsToAddEvents
+            else:
+                nev = nev_per_stream*nstr
+            name = "%s_nstr%d_nth%d" % (backend if backend != "" else "default", nstr, nth)
+
+            msg = "Backend %s streams %d threads %d events %d" % (backend if backend != "" else "default", nstr, nth, nev)
+            if opts.numaNode is not None:
+                msg += ", on NUMA node %d" % opts.numaNode
+            printMessage(msg)
+            # the first runs fill the page cache, the caching allocators of a GPU, and let the CPU frequency settle
+            for i in range(opts.warmup):
+                printMessage("Warming up (%d/%d)" % (i+1, opts.warmup))
+                run(backend, opts.warmupEvents if opts.warmupEvents > 0 else nev, nstr, nth, opts,
+                    os.path.join(logDir, "%s_warmup%d.txt" % (name, i)))
+
+            throughputs = []
+            times = []
+            for i in range(opts.repeat):
+                (th, wtime) = run(backend, nev, nstr, nth, opts, os.path.join(logDir, "%s_n%d.txt" % (name, i)))
+                throughputs.append(th)
+                times.append(wtime)
+            if opts.dryRun:
+                continue
+
+            res = dict(
+                program=program,
+                backend=backend,
+                args=data["args"],
+                streams=nstr,
+                threads=nth,
+                events=nev,
+                throughputs=throughputs,
+                times=times,
+            )
+            res.update(statistics(throughputs))
+            data["results"].append(res)
+            printMessage("Backend %s streams %d threads %d, throughput median %f p10 %f p90 %f events/s" % (
+                backend if backend != "" else "default", nstr, nth, res["median"], res["p10"], res["p90"]))
+            print()
+            # Save results after each point
+            with open(outputJson, "w") as out:
+                json.dump(data, out, indent=2)
+
+    if opts.dryRun:
+        return 0
+
+    print("%-8s %7s %7s %12s %12s %12s %8s" % ("backend", "streams", "threads", "median", "p10", "p90", "stdev"))
+    for res in data["results"]:
+        print("%-8s %7d %7d %12.2f %12.2f %12.2f %7.2f%%" % (res["backend"] if res["backend"] != "" else "default",
+                                                             res["streams"], res["threads"], res["median"],
+                                                             res["p10"], res["p90"], 100*res["stdev"]/res["mean"]))
+    print()
+
+    regressions = 0
+    if opts.compare is not None:
+        with open(opts.compare) as inp:
+            reference = json.load(inp)
+        reference["filename"] = opts.compare
+        regressions = compare(data, reference, opts.tolerance)
+        with open(outputJson, "w") as out:
+            json.dump(data, out, indent=2)
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="""Benchmark the throughput of a test program with repeated trials,
+and report the median and the spread of the trials. The results, together with the commit and the node they were
+obtained on, are written in a JSON file that can be compared to in later benchmarks with --compare.""")
+    parser.add_argument("program", type=str,
+                        help="Path to the test program to run")
+    parser.add_argument("-o", "--output", type=str, default="benchmark",
+                        help="Prefix of output JSON and the directory of the log files (default: 'benchmark')")
+    parser.add_argument("--backends", type=str, default=None,
+                        help="Comma separated list of backends to run, for the programs that choose them at run time (alpaka, kokkos) (default: all CPU backends)")
+    parser.add_argument("--numThreads", type=str, default="",
+                        help="Comma separated list of numbers of threads (default: 1)")
+    parser.add_argument("--numStreams", type=str, default="",
+                        help="Comma separated list of numbers of streams (default: empty for always the same as the number of threads). All the combinations with the numbers of threads are run")
+    parser.add_argument("--eventsPerStream", type=int, default=None,
+                        help="Number of events to be used per EDM stream (default: hardcoded in the top of the script file for each program)")
+    parser.add_argument("--maxStreamsToAddEvents", type=int, default=-1,
+                        help="Maximum number of streams to add events (default: -1 for no limit")
+    parser.add_argument("--repeat", type=int, default=5,
+                        help="Number of measured trials of each point (default: 5)")
+    parser.add_argument("--warmup", type=int, default=1,
+                        help="Number of unmeasured runs before the trials of each point (default: 1)")
+    parser.add_argument("--warmupEvents", type=int, default=0,
+                        help="Number of events of the warm up runs (default: 0 for the same as the trials)")
+    parser.add_argument("--numaNode", type=int, default=None,
+                        help="Pin the threads to the cores of this NUMA node, and allocate the memory there (default: no pinning)")
+    parser.add_argument("--no-numactl", dest="numactl", action="store_false",
+                        help="Pin with taskset instead of numactl (the memory is then allocated where it is first touched)")
+    parser.add_argument("--compare", type=str, default=None,
+                        help="JSON file of a previous benchmark to compare the median throughputs to; the exit code is 1 if any point is slower")
+    parser.add_argument("--tolerance", type=float, default=0.05,
+                        help="Relative change of the median throughput to be reported with --compare, if larger than the spread of the reference trials (default: 0.05)")
+    parser.add_argument("--dryRun", action="store_true",
+                        help="Print out commands, don't actually run anything")
+
+    parser.add_argument("args", nargs=argparse.REMAINDER)
+
+    opts = parser.parse_args()
+    if opts.repeat < 1:
+        parser.error("Need at least one trial")
+    if opts.warmup < 0:
+        parser.error("warmup must be >= 0, got %d" % opts.warmup)
+    if len(opts.args) > 0 and opts.args[0] == "--":
+        opts.args = opts.args[1:]
+    if opts.backends is not None:
+        opts.backends = opts.backends.split(",")
+    opts.numThreads = [int(x) for x in opts.numThreads.split(",")] if opts.numThreads != "" else []
+    opts.numStreams = [int(x) for x in opts.numStreams.split(",")] if opts.numStreams != "" else []
+    if opts.numaNode is not None:
+        nodes = numaNodes()
+        if opts.numaNode not in nodes:
+            parser.error("Unknown NUMA node %d, available nodes are %s" % (opts.numaNode, ",".join(str(x) for x in sorted(nodes.keys()))))
+        if opts.numactl and commandOutput(["numactl", "--show"]) is None:
+            print("numactl not found, pinning with taskset")
+            opts.numactl = False
+
+    exit(main(opts))
@@ -15,6 +15,7 @@ n_blocks_per_stream = {
     "cuda": {"": 100, "transfer": 100},
     "cudauvm": {"": 100, "transfer": 100},
     "cudacompat": {"": 8},
+    "alpaka": {"": 8, "transfer": 8},
 }
 
 result_re = re.compile("Processed (?P<events>\d+) events in (?P<time>\S+) seconds, throughput (?P<throughput>\S+) events/s")
@@ -79,6 +80,10 @@ def main(opts):
     n_streams_threads = [(i, i) for i in nthreads]
     if len(opts.numStreams) > 0:
         n_streams_threads = [(s, t) for t in nthreads for s in opts.numStreams]
+    elif opts.streamSplit:
+        # for each number of threads, scan the number of streams over its divisors, i.e. over the
+        # split between inter-event (streams) and intra-event (threads per stream) parallelism
+        n_streams_threads = [(s, t) for t in nthreads for s in range(1, t+1) if t % s == 0]
 
     nev_per_stream = opts.eventsPerStream
     if nev_per_stream is None:
@@ -193,6 +198,8 @@ if __name__ == "__main__":
                         help="Comma separated list of numbers of threads to use in the scan (default: empty for all)")
     parser.add_argument("--numStreams", type=str, default="",
                         help="Comma separated list of numbers of streams to use in the scan (default: empty for always the same as the number of threads). If both number of threads and number of streams have more than 1 element, a 2D scan is done with all the combinations")
+    parser.add_argument("--streamSplit", action="store_true",
+                        help="For each number of threads, scan the number of streams over the divisors of the number of threads (ignored if --numStreams is given)")
     parser.add_argument("--eventsPerStream", type=int, default=None,
                         help="Number of events to be used per EDM stream (default: 400*4kev for cuda, others also hardcoded in the top of the script file)")
     parser.add_argument("--maxStreamsToAddEvents", type=int, default=-1,
@@ -39,7 +39,13 @@ namespace cms {
         c += incr;
 
         Atomic2 ret;
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED
+        // a single thread at a time runs the kernels of the serial backend
+        ret.ac = counter.ac;
+        counter.ac += c;
+#else
         ret.ac = alpaka::atomicAdd(acc, &counter.ac, c, alpaka::hierarchy::Blocks{});
+#endif
         return ret.counters;
       }
 
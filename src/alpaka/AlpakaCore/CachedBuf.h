@@ -0,0 +1,110 @@
+#ifndef AlpakaCore_CachedBuf_h
+#define AlpakaCore_CachedBuf_h
+
+#include <memory>
+#include <utility>
+
+#include <alpaka/alpaka.hpp>
+
+namespace cms {
+  namespace alpakatools {
+
+    /*
+     * One-dimensional buffer whose memory is owned by a caching allocator.
+     *
+     * The memory block is returned to the allocator when the last copy of the
+     * CachedBuf goes out of scope. Copies share the same memory, like alpaka::Buf.
+     * The alpaka view traits are specialized below, so that a CachedBuf can be used
+     * with alpaka::getPtrNative, alpaka::memcpy and alpaka::memset as a regular buffer.
+     */
+    template <typename TDev, typename TElem, typename TIdx>
+    class CachedBuf {
+    public:
+      using Dev = TDev;
+      using Elem = TElem;
+      using Idx = TIdx;
+
+      CachedBuf(TDev const& dev, TElem* ptr, TIdx extent, std::shared_ptr<void> owner)
+          : dev_{dev}, ptr_{ptr}, extent_{extent}, owner_{std::move(owner)} {}
+
+      TDev const& dev() const { return dev_; }
+      TElem* data() { return ptr_; }
+      TElem const* data() const { return ptr_; }
+      TIdx extent() const { return extent_; }
+
+    private:
+      TDev dev_;
+      TElem* ptr_;
+      TIdx extent_;
+      std::shared_ptr<void> owner_;
+    };
+
+  }  // namespace alpakatools
+}  // namespace cms
+
+namespace alpaka {
+  namespace traits {
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct DevType<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      using type = TDev;
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct GetDev<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      ALPAKA_FN_HOST static auto getDev(cms::alpakatools::CachedBuf<TDev, TElem, TIdx> const& buf) -> TDev {
+        return buf.dev();
+      }
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct DimType<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      using type = DimInt<1u>;
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct ElemType<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      using type = TElem;
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct IdxType<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      using type = TIdx;
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct GetExtent<DimInt<0u>, cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      ALPAKA_FN_HOST static auto getExtent(cms::alpakatools::CachedBuf<TDev, TElem, TIdx> const& buf) -> TIdx {
+        return buf.extent();
+      }
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct GetPtrNative<cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      ALPAKA_FN_HOST static auto getPtrNative(cms::alpakatools::CachedBuf<TDev, TElem, TIdx> const& buf)
+          -> TElem const* {
+        return buf.data();
+      }
+      ALPAKA_FN_HOST static auto getPtrNative(cms::alpakatools::CachedBuf<TDev, TElem, TIdx>& buf) -> TElem* {
+        return buf.data();
+      }
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct GetPitchBytes<DimInt<0u>, cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      ALPAKA_FN_HOST static auto getPitchBytes(cms::alpakatools::CachedBuf<TDev, TElem, TIdx> const& buf) -> TIdx {
+        return static_cast<TIdx>(buf.extent() * sizeof(TElem));
+      }
+    };
+
+    template <typename TDev, typename TElem, typename TIdx>
+    struct GetOffset<DimInt<0u>, cms::alpakatools::CachedBuf<TDev, TElem, TIdx>> {
+      ALPAKA_FN_HOST static auto getOffset(cms::alpakatools::CachedBuf<TDev, TElem, TIdx> const&) -> TIdx {
+        return 0u;
+      }
+    };
+
+  }  // namespace traits
+}  // namespace alpaka
+
+#endif  // AlpakaCore_CachedBuf_h
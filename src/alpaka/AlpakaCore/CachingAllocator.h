@@ -0,0 +1,308 @@
+#ifndef AlpakaCore_CachingAllocator_h
+#define AlpakaCore_CachingAllocator_h
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <alpaka/alpaka.hpp>
+
+#include "AlpakaCore/allocatorStatus.h"
+
+namespace cms {
+  namespace alpakatools {
+
+    /*
+     * A simple caching allocator for alpaka memory, modelled after notcub::CachingDeviceAllocator
+     * (see CUDACore/CachingDeviceAllocator.h in the cuda program).
+     *
+     * - The memory blocks are alpaka buffers of std::byte allocated on the device TDev.
+     * - Allocations are categorized and cached by bin size. Bin limits progress geometrically
+     *   with the growth factor binGrowth. A request of a given size only considers cached blocks
+     *   in the corresponding bin.
+     * - Requests below binGrowth^minBin are rounded up to binGrowth^minBin bytes.
+     * - Requests above binGrowth^maxBin are not rounded up, and are simply freed when they are
+     *   returned instead of being cached.
+     * - If the total storage of cached blocks would exceed maxCachedBytes, returned blocks are
+     *   freed instead of being cached. A value of 0 means no limit.
+     * - The blocks start at a multiple of alignment bytes, whatever the alignment of the underlying
+     *   alpaka buffers, e.g. for the columns of an AlpakaCore/SoALayout.h layout.
+     * - An allocation can be associated with a queue. Once freed, the block becomes available
+     *   immediately for reuse within the same queue, and for any other queue (or for allocations
+     *   without a queue) once all the work submitted to that queue before the free has completed.
+     *   Blocks allocated without a queue become available as soon as they are freed.
+     *
+     * The public interface is thread safe.
+     */
+    template <typename TDev, typename TQueue>
+    class CachingAllocator {
+    public:
+      using Device = TDev;
+      using Queue = TQueue;
+      using Event = alpaka::Event<TQueue>;
+      using Idx = uint32_t;
+      using Buffer = alpaka::Buf<TDev, std::byte, alpaka::DimInt<1u>, Idx>;
+
+      static constexpr unsigned int invalidBin = std::numeric_limits<unsigned int>::max();
+      static constexpr size_t alignment = 128;
+
+      CachingAllocator(TDev const& device,
+                       std::string name,
+                       unsigned int binGrowth,  // geometric growth factor for bin sizes
+                       unsigned int minBin,     // smallest bin, binGrowth^minBin bytes
+                       unsigned int maxBin,     // largest bin, binGrowth^maxBin bytes
+                       size_t maxCachedBytes,   // total storage for the cached blocks, 0 means no limit
+                       bool enableCaching,      // if false, blocks are always freed when returned
+                       bool debug)
+          : device_{device},
+            binGrowth_{binGrowth},
+            minBin_{minBin},
+            maxBin_{maxBin},
+            minBinBytes_{intPow(binGrowth, minBin)},
+            maxBinBytes_{intPow(binGrowth, maxBin)},
+            maxCachedBytes_{maxCachedBytes == 0 ? std::numeric_limits<size_t>::max() : maxCachedBytes},
+            enableCaching_{enableCaching},
+            debug_{debug} {
+        statusId_ = allocator::registerAllocator(std::move(name), [this]() { return status(); });
+      }
+
+      ~CachingAllocator() {
+        allocator::unregisterAllocator(statusId_);
+        freeAllCached();
+      }
+
+      CachingAllocator(CachingAllocator const&) = delete;
+      CachingAllocator& operator=(CachingAllocator const&) = delete;
+
+      // Allocate a block of at least the given size, not associated with any queue
+      void* allocate(size_t bytes) { return allocateImpl(bytes, std::nullopt); }
+
+      // Allocate a block of at least the given size, associated with the given queue
+      void* allocate(size_t bytes, Queue const& queue) { return allocateImpl(bytes, queue); }
+
+      // Return a block to the allocator
+      void free(void* ptr) {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        auto blockIt = liveBlocks_.find(ptr);
+        if (blockIt == liveBlocks_.end()) {
+          throw std::runtime_error("Trying to free a non-live block at " +
+                                   std::to_string(reinterpret_cast<size_t>(ptr)));
+        }
+        BlockDescriptor block = std::move(blockIt->second);
+        liveBlocks_.erase(blockIt);
+        cachedBytes_.live -= block.bytes;
+        cachedBytes_.liveRequested -= block.requested;
+
+        bool recache = enableCaching_ and block.bin != invalidBin and
+                       cachedBytes_.free + block.bytes <= maxCachedBytes_;
+        if (recache) {
+          if (block.queue) {
+            // record the point in the queue after which the block can be reused by another queue
+            if (not block.event) {
+              block.event = Event{alpaka::getDev(*block.queue)};
+            }
+            alpaka::enqueue(*block.queue, *block.event);
+          }
+          cachedBytes_.free += block.bytes;
+          if (debug_) {
+            printf(
+                "\tReturned %zu bytes at %p to the cache, %zu cached blocks (%zu bytes), %zu live blocks (%zu bytes)\n",
+                block.bytes,
+                ptr,
+                cachedBlocks_.size() + 1,
+                cachedBytes_.free,
+                liveBlocks_.size(),
+                cachedBytes_.live);
+          }
+          cachedBlocks_.emplace(block.bin, std::move(block));
+        } else {
+          ++stats_.deallocations;
+          if (debug_) {
+            printf("\tFreed %zu bytes at %p, %zu cached blocks (%zu bytes), %zu live blocks (%zu bytes)\n",
+                   block.bytes,
+                   ptr,
+                   cachedBlocks_.size(),
+                   cachedBytes_.free,
+                   liveBlocks_.size(),
+                   cachedBytes_.live);
+          }
+          lock.unlock();
+          if (block.queue) {
+            // make sure the device is done with the block before releasing the memory
+            alpaka::wait(*block.queue);
+          }
+          // the memory is released when block goes out of scope
+        }
+      }
+
+      // Free all the cached blocks
+      void freeAllCached() {
+        std::scoped_lock lock(mutex_);
+        stats_.deallocations += cachedBlocks_.size();
+        cachedBlocks_.clear();
+        cachedBytes_.free = 0;
+      }
+
+      allocator::AllocatorStatistics status() const {
+        std::scoped_lock lock(mutex_);
+        allocator::AllocatorStatistics ret = stats_;
+        ret.bytes = cachedBytes_;
+        return ret;
+      }
+
+      size_t maxAllocationSize() const { return std::numeric_limits<Idx>::max() - (alignment - 1); }
+
+      static size_t intPow(unsigned int base, unsigned int exp) {
+        size_t ret = 1;
+        while (exp > 0) {
+          ret *= base;
+          --exp;
+        }
+        return ret;
+      }
+
+    private:
+      struct BlockDescriptor {
+        std::optional<Buffer> buffer;
+        std::optional<Queue> queue;
+        std::optional<Event> event;
+        size_t bytes = 0;
+        size_t requested = 0;
+        unsigned int bin = invalidBin;
+
+        // the block can be reused if it was not associated with a queue, or if the work
+        // submitted to the associated queue before it was freed has completed
+        bool isAvailable() const { return not event or alpaka::isComplete(*event); }
+      };
+
+      void* allocateImpl(size_t bytes, std::optional<Queue> queue) {
+        if (bytes > maxAllocationSize()) {
+          throw std::runtime_error("Tried to allocate " + std::to_string(bytes) +
+                                   " bytes, but the allocator maximum is " + std::to_string(maxAllocationSize()));
+        }
+
+        BlockDescriptor block;
+        block.requested = bytes;
+        block.queue = std::move(queue);
+        auto [bin, binBytes] = findBin(bytes);
+        block.bin = bin;
+        block.bytes = binBytes;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++stats_.requests;
+        if (block.bin != invalidBin and tryReuseCachedBlock(block)) {
+          ++stats_.cacheHits;
+        } else {
+          ++stats_.allocations;
+          lock.unlock();
+          allocateNewBlock(block);
+          lock.lock();
+        }
+
+        void* ptr = alignedPtr(*block.buffer);
+        cachedBytes_.live += block.bytes;
+        cachedBytes_.liveRequested += block.requested;
+        cachedBytes_.maxLive = std::max(cachedBytes_.maxLive, cachedBytes_.live);
+        liveBlocks_.emplace(ptr, std::move(block));
+        return ptr;
+      }
+
+      // compute the bin and the rounded size for a request of the given number of bytes
+      std::pair<unsigned int, size_t> findBin(size_t bytes) const {
+        if (bytes > maxBinBytes_) {
+          // the block is allocated exactly, and it will not be cached when returned
+          return {invalidBin, bytes};
+        }
+        if (bytes <= minBinBytes_) {
+          return {minBin_, minBinBytes_};
+        }
+        unsigned int bin = minBin_;
+        size_t binBytes = minBinBytes_;
+        while (binBytes < bytes) {
+          ++bin;
+          binBytes *= binGrowth_;
+        }
+        return {bin, binBytes};
+      }
+
+      // must be called with the mutex held
+      bool tryReuseCachedBlock(BlockDescriptor& block) {
+        auto [begin, end] = cachedBlocks_.equal_range(block.bin);
+        for (auto it = begin; it != end; ++it) {
+          // reuse a block from the same queue, or from an idle queue
+          bool sameQueue = block.queue and it->second.queue and *block.queue == *it->second.queue;
+          if (sameQueue or it->second.isAvailable()) {
+            block.buffer = std::move(it->second.buffer);
+            if (sameQueue) {
+              // the event can only be recorded again on the same queue
+              block.event = std::move(it->second.event);
+            }
+            cachedBytes_.free -= block.bytes;
+            if (debug_) {
+              printf("\tReused cached block at %p (%zu bytes)\n", alignedPtr(*block.buffer), block.bytes);
+            }
+            cachedBlocks_.erase(it);
+            return true;
+          }
+        }
+        return false;
+      }
+
+      // start of the usable memory of a block, see allocateNewBlock()
+      static void* alignedPtr(Buffer& buffer) {
+        auto address = reinterpret_cast<uintptr_t>(alpaka::getPtrNative(buffer));
+        return reinterpret_cast<void*>((address + alignment - 1) / alignment * alignment);
+      }
+
+      // must be called without holding the mutex
+      void allocateNewBlock(BlockDescriptor& block) {
+        // the buffer has room for the block at the next multiple of alignment bytes
+        Idx const bufferBytes = static_cast<Idx>(block.bytes + alignment - 1);
+        try {
+          block.buffer = alpaka::allocBuf<std::byte, Idx>(device_, bufferBytes);
+        } catch (std::exception const&) {
+          // the allocation attempt failed: free all cached blocks and retry
+          if (debug_) {
+            printf("\tFailed to allocate %zu bytes, retrying after freeing cached allocations\n", block.bytes);
+          }
+          freeAllCached();
+          block.buffer = alpaka::allocBuf<std::byte, Idx>(device_, bufferBytes);
+        }
+        if (debug_) {
+          printf("\tAllocated new block at %p (%zu bytes)\n", alignedPtr(*block.buffer), block.bytes);
+        }
+      }
+
+      mutable std::mutex mutex_;
+      TDev device_;
+
+      std::multimap<unsigned int, BlockDescriptor> cachedBlocks_;  // blocks available for reuse, by bin
+      std::map<void*, BlockDescriptor> liveBlocks_;                // blocks in use, by address
+
+      allocator::TotalBytes cachedBytes_;
+      allocator::AllocatorStatistics stats_;
+      int statusId_;
+
+      const unsigned int binGrowth_;
+      const unsigned int minBin_;
+      const unsigned int maxBin_;
+      const size_t minBinBytes_;
+      const size_t maxBinBytes_;
+      const size_t maxCachedBytes_;
+      const bool enableCaching_;
+      const bool debug_;
+    };
+
+  }  // namespace alpakatools
+}  // namespace cms
+
+#endif  // AlpakaCore_CachingAllocator_h
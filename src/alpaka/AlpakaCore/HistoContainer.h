@@ -7,8 +7,8 @@
 #include <type_traits>
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaCore/AtomicPairCounter.h"
-#include "AlpakaCore/alpakastdAlgorithm.h"
 #include "AlpakaCore/prefixScan.h"
 
 namespace cms {
@@ -21,15 +21,12 @@ namespace cms {
                                     uint32_t nh,
                                     T const *__restrict__ v,
                                     uint32_t const *__restrict__ offsets) const {
-        const uint32_t nt = offsets[nh];
-        cms::alpakatools::for_each_element_in_grid_strided(acc, nt, [&](uint32_t i) {
-          auto off = alpaka_std::upper_bound(offsets, offsets + nh + 1, i);
-          assert((*off) > 0);
-          int32_t ih = off - offsets - 1;
-          assert(ih >= 0);
-          assert(ih < int(nh));
-          h->count(acc, v[i], ih);
-        });
+        // the elements of each histogram are contiguous: loop over their range, instead of looking for the
+        // histogram of each element in offsets
+        for (uint32_t ih = 0; ih < nh; ++ih) {
+          cms::alpakatools::for_each_element_in_grid_strided(
+              acc, offsets[ih + 1], offsets[ih], [&](uint32_t i) { h->count(acc, v[i], ih); });
+        }
       }
     };
 
@@ -40,17 +37,55 @@ namespace cms {
                                     uint32_t nh,
                                     T const *__restrict__ v,
                                     uint32_t const *__restrict__ offsets) const {
-        const uint32_t nt = offsets[nh];
-        cms::alpakatools::for_each_element_in_grid_strided(acc, nt, [&](uint32_t i) {
-          auto off = alpaka_std::upper_bound(offsets, offsets + nh + 1, i);
-          assert((*off) > 0);
-          int32_t ih = off - offsets - 1;
-          assert(ih >= 0);
-          assert(ih < int(nh));
-          h->fill(acc, v[i], i, ih);
-        });
+        for (uint32_t ih = 0; ih < nh; ++ih) {
+          cms::alpakatools::for_each_element_in_grid_strided(
+              acc, offsets[ih + 1], offsets[ih], [&](uint32_t i) { h->fill(acc, v[i], i, ih); });
+        }
+      }
+    };
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+    // On the CPU backends each block is run by a single thread, and block ih owns the bins of histogram ih,
+    // whose elements are the range [offsets[ih], offsets[ih + 1]) of the input: the counts are plain increments,
+    // the prefix scan of the bins of the histogram starts from offsets[ih], and the fill needs no atomics either.
+    // The last block sets the bins of the histograms beyond nh. The offsets and the order of the elements in the
+    // bins are the same as with countFromVector, launchFinalize and fillFromVector, run by a single thread.
+    struct fillManyFromVectorPerHisto {
+      template <typename T_Acc, typename Histo, typename T>
+      ALPAKA_FN_ACC void operator()(const T_Acc &acc,
+                                    Histo *__restrict__ h,
+                                    uint32_t nh,
+                                    T const *__restrict__ v,
+                                    uint32_t const *__restrict__ offsets) const {
+        const uint32_t ih(alpaka::getIdx<alpaka::Grid, alpaka::Blocks>(acc)[0u]);
+        if (ih == nh) {
+          for (uint32_t b = Histo::histOff(nh); b < Histo::totbins(); ++b) {
+            h->off[b] = offsets[nh];
+          }
+          return;
+        }
+        assert(ih < nh);
+        assert(offsets[ih] <= offsets[ih + 1]);
+
+        auto *__restrict__ off = h->off + Histo::histOff(ih);
+        for (uint32_t b = 0; b < Histo::nbins(); ++b) {
+          off[b] = 0;
+        }
+        for (uint32_t i = offsets[ih]; i < offsets[ih + 1]; ++i) {
+          ++off[Histo::bin(v[i])];
+        }
+        uint32_t sum = offsets[ih];
+        for (uint32_t b = 0; b < Histo::nbins(); ++b) {
+          sum += off[b];
+          off[b] = sum;
+        }
+        assert(sum == offsets[ih + 1]);
+        for (uint32_t i = offsets[ih]; i < offsets[ih + 1]; ++i) {
+          h->bins[--off[Histo::bin(v[i])]] = i;
+        }
       }
     };
+#endif
 
     template <typename Histo>
     ALPAKA_FN_HOST ALPAKA_FN_INLINE __attribute__((always_inline)) void launchZero(
@@ -59,7 +94,6 @@ namespace cms {
       auto histoOffView = cms::alpakatools::createDeviceView<typename Histo::Counter>(poff, Histo::totbins());
 
       alpaka::memset(queue, histoOffView, 0, Histo::totbins());
-      alpaka::wait(queue);
     }
 
     template <typename Histo>
@@ -75,16 +109,13 @@ namespace cms {
       const Vec1 blocksPerGrid(nblocks);
 
       const WorkDiv1 &workDiv = cms::alpakatools::make_workdiv(blocksPerGrid, threadsPerBlockOrElementsPerThread);
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
-                          workDiv, multiBlockPrefixScanFirstStep<uint32_t>(), poff, poff, num_items));
+      cms::alpakatools::enqueueKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+          queue, workDiv, multiBlockPrefixScanFirstStep<uint32_t>(), poff, poff, num_items);
 
       const WorkDiv1 &workDivWith1Block =
           cms::alpakatools::make_workdiv(Vec1::all(1), threadsPerBlockOrElementsPerThread);
-      alpaka::enqueue(
-          queue,
-          alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
-              workDivWith1Block, multiBlockPrefixScanSecondStep<uint32_t>(), poff, poff, num_items, nblocks));
+      cms::alpakatools::enqueueKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+          queue, workDivWith1Block, multiBlockPrefixScanSecondStep<uint32_t>(), poff, poff, num_items, nblocks);
     }
 
     template <typename Histo, typename T>
@@ -96,6 +127,12 @@ namespace cms {
         uint32_t totSize,
         unsigned int nthreads,
         ALPAKA_ACCELERATOR_NAMESPACE::Queue &queue) {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      // one block per histogram, plus one for the histograms beyond nh
+      const WorkDiv1 &workDivPerHisto = cms::alpakatools::make_workdiv(Vec1::all(nh + 1), Vec1::all(1u));
+      cms::alpakatools::enqueueKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+          queue, workDivPerHisto, fillManyFromVectorPerHisto(), h, nh, v, offsets);
+#else
       launchZero(h, queue);
 
       const unsigned int nblocks = (totSize + nthreads - 1) / nthreads;
@@ -103,14 +140,13 @@ namespace cms {
       const Vec1 threadsPerBlockOrElementsPerThread(nthreads);
       const WorkDiv1 &workDiv = cms::alpakatools::make_workdiv(blocksPerGrid, threadsPerBlockOrElementsPerThread);
 
-      alpaka::enqueue(
-          queue,
-          alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(workDiv, countFromVector(), h, nh, v, offsets));
+      cms::alpakatools::enqueueKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+          queue, workDiv, countFromVector(), h, nh, v, offsets);
       launchFinalize(h, queue);
 
-      alpaka::enqueue(
-          queue,
-          alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(workDiv, fillFromVector(), h, nh, v, offsets));
+      cms::alpakatools::enqueueKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+          queue, workDiv, fillFromVector(), h, nh, v, offsets);
+#endif
     }
 
     struct finalizeBulk {
@@ -192,21 +228,67 @@ namespace cms {
           i = 0;
       }
 
+      // On the serial backend a single thread at a time runs the kernels, and the containers are never shared
+      // across events: the counters are updated with plain increments and decrements instead of atomics.
+      template <typename T_Acc>
+      static ALPAKA_FN_ACC ALPAKA_FN_INLINE uint32_t atomicAdd(const T_Acc &acc, Counter &x, uint32_t n) {
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED
+        auto old = x;
+        x += n;
+        return old;
+#else
+        return alpaka::atomicAdd(acc, &x, n, alpaka::hierarchy::Blocks{});
+#endif
+      }
+
+      template <typename T_Acc>
+      static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE uint32_t atomicSub(const T_Acc &acc, Counter &x, uint32_t n) {
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED
+        auto old = x;
+        x -= n;
+        return old;
+#else
+        return alpaka::atomicSub(acc, &x, n, alpaka::hierarchy::Blocks{});
+#endif
+      }
+
       template <typename T_Acc>
       ALPAKA_FN_ACC ALPAKA_FN_INLINE void add(const T_Acc &acc, CountersOnly const &co) {
         for (uint32_t i = 0; i < totbins(); ++i) {
-          alpaka::atomicAdd(acc, off + i, co.off[i], alpaka::hierarchy::Blocks{});
+          atomicAdd(acc, off[i], co.off[i]);
         }
       }
 
       template <typename T_Acc>
       static ALPAKA_FN_ACC ALPAKA_FN_INLINE uint32_t atomicIncrement(const T_Acc &acc, Counter &x) {
-        return alpaka::atomicAdd(acc, &x, 1u, alpaka::hierarchy::Blocks{});
+        return atomicAdd(acc, x, 1u);
       }
 
       template <typename T_Acc>
       static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE uint32_t atomicDecrement(const T_Acc &acc, Counter &x) {
-        return alpaka::atomicSub(acc, &x, 1u, alpaka::hierarchy::Blocks{});
+        return atomicSub(acc, x, 1u);
+      }
+
+      // Partial histograms private to a single thread, e.g. to a block on the CPU backends, are counted with
+      // countDirectLocal() and merged with add(); after finalize(), reserve() takes from each bin the slots for
+      // the elements of the partial histogram in one atomic operation, and fillDirectReserved() fills them.
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void countDirectLocal(T b) {
+        assert(b < nbins());
+        ++off[b];
+      }
+
+      template <typename T_Acc>
+      ALPAKA_FN_ACC ALPAKA_FN_INLINE void reserve(const T_Acc &acc, CountersOnly &co) {
+        for (uint32_t i = 0; i < totbins(); ++i) {
+          if (co.off[i] > 0) {
+            co.off[i] = atomicSub(acc, off[i], co.off[i]);
+          }
+        }
+      }
+
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void fillDirectReserved(CountersOnly &co, T b, index_type j) {
+        assert(b < nbins());
+        bins[--co.off[b]] = j;
       }
 
       template <typename T_Acc>
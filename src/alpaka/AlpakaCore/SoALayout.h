@@ -0,0 +1,77 @@
+#ifndef AlpakaCore_SoALayout_h
+#define AlpakaCore_SoALayout_h
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace cms {
+  namespace alpakatools {
+
+    // Layout of the columns of a structure of arrays in a single buffer, of layout.bytes() bytes.
+    // Each column starts at a multiple of alignment bytes from the start of the buffer, so that the columns
+    // do not share cache lines, and the accesses of a GPU warp to a column are coalesced. The buffer itself
+    // must be aligned to alignment bytes, as the blocks of the caching allocators are.
+    // The column types must be trivially copyable, as the buffer is copied and never constructed.
+    template <typename... TColumns>
+    class SoALayout {
+    public:
+      static constexpr size_t alignment = 128;
+      static constexpr size_t numberOfColumns = sizeof...(TColumns);
+
+      template <size_t I>
+      using ColumnType = std::tuple_element_t<I, std::tuple<TColumns...>>;
+
+      constexpr SoALayout() = default;
+
+      // the same number of elements in all the columns
+      constexpr explicit SoALayout(size_t elements) : SoALayout(filled(elements)) {}
+
+      // the number of elements of each column
+      constexpr explicit SoALayout(std::array<size_t, numberOfColumns> const& elements) : elements_(elements) {
+        constexpr std::array<size_t, numberOfColumns> sizes{{sizeof(TColumns)...}};
+        for (size_t i = 0; i < numberOfColumns; ++i) {
+          offsets_[i] = bytes_;
+          bytes_ += (sizes[i] * elements_[i] + alignment - 1) / alignment * alignment;
+        }
+      }
+
+      constexpr size_t bytes() const { return bytes_; }
+      constexpr size_t elements(size_t column) const { return elements_[column]; }
+      constexpr size_t offset(size_t column) const { return offsets_[column]; }
+
+      template <size_t I>
+      ColumnType<I>* column(std::byte* buffer) const {
+        assert(reinterpret_cast<uintptr_t>(buffer) % alignment == 0);
+        return reinterpret_cast<ColumnType<I>*>(buffer + offsets_[I]);
+      }
+
+      template <size_t I>
+      ColumnType<I> const* column(std::byte const* buffer) const {
+        assert(reinterpret_cast<uintptr_t>(buffer) % alignment == 0);
+        return reinterpret_cast<ColumnType<I> const*>(buffer + offsets_[I]);
+      }
+
+    private:
+      static_assert((std::is_trivially_copyable_v<TColumns> and ...), "The columns must be trivially copyable");
+
+      static constexpr std::array<size_t, numberOfColumns> filled(size_t elements) {
+        std::array<size_t, numberOfColumns> ret{};
+        for (auto& e : ret) {
+          e = elements;
+        }
+        return ret;
+      }
+
+      std::array<size_t, numberOfColumns> elements_{};
+      std::array<size_t, numberOfColumns> offsets_{};
+      size_t bytes_ = 0;
+    };
+
+  }  // namespace alpakatools
+}  // namespace cms
+
+#endif  // AlpakaCore_SoALayout_h
@@ -0,0 +1,71 @@
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <utility>
+
+#include "AlpakaCore/allocatorStatus.h"
+
+namespace {
+  struct Registry {
+    std::mutex mutex;
+    int nextId = 0;
+    std::map<int, std::pair<std::string, std::function<cms::alpakatools::allocator::AllocatorStatistics()>>> entries;
+  };
+
+  Registry& registry() {
+    static Registry instance;
+    return instance;
+  }
+
+  void printBytes(std::ostream& out, size_t bytes) {
+    if (bytes >= (1 << 20)) {
+      out << std::setw(8) << (bytes >> 20) << " MB";
+    } else if (bytes >= (1 << 10)) {
+      out << std::setw(8) << (bytes >> 10) << " kB";
+    } else {
+      out << std::setw(8) << bytes << " B ";
+    }
+  }
+}  // namespace
+
+namespace cms::alpakatools::allocator {
+  int registerAllocator(std::string name, std::function<AllocatorStatistics()> status) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    int id = reg.nextId++;
+    reg.entries.emplace(id, std::make_pair(std::move(name), std::move(status)));
+    return id;
+  }
+
+  void unregisterAllocator(int id) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    reg.entries.erase(id);
+  }
+
+  void printAllocatorStatus(std::ostream& out) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto const& [id, entry] : reg.entries) {
+      auto const& [name, status] = entry;
+      AllocatorStatistics stats = status();
+      if (stats.requests == 0) {
+        continue;
+      }
+      out << "Caching allocator " << name << "\n"
+          << "  requests       " << std::setw(10) << stats.requests << "\n"
+          << "  cache hits     " << std::setw(10) << stats.cacheHits << "\n"
+          << "  allocations    " << std::setw(10) << stats.allocations << "\n"
+          << "  deallocations  " << std::setw(10) << stats.deallocations << "\n"
+          << "  cached        ";
+      printBytes(out, stats.bytes.free);
+      out << "\n  live          ";
+      printBytes(out, stats.bytes.live);
+      out << "\n  peak live     ";
+      printBytes(out, stats.bytes.maxLive);
+      out << "\n";
+    }
+    out.flush();
+  }
+}  // namespace cms::alpakatools::allocator
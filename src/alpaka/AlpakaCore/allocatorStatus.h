@@ -0,0 +1,40 @@
+#ifndef AlpakaCore_allocatorStatus_h
+#define AlpakaCore_allocatorStatus_h
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace cms {
+  namespace alpakatools {
+    namespace allocator {
+
+      struct TotalBytes {
+        size_t free = 0;           // bytes cached and available for reuse
+        size_t live = 0;           // bytes handed out and not yet returned
+        size_t liveRequested = 0;  // bytes actually requested by the live allocations
+        size_t maxLive = 0;        // high-water mark of the live bytes
+      };
+
+      struct AllocatorStatistics {
+        size_t requests = 0;       // number of calls to allocate()
+        size_t cacheHits = 0;      // requests satisfied by a cached block
+        size_t allocations = 0;    // requests satisfied by a new allocation
+        size_t deallocations = 0;  // blocks released back to the system
+        TotalBytes bytes;
+      };
+
+      // Register a caching allocator, so that its statistics can be reported at the end of the job.
+      // Returns an identifier to be passed to unregisterAllocator().
+      int registerAllocator(std::string name, std::function<AllocatorStatistics()> status);
+      void unregisterAllocator(int id);
+
+      // Print the statistics of all the registered caching allocators
+      void printAllocatorStatus(std::ostream& out);
+
+    }  // namespace allocator
+  }  // namespace alpakatools
+}  // namespace cms
+
+#endif  // AlpakaCore_allocatorStatus_h
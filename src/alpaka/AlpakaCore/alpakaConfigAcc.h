@@ -95,8 +95,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   template <class TData>
   using AlpakaAccBuf2 = alpaka::Buf<Acc2, TData, Dim2, Idx>;
 
+  // device memory is managed by a caching allocator, see AlpakaCore/getCachingAllocator.h
   template <typename TData>
-  using AlpakaDeviceBuf = AlpakaAccBuf1<TData>;
+  using AlpakaDeviceBuf = cms::alpakatools::CachedBuf<DevAcc1, TData, Idx>;
 
   template <typename TData>
   using AlpakaDeviceView = alpaka::ViewPlainPtr<DevAcc1, TData, Dim1, Idx>;
@@ -3,6 +3,8 @@
 
 #include <alpaka/alpaka.hpp>
 
+#include "AlpakaCore/CachedBuf.h"
+
 namespace alpaka_common {
   using Idx = uint32_t;
   using Extent = uint32_t;
@@ -23,8 +25,9 @@ namespace alpaka_common {
   using WorkDiv1 = WorkDiv<Dim1>;
   using WorkDiv2 = WorkDiv<Dim2>;
 
+  // host memory is managed by a caching allocator, see AlpakaCore/getCachingAllocator.h
   template <typename TData>
-  using AlpakaHostBuf = alpaka::Buf<DevHost, TData, Dim1, Idx>;
+  using AlpakaHostBuf = cms::alpakatools::CachedBuf<DevHost, TData, Idx>;
 
   template <typename TData>
   using AlpakaHostView = alpaka::ViewPlainPtr<DevHost, TData, Dim1, Idx>;
@@ -38,4 +41,8 @@ namespace alpaka_common {
 #define DEFINE_FWK_ALPAKA_EVENTSETUP_MODULE(name) \
   DEFINE_FWK_ALPAKA_EVENTSETUP_MODULE2(ALPAKA_ACCELERATOR_NAMESPACE::name)
 
+// name of the current backend as a string, e.g. "alpaka_serial_sync"
+#define ALPAKA_ACCELERATOR_NAME2(name) #name
+#define ALPAKA_ACCELERATOR_NAME ALPAKA_ACCELERATOR_NAME2(ALPAKA_ACCELERATOR_NAMESPACE)
+
 #endif  // alpakaConfigHost_h_
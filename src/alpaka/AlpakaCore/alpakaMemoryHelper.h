@@ -1,27 +1,86 @@
 #ifndef ALPAKAMEMORYHELPER_H
 #define ALPAKAMEMORYHELPER_H
 
+#include <memory>
+#include <type_traits>
+
 #include "AlpakaCore/alpakaConfig.h"
 #include "AlpakaCore/alpakaDevices.h"
+#include "AlpakaCore/getCachingAllocator.h"
 
 using namespace alpaka_common;
 
 namespace cms {
   namespace alpakatools {
 
-    template <typename TData>
-    auto allocHostBuf(const Extent& extent) {
-      return alpaka::allocBuf<TData, Idx>(host, extent);
+    namespace detail {
+      // Wrap a block from the caching allocator, the block is returned to the allocator
+      // when the last copy of the buffer is destroyed
+      template <typename TData, typename TDev, typename TAllocator, typename... TQueue>
+      CachedBuf<TDev, TData, Idx> allocCachedBuf(TAllocator& alloc,
+                                                 TDev const& dev,
+                                                 const Extent& extent,
+                                                 TQueue const&... queue) {
+        TData* ptr = static_cast<TData*>(alloc.allocate(extent * sizeof(TData), queue...));
+        std::shared_ptr<void> owner(ptr, [&alloc](void* p) { alloc.free(p); });
+        return CachedBuf<TDev, TData, Idx>(dev, ptr, extent, std::move(owner));
+      }
+
+    }  // namespace detail
+
+  }  // namespace alpakatools
+}  // namespace cms
+
+// The allocators, and the functions that use them, live in the namespace of the backend: the objects of all the
+// backends of a plugin are linked together, and an inline function shared by the backends keeps one body.
+namespace ALPAKA_ACCELERATOR_NAMESPACE {
+  namespace detail {
+    // on the CPU backends the host and device allocators are the same object
+    constexpr bool sharedHostDeviceAllocator = std::is_same_v<DevHost, DevAcc1>;
+
+    inline auto& hostAllocator() {
+      return cms::alpakatools::allocator::getCachingAllocator<DevHost, Queue>(
+          host, sharedHostDeviceAllocator ? ALPAKA_ACCELERATOR_NAME : ALPAKA_ACCELERATOR_NAME " host");
     }
 
-    template <typename TData>
-    auto createHostView(TData* data, const Extent& extent) {
-      return alpaka::ViewPlainPtr<DevHost, TData, Dim1, Idx>(data, host, extent);
+    inline auto& deviceAllocator() {
+      return cms::alpakatools::allocator::getCachingAllocator<DevAcc1, Queue>(
+          device, sharedHostDeviceAllocator ? ALPAKA_ACCELERATOR_NAME : ALPAKA_ACCELERATOR_NAME " device");
     }
+  }  // namespace detail
+
+  // The buffers returned by allocHostBuf and allocDeviceBuf come from the caching allocators.
+  // The overloads without a queue can reuse the memory as soon as the buffer is destroyed:
+  // the caller must make sure that any work using the buffer has completed before that.
+  // The overloads with a queue can be destroyed while work is still pending in the queue.
+
+  template <typename TData>
+  auto allocHostBuf(const Extent& extent) {
+    return cms::alpakatools::detail::allocCachedBuf<TData>(detail::hostAllocator(), host, extent);
+  }
+
+  template <typename TData>
+  auto allocHostBuf(const Extent& extent, Queue const& queue) {
+    return cms::alpakatools::detail::allocCachedBuf<TData>(detail::hostAllocator(), host, extent, queue);
+  }
+
+  template <typename TData>
+  auto allocDeviceBuf(const Extent& extent) {
+    return cms::alpakatools::detail::allocCachedBuf<TData>(detail::deviceAllocator(), device, extent);
+  }
+
+  template <typename TData>
+  auto allocDeviceBuf(const Extent& extent, Queue const& queue) {
+    return cms::alpakatools::detail::allocCachedBuf<TData>(detail::deviceAllocator(), device, extent, queue);
+  }
+}  // namespace ALPAKA_ACCELERATOR_NAMESPACE
+
+namespace cms {
+  namespace alpakatools {
 
     template <typename TData>
-    auto allocDeviceBuf(const Extent& extent) {
-      return alpaka::allocBuf<TData, Idx>(ALPAKA_ACCELERATOR_NAMESPACE::device, extent);
+    auto createHostView(TData* data, const Extent& extent) {
+      return alpaka::ViewPlainPtr<DevHost, TData, Dim1, Idx>(data, host, extent);
     }
 
     template <typename TData>
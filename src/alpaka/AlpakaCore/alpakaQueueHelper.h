@@ -0,0 +1,189 @@
+#ifndef ALPAKAQUEUEHELPER_H
+#define ALPAKAQUEUEHELPER_H
+
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include "AlpakaCore/alpakaConfig.h"
+#include "AlpakaCore/workDivTuning.h"
+#include "Framework/Timing.h"
+#include "Framework/WaitingTaskWithArenaHolder.h"
+
+namespace cms {
+  namespace alpakatools {
+
+    namespace detail {
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      // The first exception thrown by a kernel of a non-blocking CPU queue. alpaka runs all the tasks of such a queue
+      // in a worker thread of its own, that would otherwise drop the exception: it is kept by that thread until the
+      // next DoneWaitingTask of the queue passes it on.
+      template <typename TQueue>
+      inline thread_local std::exception_ptr queueError;
+
+      template <typename TQueue, typename TTask>
+      struct GuardedTask {
+        void operator()() const {
+          try {
+            task();
+          } catch (...) {
+            if (not queueError<TQueue>) {
+              queueError<TQueue> = std::current_exception();
+            }
+          }
+        }
+
+        TTask task;
+      };
+#endif
+
+      // Signal the holder when the queue reaches the task, passing it the error of the work before it, if any.
+      // alpaka may invoke the enqueued host task through a const reference.
+      // The task is a template on the queue, as its body depends on the backend being compiled.
+      template <typename TQueue>
+      struct DoneWaitingTask {
+        void operator()() const {
+          // wrap the exception in a try-catch block to let GDB "catch throw" break on it
+          try {
+            checkErrors();
+          } catch (...) {
+            holder.doneWaiting(std::current_exception());
+            return;
+          }
+          holder.doneWaiting(std::exception_ptr{});
+        }
+
+        // throw an exception if the backend reports an error for the work in the queue
+        static void checkErrors() {
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+          if (auto error = std::exchange(queueError<TQueue>, nullptr)) {
+            std::rethrow_exception(error);
+          }
+#endif
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+          // alpaka runs the host tasks of a CUDA queue in a thread of its own, where the runtime can be called;
+          // an error in a kernel is sticky, and is returned by any later call
+          cudaError_t status = cudaGetLastError();
+          if (status != cudaSuccess) {
+            throw std::runtime_error(std::string("Error in the work of a CUDA queue ") + cudaGetErrorName(status) +
+                                     ": " + cudaGetErrorString(status));
+          }
+#endif
+        }
+
+        mutable edm::WaitingTaskWithArenaHolder holder;
+      };
+
+      // measure a kernel when the queue runs it, see enqueueKernel()
+      template <typename TTask>
+      struct TimedKernelTask {
+        void operator()() const {
+          auto const begin = edm::timing::Clock::now();
+          task();
+          auto const end = edm::timing::Clock::now();
+          edm::timing::record(edm::timing::Kind::QueueWait, name, stream, enqueued, begin);
+          edm::timing::record(edm::timing::Kind::Kernel, name, stream, begin, end);
+        }
+
+        TTask task;
+        char const* name;
+        int stream;
+        edm::timing::Clock::time_point enqueued;
+      };
+
+      // measure a kernel for the calibration of its work division, see enqueueTunedKernel()
+      template <typename TTask>
+      struct CalibrationTask {
+        void operator()() const {
+          auto const begin = std::chrono::steady_clock::now();
+          task();
+          tuning::record(choice, std::chrono::steady_clock::now() - begin);
+        }
+
+        TTask task;
+        tuning::Choice choice;
+      };
+
+      // enqueue a kernel task, keeping its exception for notifyWhenDone() on a non-blocking CPU queue
+      template <typename TTask>
+      inline void enqueueTask(ALPAKA_ACCELERATOR_NAMESPACE::Queue& queue, TTask&& task) {
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        using Queue = ALPAKA_ACCELERATOR_NAMESPACE::Queue;
+        alpaka::enqueue(queue, GuardedTask<Queue, std::decay_t<TTask>>{std::forward<TTask>(task)});
+#else
+        alpaka::enqueue(queue, std::forward<TTask>(task));
+#endif
+      }
+    }  // namespace detail
+
+    // Signal the framework through the holder once all the work enqueued so far in the queue has completed,
+    // e.g. at the end of the acquire() method of an edm::EDProducerExternalWork.
+    // With a non-blocking queue the calling TBB thread returns immediately and is free to process other
+    // tasks, and the produce() method is scheduled from the worker thread of the queue. With a blocking
+    // queue all the work has already been done, and the holder is signalled immediately.
+    // An error reported by the backend for the work in the queue is passed to the holder as an exception.
+    inline void notifyWhenDone(ALPAKA_ACCELERATOR_NAMESPACE::Queue& queue, edm::WaitingTaskWithArenaHolder holder) {
+      alpaka::enqueue(queue, detail::DoneWaitingTask<ALPAKA_ACCELERATOR_NAMESPACE::Queue>{std::move(holder)});
+    }
+
+    // Enqueue a kernel, like alpaka::enqueue(queue, alpaka::createTaskKernel<TAcc>(workDiv, kernel, args...)).
+    // When the timing is enabled (see Framework/Timing.h), the kernels of the CPU backends are wrapped in a host task
+    // that measures their execution and the time they waited in the queue, for the stream of the calling module.
+    // The kernels of the GPU backends run asynchronously to the host, and are not measured.
+    template <typename TAcc, typename TWorkDiv, typename TKernel, typename... TArgs>
+    inline void enqueueKernel(ALPAKA_ACCELERATOR_NAMESPACE::Queue& queue,
+                              TWorkDiv const& workDiv,
+                              TKernel const& kernel,
+                              TArgs&&... args) {
+      auto task = alpaka::createTaskKernel<TAcc>(workDiv, kernel, std::forward<TArgs>(args)...);
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      if (edm::timing::enabled()) {
+        detail::TimedKernelTask<decltype(task)> timedTask{
+            std::move(task), typeid(TKernel).name(), edm::timing::currentStream(), edm::timing::Clock::now()};
+        detail::enqueueTask(queue, std::move(timedTask));
+        return;
+      }
+#endif
+      detail::enqueueTask(queue, std::move(task));
+    }
+
+    // Choose the number of threads per block (GPU) or of elements per thread (CPU) of a kernel that processes size
+    // elements, see AlpakaCore/workDivTuning.h. The candidate values of each kernel are listed in workDivTuning.cc.
+    // Only the kernels of the CPU backends can be calibrated.
+    // TAcc is the accelerator of the kernel, as for enqueueTunedKernel(): the objects of all the backends are linked
+    // together, and only a template on a type of the backend can depend on the backend being compiled.
+    template <typename TAcc>
+    inline tuning::Choice tuneWorkDiv(char const* kernel, uint32_t size, uint32_t defaultValue) {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      constexpr bool measurable = true;
+#else
+      constexpr bool measurable = false;
+#endif
+      return tuning::choose(ALPAKA_ACCELERATOR_NAME, kernel, size, defaultValue, measurable);
+    }
+
+    // Enqueue a kernel whose work division was made from a choice of tuneWorkDiv(), like enqueueKernel().
+    // During a calibration the kernels of the CPU backends are measured when the queue runs them.
+    template <typename TAcc, typename TWorkDiv, typename TKernel, typename... TArgs>
+    inline void enqueueTunedKernel(ALPAKA_ACCELERATOR_NAMESPACE::Queue& queue,
+                                   tuning::Choice const& choice,
+                                   TWorkDiv const& workDiv,
+                                   TKernel const& kernel,
+                                   TArgs&&... args) {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      if (tuning::calibrating()) {
+        auto task = alpaka::createTaskKernel<TAcc>(workDiv, kernel, std::forward<TArgs>(args)...);
+        detail::enqueueTask(queue, detail::CalibrationTask<decltype(task)>{std::move(task), choice});
+        return;
+      }
+#endif
+      enqueueKernel<TAcc>(queue, workDiv, kernel, std::forward<TArgs>(args)...);
+    }
+
+  }  // namespace alpakatools
+}  // namespace cms
+
+#endif  // ALPAKAQUEUEHELPER_H
@@ -292,6 +292,32 @@ namespace cms {
       cms::alpakatools::for_each_element_in_grid_strided(acc, maxNumberOfElements, elementIdxShift, func, dimIndex);
     }
 
+    /*
+     * Same as for_each_element_in_grid_strided, but calls func(firstIdx, size) on batches of up to batchSize
+     * consecutive elements of the same thread, e.g. to process them in SIMD lanes (CPU case).
+     */
+    template <Idx batchSize, typename TAcc, typename Func>
+    ALPAKA_FN_ACC void for_each_batch_in_grid_strided(const TAcc& acc,
+                                                      const Idx maxNumberOfElements,
+                                                      const Func func,
+                                                      const unsigned int dimIndex = 0) {
+      const auto& [firstElementIdxNoStride, endElementIdxNoStride] =
+          cms::alpakatools::element_index_range_in_grid(acc, Idx(0), dimIndex);
+
+      const Idx gridDimension(alpaka::getWorkDiv<alpaka::Grid, alpaka::Elems>(acc)[dimIndex]);
+
+      for (Idx threadIdx = firstElementIdxNoStride, endElementIdx = endElementIdxNoStride;
+           threadIdx < maxNumberOfElements;
+           threadIdx += gridDimension, endElementIdx += gridDimension) {
+        if (endElementIdx > maxNumberOfElements) {
+          endElementIdx = maxNumberOfElements;
+        }
+        for (Idx i = threadIdx; i < endElementIdx; i += batchSize) {
+          func(i, std::min(batchSize, endElementIdx - i));
+        }
+      }
+    }
+
     /**************************************************************
      *          LOOP ON ALL ELEMENTS WITH ONE LOOP
      **************************************************************/
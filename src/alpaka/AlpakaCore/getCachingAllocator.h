@@ -0,0 +1,52 @@
+#ifndef AlpakaCore_getCachingAllocator_h
+#define AlpakaCore_getCachingAllocator_h
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "AlpakaCore/CachingAllocator.h"
+#include "Framework/NumaDomains.h"
+
+namespace cms::alpakatools::allocator {
+  // Use caching or not
+#ifndef ALPAKA_DISABLE_CACHING_ALLOCATOR
+  constexpr bool useCaching = true;
+#else
+  constexpr bool useCaching = false;
+#endif
+  // Growth factor (bin_growth in cub::CachingDeviceAllocator)
+  constexpr unsigned int binGrowth = 2;
+  // Smallest bin, corresponds to binGrowth^minBin bytes (min_bin in cub::CachingDeviceAllocator)
+  constexpr unsigned int minBin = 8;
+  // Largest bin, corresponds to binGrowth^maxBin bytes (max_bin in cub::CachingDeviceAllocator).
+  // Larger allocations are not cached.
+  constexpr unsigned int maxBin = 30;
+  // Total storage for each allocator. 0 means no limit.
+  constexpr size_t maxCachedBytes = 0;
+  constexpr bool debug = false;
+
+  // One allocator per device type and queue type, i.e. per backend. On the CPU backends the host
+  // and the device are the same, and so are the host and device allocators.
+  // The host memory is cached separately for each NUMA domain (see Framework/NumaDomains.h), so that
+  // a block first touched by the threads of a domain is only reused by that domain.
+  template <typename TDev, typename TQueue>
+  inline CachingAllocator<TDev, TQueue>& getCachingAllocator(TDev const& device, char const* name) {
+    using Allocator = CachingAllocator<TDev, TQueue>;
+    // the public interface is thread safe
+    static std::vector<std::unique_ptr<Allocator>> allocators = [&]() {
+      int const domains = std::is_same_v<TDev, alpaka::DevCpu> ? edm::numa::numberOfDomains() : 1;
+      std::vector<std::unique_ptr<Allocator>> ret;
+      for (int i = 0; i < domains; ++i) {
+        std::string allocatorName = domains > 1 ? std::string(name) + " NUMA domain " + std::to_string(i) : name;
+        ret.push_back(std::make_unique<Allocator>(
+            device, std::move(allocatorName), binGrowth, minBin, maxBin, maxCachedBytes, useCaching, debug));
+      }
+      return ret;
+    }();
+    return *allocators[allocators.size() > 1 ? edm::numa::currentDomain() : 0];
+  }
+}  // namespace cms::alpakatools::allocator
+
+#endif  // AlpakaCore_getCachingAllocator_h
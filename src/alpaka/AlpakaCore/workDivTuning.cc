@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "AlpakaCore/workDivTuning.h"
+
+namespace cms::alpakatools::tuning::detail {
+  bool calibrating = false;
+}  // namespace cms::alpakatools::tuning::detail
+
+namespace {
+  using Duration = std::chrono::steady_clock::duration;
+
+  // the sizes are grouped by their number of bits
+  int sizeBits(uint32_t size) { return size == 0 ? 0 : 32 - __builtin_clz(size); }
+
+  struct Candidate {
+    uint32_t value;
+    size_t calls = 0;
+    Duration total{};
+
+    double meanMicroseconds() const {
+      return std::chrono::duration<double, std::micro>(total).count() / std::max<size_t>(calls, 1);
+    }
+  };
+
+  struct Calibration {
+    size_t next = 0;
+    std::vector<Candidate> candidates;
+  };
+
+  // backend, kernel
+  using Kernel = std::pair<std::string, std::string>;
+  // backend, kernel, number of bits of the size
+  using Key = std::tuple<std::string, std::string, int>;
+
+  struct Registry {
+    std::mutex mutex;
+    // filled by load(), and only read during the processing
+    std::map<Kernel, std::map<int, uint32_t>> values;
+    std::map<Key, Calibration> calibrations;
+  };
+
+  Registry& registry() {
+    static Registry instance;
+    return instance;
+  }
+
+  // The values that each tuned kernel can take on each backend, the only ones accepted in a tuning file.
+  // findClus covers a module of up to 4000 pixels in at most 16 passes of the block (maxiter in gpuClustering.h),
+  // so it needs 256 threads per block or more, except on the serial and TBB backends, where it is a union-find.
+  std::map<Kernel, std::vector<uint32_t>> makeCandidates() {
+    std::vector<std::string> const serialAndTbb = {"alpaka_serial_sync", "alpaka_tbb_async"};
+    std::vector<std::string> const openMP = {"alpaka_omp2_async", "alpaka_omp4_async"};
+    std::string const cuda = "alpaka_cuda_async";
+
+    std::map<Kernel, std::vector<uint32_t>> candidates;
+    candidates[Kernel(cuda, "RawToDigi")] = {128, 256, 512, 1024};
+    candidates[Kernel(cuda, "findClus")] = {256, 512};
+    candidates[Kernel(cuda, "kernel_connect")] = {64, 128, 256, 512};
+    for (auto const& backend : serialAndTbb) {
+      candidates[Kernel(backend, "RawToDigi")] = {8, 16, 32, 64, 128, 256};
+      candidates[Kernel(backend, "findClus")] = {32, 64, 128, 256, 512};
+      candidates[Kernel(backend, "kernel_connect")] = {64, 128, 256, 512};
+    }
+    for (auto const& backend : openMP) {
+      candidates[Kernel(backend, "RawToDigi")] = {8, 16, 32, 64, 128, 256};
+      candidates[Kernel(backend, "findClus")] = {256, 512};
+      candidates[Kernel(backend, "kernel_connect")] = {64, 128, 256, 512};
+    }
+    return candidates;
+  }
+
+  std::vector<uint32_t> const* findCandidates(std::string const& backend, std::string const& kernel) {
+    static const auto candidates = makeCandidates();
+    auto found = candidates.find(Kernel(backend, kernel));
+    return found == candidates.end() ? nullptr : &found->second;
+  }
+}  // namespace
+
+namespace cms::alpakatools::tuning {
+  void load(std::string const& fileName) {
+    std::ifstream in(fileName);
+    if (not in) {
+      throw std::runtime_error("Can not read the work division tuning file " + fileName);
+    }
+    auto& reg = registry();
+    int lineNumber = 0;
+    for (std::string line; std::getline(in, line);) {
+      ++lineNumber;
+      if (line.empty() or line[0] == '#') {
+        continue;
+      }
+      std::istringstream fields(line);
+      std::string backend, kernel;
+      int bits;
+      uint32_t value;
+      if (not(fields >> backend >> kernel >> bits >> value)) {
+        throw std::runtime_error("Invalid line " + std::to_string(lineNumber) + " in the work division tuning file " +
+                                 fileName + ": " + line);
+      }
+      auto const* candidates = findCandidates(backend, kernel);
+      if (candidates == nullptr or std::find(candidates->begin(), candidates->end(), value) == candidates->end()) {
+        throw std::runtime_error("Invalid line " + std::to_string(lineNumber) + " in the work division tuning file " +
+                                 fileName + ": " + line + " (not a candidate value of " + kernel + " on " + backend +
+                                 ")");
+      }
+      reg.values[Kernel(backend, kernel)][bits] = value;
+    }
+  }
+
+  void calibrate() { detail::calibrating = true; }
+
+  void save(std::string const& fileName) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    auto values = reg.values;
+    std::map<Key, std::string> comments;
+    for (auto const& [key, calibration] : reg.calibrations) {
+      Candidate const* best = nullptr;
+      std::ostringstream comment;
+      comment << std::fixed << std::setprecision(1);
+      for (auto const& candidate : calibration.candidates) {
+        if (candidate.calls == 0) {
+          continue;
+        }
+        comment << " " << candidate.value << ": " << candidate.meanMicroseconds() << " us (" << candidate.calls
+                << " calls)";
+        if (best == nullptr or candidate.meanMicroseconds() < best->meanMicroseconds()) {
+          best = &candidate;
+        }
+      }
+      if (best != nullptr) {
+        values[Kernel(std::get<0>(key), std::get<1>(key))][std::get<2>(key)] = best->value;
+        comments[key] = comment.str();
+      }
+    }
+
+    std::ofstream out(fileName);
+    out << "# backend kernel size_bits value\n";
+    for (auto const& [kernel, sizes] : values) {
+      for (auto const& [bits, value] : sizes) {
+        auto comment = comments.find(Key(kernel.first, kernel.second, bits));
+        if (comment != comments.end()) {
+          out << "# mean time per candidate:" << comment->second << "\n";
+        }
+        out << kernel.first << " " << kernel.second << " " << bits << " " << value << "\n";
+      }
+    }
+  }
+
+  Choice choose(char const* backend,
+                char const* kernel,
+                uint32_t size,
+                uint32_t defaultValue,
+                bool measurable) {
+    Choice choice{backend, kernel, size, defaultValue};
+    auto const* candidates = findCandidates(backend, kernel);
+    if (candidates == nullptr) {
+      throw std::logic_error(std::string("The kernel ") + kernel + " has no work division candidates on " + backend);
+    }
+    auto& reg = registry();
+    if (detail::calibrating and measurable) {
+      std::scoped_lock lock(reg.mutex);
+      auto& calibration = reg.calibrations[Key(backend, kernel, sizeBits(size))];
+      if (calibration.candidates.empty()) {
+        for (auto value : *candidates) {
+          calibration.candidates.push_back(Candidate{value});
+        }
+      }
+      choice.value = calibration.candidates[calibration.next++ % calibration.candidates.size()].value;
+    } else if (not reg.values.empty()) {
+      auto found = reg.values.find(Kernel(backend, kernel));
+      if (found != reg.values.end()) {
+        // the closest size that was calibrated
+        auto const& sizes = found->second;
+        int const bits = sizeBits(size);
+        auto closest = sizes.lower_bound(bits);
+        if (closest == sizes.end() or
+            (closest != sizes.begin() and bits - std::prev(closest)->first < closest->first - bits)) {
+          --closest;
+        }
+        choice.value = closest->second;
+      }
+    }
+    return choice;
+  }
+
+  void record(Choice const& choice, Duration duration) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    auto& calibration = reg.calibrations[Key(choice.backend, choice.kernel, sizeBits(choice.size))];
+    for (auto& candidate : calibration.candidates) {
+      if (candidate.value == choice.value) {
+        ++candidate.calls;
+        candidate.total += duration;
+        return;
+      }
+    }
+  }
+}  // namespace cms::alpakatools::tuning
@@ -0,0 +1,52 @@
+#ifndef AlpakaCore_workDivTuning_h
+#define AlpakaCore_workDivTuning_h
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace cms {
+  namespace alpakatools {
+    namespace tuning {
+
+      // The tuned parameter of a work division is the number of threads per block on the GPU, or the number of
+      // elements per thread on the CPU (see make_workdiv()). The best value may depend on the size of the problem,
+      // so it is chosen separately for each kernel, backend and power of two of the number of elements.
+      struct Choice {
+        char const* backend;
+        char const* kernel;
+        uint32_t size;
+        uint32_t value;
+      };
+
+      namespace detail {
+        // set once, before the processing starts
+        extern bool calibrating;
+      }  // namespace detail
+
+      inline bool calibrating() { return detail::calibrating; }
+
+      // Read the values chosen by an earlier calibration, before the processing starts.
+      // Throws if a value is not one of the candidates of its kernel and backend (see workDivTuning.cc).
+      void load(std::string const& fileName);
+
+      // Make the next job a calibration: each tuned kernel cycles through its candidate values, and the
+      // kernels that run on the host (see enqueueTunedKernel()) are measured.
+      void calibrate();
+
+      // Write the loaded values, updated with the fastest candidate measured by the calibration.
+      // Not thread safe, to be called after the processing has finished.
+      void save(std::string const& fileName);
+
+      // Value for the kernel on the backend: during a calibration the next candidate if measurable is true,
+      // otherwise the value read with load() for the closest size, or defaultValue
+      Choice choose(char const* backend, char const* kernel, uint32_t size, uint32_t defaultValue, bool measurable);
+
+      // Record the execution time of a kernel run with the given choice
+      void record(Choice const& choice, std::chrono::steady_clock::duration duration);
+
+    }  // namespace tuning
+  }  // namespace alpakatools
+}  // namespace cms
+
+#endif  // AlpakaCore_workDivTuning_h
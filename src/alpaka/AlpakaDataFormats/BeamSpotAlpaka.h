@@ -12,11 +12,11 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   public:
     BeamSpotAlpaka() = default;
 
-    BeamSpotAlpaka(BeamSpotPOD const* data, Queue& queue) : data_d{cms::alpakatools::allocDeviceBuf<BeamSpotPOD>(1u)} {
+    // The copy is asynchronous: data must stay valid until the work in the queue has completed
+    BeamSpotAlpaka(BeamSpotPOD const* data, Queue& queue) : data_d{allocDeviceBuf<BeamSpotPOD>(1u)} {
       auto data_h{cms::alpakatools::createHostView<const BeamSpotPOD>(data, 1u)};
 
       alpaka::memcpy(queue, data_d, data_h, 1u);
-      alpaka::wait(queue);
     }
 
     const BeamSpotPOD* data() const { return alpaka::getPtrNative(data_d); }
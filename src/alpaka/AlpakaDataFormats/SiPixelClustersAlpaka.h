@@ -1,6 +1,7 @@
 #ifndef CUDADataFormats_SiPixelCluster_interface_SiPixelClustersCUDA_h
 #define CUDADataFormats_SiPixelCluster_interface_SiPixelClustersCUDA_h
 
+#include "AlpakaCore/SoALayout.h"
 #include "AlpakaCore/alpakaCommon.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -8,11 +9,10 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   class SiPixelClustersAlpaka {
   public:
     SiPixelClustersAlpaka() = default;
+    // all the columns are allocated together
     explicit SiPixelClustersAlpaka(size_t maxClusters)
-        : moduleStart_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxClusters + 1)},
-          clusInModule_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxClusters)},
-          moduleId_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxClusters)},
-          clusModuleStart_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxClusters + 1)} {}
+        : layout_({maxClusters + 1, maxClusters, maxClusters, maxClusters + 1}),
+          buffer_d{allocDeviceBuf<std::byte>(layout_.bytes())} {}
     ~SiPixelClustersAlpaka() = default;
 
     SiPixelClustersAlpaka(const SiPixelClustersAlpaka &) = delete;
@@ -24,20 +24,20 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     uint32_t nClusters() const { return nClusters_h; }
 
-    uint32_t *moduleStart() { return alpaka::getPtrNative(moduleStart_d); }
-    uint32_t *clusInModule() { return alpaka::getPtrNative(clusInModule_d); }
-    uint32_t *moduleId() { return alpaka::getPtrNative(moduleId_d); }
-    uint32_t *clusModuleStart() { return alpaka::getPtrNative(clusModuleStart_d); }
+    uint32_t *moduleStart() { return layout_.column<kModuleStart>(buffer()); }
+    uint32_t *clusInModule() { return layout_.column<kClusInModule>(buffer()); }
+    uint32_t *moduleId() { return layout_.column<kModuleId>(buffer()); }
+    uint32_t *clusModuleStart() { return layout_.column<kClusModuleStart>(buffer()); }
 
-    uint32_t const *moduleStart() const { return alpaka::getPtrNative(moduleStart_d); }
-    uint32_t const *clusInModule() const { return alpaka::getPtrNative(clusInModule_d); }
-    uint32_t const *moduleId() const { return alpaka::getPtrNative(moduleId_d); }
-    uint32_t const *clusModuleStart() const { return alpaka::getPtrNative(clusModuleStart_d); }
+    uint32_t const *moduleStart() const { return layout_.column<kModuleStart>(buffer()); }
+    uint32_t const *clusInModule() const { return layout_.column<kClusInModule>(buffer()); }
+    uint32_t const *moduleId() const { return layout_.column<kModuleId>(buffer()); }
+    uint32_t const *clusModuleStart() const { return layout_.column<kClusModuleStart>(buffer()); }
 
-    uint32_t const *c_moduleStart() const { return alpaka::getPtrNative(moduleStart_d); }
-    uint32_t const *c_clusInModule() const { return alpaka::getPtrNative(clusInModule_d); }
-    uint32_t const *c_moduleId() const { return alpaka::getPtrNative(moduleId_d); }
-    uint32_t const *c_clusModuleStart() const { return alpaka::getPtrNative(clusModuleStart_d); }
+    uint32_t const *c_moduleStart() const { return layout_.column<kModuleStart>(buffer()); }
+    uint32_t const *c_clusInModule() const { return layout_.column<kClusInModule>(buffer()); }
+    uint32_t const *c_moduleId() const { return layout_.column<kModuleId>(buffer()); }
+    uint32_t const *c_clusModuleStart() const { return layout_.column<kClusModuleStart>(buffer()); }
 
     class DeviceConstView {
     public:
@@ -61,12 +61,21 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     }
 
   private:
-    AlpakaDeviceBuf<uint32_t> moduleStart_d;   // index of the first pixel of each module
-    AlpakaDeviceBuf<uint32_t> clusInModule_d;  // number of clusters found in each module
-    AlpakaDeviceBuf<uint32_t> moduleId_d;      // module id of each module
+    enum Column {
+      kModuleStart,   // index of the first pixel of each module
+      kClusInModule,  // number of clusters found in each module
+      kModuleId,      // module id of each module
 
-    // originally from rechits
-    AlpakaDeviceBuf<uint32_t> clusModuleStart_d;  // index of the first cluster of each module
+      // originally from rechits
+      kClusModuleStart  // index of the first cluster of each module
+    };
+    using Layout = cms::alpakatools::SoALayout<uint32_t, uint32_t, uint32_t, uint32_t>;
+
+    std::byte *buffer() { return alpaka::getPtrNative(buffer_d); }
+    std::byte const *buffer() const { return alpaka::getPtrNative(buffer_d); }
+
+    Layout layout_;
+    AlpakaDeviceBuf<std::byte> buffer_d;
 
     uint32_t nClusters_h = 0;
   };
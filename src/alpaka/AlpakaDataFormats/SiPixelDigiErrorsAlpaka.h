@@ -12,9 +12,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   public:
     SiPixelDigiErrorsAlpaka() = default;
     explicit SiPixelDigiErrorsAlpaka(size_t maxFedWords, PixelFormatterErrors errors)
-        : data_d{cms::alpakatools::allocDeviceBuf<PixelErrorCompact>(maxFedWords)},
-          error_d{cms::alpakatools::allocDeviceBuf<cms::alpakatools::SimpleVector<PixelErrorCompact>>(1u)},
-          error_h{cms::alpakatools::allocHostBuf<cms::alpakatools::SimpleVector<PixelErrorCompact>>(1u)},
+        : data_d{allocDeviceBuf<PixelErrorCompact>(maxFedWords)},
+          error_d{allocDeviceBuf<cms::alpakatools::SimpleVector<PixelErrorCompact>>(1u)},
+          error_h{allocHostBuf<cms::alpakatools::SimpleVector<PixelErrorCompact>>(1u)},
           formatterErrors_h{std::move(errors)} {
       auto perror_h = alpaka::getPtrNative(error_h);
       perror_h->construct(maxFedWords, alpaka::getPtrNative(data_d));
@@ -1,6 +1,7 @@
 #ifndef CUDADataFormats_SiPixelDigi_interface_SiPixelDigisCUDA_h
 #define CUDADataFormats_SiPixelDigi_interface_SiPixelDigisCUDA_h
 
+#include "AlpakaCore/SoALayout.h"
 #include "AlpakaCore/alpakaCommon.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -8,14 +9,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   class SiPixelDigisAlpaka {
   public:
     SiPixelDigisAlpaka() = default;
+    // all the columns are allocated together, for maxFedWords digis
     explicit SiPixelDigisAlpaka(size_t maxFedWords)
-        : xx_d{cms::alpakatools::allocDeviceBuf<uint16_t>(maxFedWords)},
-          yy_d{cms::alpakatools::allocDeviceBuf<uint16_t>(maxFedWords)},
-          adc_d{cms::alpakatools::allocDeviceBuf<uint16_t>(maxFedWords)},
-          moduleInd_d{cms::alpakatools::allocDeviceBuf<uint16_t>(maxFedWords)},
-          clus_d{cms::alpakatools::allocDeviceBuf<int32_t>(maxFedWords)},
-          pdigi_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxFedWords)},
-          rawIdArr_d{cms::alpakatools::allocDeviceBuf<uint32_t>(maxFedWords)} {}
+        : layout_(maxFedWords), buffer_d{allocDeviceBuf<std::byte>(layout_.bytes())} {}
     ~SiPixelDigisAlpaka() = default;
 
     SiPixelDigisAlpaka(const SiPixelDigisAlpaka &) = delete;
@@ -31,34 +27,34 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     uint32_t nModules() const { return nModules_h; }
     uint32_t nDigis() const { return nDigis_h; }
 
-    uint16_t *xx() { return alpaka::getPtrNative(xx_d); }
-    uint16_t *yy() { return alpaka::getPtrNative(yy_d); }
-    uint16_t *adc() { return alpaka::getPtrNative(adc_d); }
-    uint16_t *moduleInd() { return alpaka::getPtrNative(moduleInd_d); }
-    int32_t *clus() { return alpaka::getPtrNative(clus_d); }
-    uint32_t *pdigi() { return alpaka::getPtrNative(pdigi_d); }
-    uint32_t *rawIdArr() { return alpaka::getPtrNative(rawIdArr_d); }
-
-    uint16_t const *xx() const { return alpaka::getPtrNative(xx_d); }
-    uint16_t const *yy() const { return alpaka::getPtrNative(yy_d); }
-    uint16_t const *adc() const { return alpaka::getPtrNative(adc_d); }
-    uint16_t const *moduleInd() const { return alpaka::getPtrNative(moduleInd_d); }
-    int32_t const *clus() const { return alpaka::getPtrNative(clus_d); }
-    uint32_t const *pdigi() const { return alpaka::getPtrNative(pdigi_d); }
-    uint32_t const *rawIdArr() const { return alpaka::getPtrNative(rawIdArr_d); }
-
-    uint16_t const *c_xx() const { return alpaka::getPtrNative(xx_d); }
-    uint16_t const *c_yy() const { return alpaka::getPtrNative(yy_d); }
-    uint16_t const *c_adc() const { return alpaka::getPtrNative(adc_d); }
-    uint16_t const *c_moduleInd() const { return alpaka::getPtrNative(moduleInd_d); }
-    int32_t const *c_clus() const { return alpaka::getPtrNative(clus_d); }
-    uint32_t const *c_pdigi() const { return alpaka::getPtrNative(pdigi_d); }
-    uint32_t const *c_rawIdArr() const { return alpaka::getPtrNative(rawIdArr_d); }
+    uint16_t *xx() { return layout_.column<kXX>(buffer()); }
+    uint16_t *yy() { return layout_.column<kYY>(buffer()); }
+    uint16_t *adc() { return layout_.column<kADC>(buffer()); }
+    uint16_t *moduleInd() { return layout_.column<kModuleInd>(buffer()); }
+    int32_t *clus() { return layout_.column<kClus>(buffer()); }
+    uint32_t *pdigi() { return layout_.column<kPDigi>(buffer()); }
+    uint32_t *rawIdArr() { return layout_.column<kRawIdArr>(buffer()); }
+
+    uint16_t const *xx() const { return layout_.column<kXX>(buffer()); }
+    uint16_t const *yy() const { return layout_.column<kYY>(buffer()); }
+    uint16_t const *adc() const { return layout_.column<kADC>(buffer()); }
+    uint16_t const *moduleInd() const { return layout_.column<kModuleInd>(buffer()); }
+    int32_t const *clus() const { return layout_.column<kClus>(buffer()); }
+    uint32_t const *pdigi() const { return layout_.column<kPDigi>(buffer()); }
+    uint32_t const *rawIdArr() const { return layout_.column<kRawIdArr>(buffer()); }
+
+    uint16_t const *c_xx() const { return layout_.column<kXX>(buffer()); }
+    uint16_t const *c_yy() const { return layout_.column<kYY>(buffer()); }
+    uint16_t const *c_adc() const { return layout_.column<kADC>(buffer()); }
+    uint16_t const *c_moduleInd() const { return layout_.column<kModuleInd>(buffer()); }
+    int32_t const *c_clus() const { return layout_.column<kClus>(buffer()); }
+    uint32_t const *c_pdigi() const { return layout_.column<kPDigi>(buffer()); }
+    uint32_t const *c_rawIdArr() const { return layout_.column<kRawIdArr>(buffer()); }
 
     // TO DO: nothing async in here for now... Pass the queue as argument instead, and don't wait anymore!
     auto adcToHostAsync(Queue &queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<uint16_t>(nDigis());
-      alpaka::memcpy(queue, ret, adc_d, nDigis());
+      auto ret = allocHostBuf<uint16_t>(nDigis());
+      alpaka::memcpy(queue, ret, cms::alpakatools::createDeviceView<uint16_t>(c_adc(), nDigis()), nDigis());
       return ret;
     }
 
@@ -90,17 +86,26 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     const DeviceConstView view() const { return DeviceConstView{c_xx(), c_yy(), c_adc(), c_moduleInd(), c_clus()}; }
 
   private:
-    // These are consumed by downstream device code
-    AlpakaDeviceBuf<uint16_t> xx_d;         // local coordinates of each pixel
-    AlpakaDeviceBuf<uint16_t> yy_d;         //
-    AlpakaDeviceBuf<uint16_t> adc_d;        // ADC of each pixel
-    AlpakaDeviceBuf<uint16_t> moduleInd_d;  // module id of each pixel
-    AlpakaDeviceBuf<int32_t> clus_d;        // cluster id of each pixel
-
-    // These are for CPU output; should we (eventually) place them to a
-    // separate product?
-    AlpakaDeviceBuf<uint32_t> pdigi_d;
-    AlpakaDeviceBuf<uint32_t> rawIdArr_d;
+    enum Column {
+      // These are consumed by downstream device code
+      kXX,         // local coordinates of each pixel
+      kYY,         //
+      kADC,        // ADC of each pixel
+      kModuleInd,  // module id of each pixel
+      kClus,       // cluster id of each pixel
+
+      // These are for CPU output; should we (eventually) place them to a
+      // separate product?
+      kPDigi,
+      kRawIdArr
+    };
+    using Layout = cms::alpakatools::SoALayout<uint16_t, uint16_t, uint16_t, uint16_t, int32_t, uint32_t, uint32_t>;
+
+    std::byte *buffer() { return alpaka::getPtrNative(buffer_d); }
+    std::byte const *buffer() const { return alpaka::getPtrNative(buffer_d); }
+
+    Layout layout_;
+    AlpakaDeviceBuf<std::byte> buffer_d;
 
     uint32_t nModules_h = 0;
     uint32_t nDigis_h = 0;
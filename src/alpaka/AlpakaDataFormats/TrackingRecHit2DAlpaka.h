@@ -2,6 +2,7 @@
 #define CUDADataFormats_TrackingRecHit_interface_TrackingRecHit2DHeterogeneous_h
 
 #include "AlpakaDataFormats/TrackingRecHit2DSOAView.h"
+#include "AlpakaCore/SoALayout.h"
 #include "AlpakaCore/alpakaCommon.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -18,25 +19,10 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         : m_nHits(nHits),
           // NON-OWNING DEVICE POINTERS:
           m_hitsModuleStart(hitsModuleStart),
-          // OWNING DEVICE POINTERS:
-          m_xl{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_yl{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_xerr{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_yerr{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_xg{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_yg{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_zg{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_rg{cms::alpakatools::allocDeviceBuf<float>(nHits)},
-          m_iphi{cms::alpakatools::allocDeviceBuf<int16_t>(nHits)},
-          m_charge{cms::alpakatools::allocDeviceBuf<int32_t>(nHits)},
-          m_xsize{cms::alpakatools::allocDeviceBuf<int16_t>(nHits)},
-          m_ysize{cms::alpakatools::allocDeviceBuf<int16_t>(nHits)},
-          m_detInd{cms::alpakatools::allocDeviceBuf<uint16_t>(nHits)},
-          m_averageGeometry{cms::alpakatools::allocDeviceBuf<TrackingRecHit2DSOAView::AverageGeometry>(1u)},
-          m_hitsLayerStart{cms::alpakatools::allocDeviceBuf<uint32_t>(nHits)},
-          m_hist{cms::alpakatools::allocDeviceBuf<Hist>(1u)},
-          // SOA view:
-          m_view{cms::alpakatools::allocDeviceBuf<TrackingRecHit2DSOAView>(1u)} {
+          // OWNING DEVICE BUFFER, holding all the columns and the SOA view:
+          m_layout({nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits, nHits,
+                    1, nHits, 1, 1}),
+          m_buffer{allocDeviceBuf<std::byte>(m_layout.bytes())} {
       // the hits are actually accessed in order only in building
       // if ordering is relevant they may have to be stored phi-ordered by layer or so
       // this will break 1to1 correspondence with cluster and module locality
@@ -52,29 +38,30 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       view.m_cpeParams = cpeParams;
 
       // Raw pointers to data owned here in TrackingRecHit2DAlpaka object:
-#define SET(name) view.name = alpaka::getPtrNative(name)
-      SET(m_xl);
-      SET(m_yl);
-      SET(m_xerr);
-      SET(m_yerr);
-      SET(m_xg);
-      SET(m_yg);
-      SET(m_zg);
-      SET(m_rg);
-      SET(m_iphi);
-      SET(m_charge);
-      SET(m_xsize);
-      SET(m_ysize);
-      SET(m_detInd);
-      SET(m_averageGeometry);
-      SET(m_hitsLayerStart);
-      SET(m_hist);
+#define SET(name, index) view.name = column<index>()
+      SET(m_xl, kXL);
+      SET(m_yl, kYL);
+      SET(m_xerr, kXErr);
+      SET(m_yerr, kYErr);
+      SET(m_xg, kXG);
+      SET(m_yg, kYG);
+      SET(m_zg, kZG);
+      SET(m_rg, kRG);
+      SET(m_iphi, kIPhi);
+      SET(m_charge, kCharge);
+      SET(m_xsize, kXSize);
+      SET(m_ysize, kYSize);
+      SET(m_detInd, kDetInd);
+      SET(m_averageGeometry, kAverageGeometry);
+      SET(m_hitsLayerStart, kHitsLayerStart);
+      SET(m_hist, kHist);
 #undef SET
 
       // SoA view on device:
       Queue queue(device);
       auto view_h{cms::alpakatools::createHostView<TrackingRecHit2DSOAView>(&view, 1u)};
-      alpaka::memcpy(queue, m_view, view_h, 1u);
+      auto view_d{cms::alpakatools::createDeviceView<TrackingRecHit2DSOAView>(column<kView>(), 1u)};
+      alpaka::memcpy(queue, view_d, view_h, 1u);
       alpaka::wait(queue);
     }
 
@@ -85,71 +72,71 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     TrackingRecHit2DAlpaka(TrackingRecHit2DAlpaka&&) = default;
     TrackingRecHit2DAlpaka& operator=(TrackingRecHit2DAlpaka&&) = default;
 
-    TrackingRecHit2DSOAView* view() { return alpaka::getPtrNative(m_view); }
-    TrackingRecHit2DSOAView const* view() const { return alpaka::getPtrNative(m_view); }
+    TrackingRecHit2DSOAView* view() { return column<kView>(); }
+    TrackingRecHit2DSOAView const* view() const { return column<kView>(); }
 
     auto nHits() const { return m_nHits; }
     auto hitsModuleStart() const { return m_hitsModuleStart; }
 
-    auto hitsLayerStart() { return alpaka::getPtrNative(m_hitsLayerStart); }
-    auto const* c_hitsLayerStart() const { return alpaka::getPtrNative(m_hitsLayerStart); }
-    auto phiBinner() { return alpaka::getPtrNative(m_hist); }
-    auto iphi() { return alpaka::getPtrNative(m_iphi); }
-    auto const* c_iphi() const { return alpaka::getPtrNative(m_iphi); }
+    auto hitsLayerStart() { return column<kHitsLayerStart>(); }
+    auto const* c_hitsLayerStart() const { return column<kHitsLayerStart>(); }
+    auto phiBinner() { return column<kHist>(); }
+    auto iphi() { return column<kIPhi>(); }
+    auto const* c_iphi() const { return column<kIPhi>(); }
 
     auto xlToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_xl, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kXL>(nHits()), nHits());
       return ret;
     }
     auto ylToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_yl, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kYL>(nHits()), nHits());
       return ret;
     }
     auto xerrToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_xerr, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kXErr>(nHits()), nHits());
       return ret;
     }
     auto yerrToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_yerr, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kYErr>(nHits()), nHits());
       return ret;
     }
     auto xgToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_xg, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kXG>(nHits()), nHits());
       return ret;
     }
     auto ygToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_yg, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kYG>(nHits()), nHits());
       return ret;
     }
     auto zgToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_zg, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kZG>(nHits()), nHits());
       return ret;
     }
     auto rgToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<float>(nHits());
-      alpaka::memcpy(queue, ret, m_rg, nHits());
+      auto ret = allocHostBuf<float>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kRG>(nHits()), nHits());
       return ret;
     }
     auto chargeToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<int32_t>(nHits());
-      alpaka::memcpy(queue, ret, m_charge, nHits());
+      auto ret = allocHostBuf<int32_t>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kCharge>(nHits()), nHits());
       return ret;
     }
     auto xsizeToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<int16_t>(nHits());
-      alpaka::memcpy(queue, ret, m_xsize, nHits());
+      auto ret = allocHostBuf<int16_t>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kXSize>(nHits()), nHits());
       return ret;
     }
     auto ysizeToHostAsync(Queue& queue) const {
-      auto ret = cms::alpakatools::allocHostBuf<int16_t>(nHits());
-      alpaka::memcpy(queue, ret, m_ysize, nHits());
+      auto ret = allocHostBuf<int16_t>(nHits());
+      alpaka::memcpy(queue, ret, columnView<kYSize>(nHits()), nHits());
       return ret;
     }
 #ifdef TODO
@@ -157,17 +144,17 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     cms::cuda::host::unique_ptr<uint16_t[]> detIndexToHostAsync(cudaStream_t stream) const;
     cms::cuda::host::unique_ptr<uint32_t[]> hitsModuleStartToHostAsync(cudaStream_t stream) const;
 #endif
-    auto const* xl() const { return alpaka::getPtrNative(m_xl); }
-    auto const* yl() const { return alpaka::getPtrNative(m_yl); }
-    auto const* xerr() const { return alpaka::getPtrNative(m_xerr); }
-    auto const* yerr() const { return alpaka::getPtrNative(m_yerr); }
-    auto const* xg() const { return alpaka::getPtrNative(m_xg); }
-    auto const* yg() const { return alpaka::getPtrNative(m_yg); }
-    auto const* zg() const { return alpaka::getPtrNative(m_zg); }
-    auto const* rg() const { return alpaka::getPtrNative(m_rg); }
-    auto const* charge() const { return alpaka::getPtrNative(m_charge); }
-    auto const* xsize() const { return alpaka::getPtrNative(m_xsize); }
-    auto const* ysize() const { return alpaka::getPtrNative(m_ysize); }
+    auto const* xl() const { return column<kXL>(); }
+    auto const* yl() const { return column<kYL>(); }
+    auto const* xerr() const { return column<kXErr>(); }
+    auto const* yerr() const { return column<kYErr>(); }
+    auto const* xg() const { return column<kXG>(); }
+    auto const* yg() const { return column<kYG>(); }
+    auto const* zg() const { return column<kZG>(); }
+    auto const* rg() const { return column<kRG>(); }
+    auto const* charge() const { return column<kCharge>(); }
+    auto const* xsize() const { return column<kXSize>(); }
+    auto const* ysize() const { return column<kYSize>(); }
 
   private:
     uint32_t m_nHits;
@@ -176,36 +163,71 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     // m_hitsModuleStart data is already owned by SiPixelClusterAlpaka, let's not abuse of shared_ptr!!
     uint32_t const* m_hitsModuleStart;  // needed for legacy, this is on GPU!
 
-    // OWNING DEVICE POINTERS
-    // local coord
-    AlpakaDeviceBuf<float> m_xl;
-    AlpakaDeviceBuf<float> m_yl;
-    AlpakaDeviceBuf<float> m_xerr;
-    AlpakaDeviceBuf<float> m_yerr;
-
-    // global coord
-    AlpakaDeviceBuf<float> m_xg;
-    AlpakaDeviceBuf<float> m_yg;
-    AlpakaDeviceBuf<float> m_zg;
-    AlpakaDeviceBuf<float> m_rg;
-    AlpakaDeviceBuf<int16_t> m_iphi;
-
-    // cluster properties
-    AlpakaDeviceBuf<int32_t> m_charge;
-    AlpakaDeviceBuf<int16_t> m_xsize;
-    AlpakaDeviceBuf<int16_t> m_ysize;
-    AlpakaDeviceBuf<uint16_t> m_detInd;
-
-    AlpakaDeviceBuf<TrackingRecHit2DSOAView::AverageGeometry> m_averageGeometry;
-
-    // needed as kernel params...
-    AlpakaDeviceBuf<uint32_t> m_hitsLayerStart;
-    AlpakaDeviceBuf<Hist> m_hist;
-
-    // This is a SoA view which itself gathers non-owning pointers to the data owned above (in TrackingRecHit2DAlpaka instance).
-    // This is used to access and modify data on GPU in a SoA format (TrackingRecHit2DSOAView),
-    // while the data itself is owned here in the TrackingRecHit2DAlpaka instance.
-    AlpakaDeviceBuf<TrackingRecHit2DSOAView> m_view;
+    enum Column {
+      // local coord
+      kXL,
+      kYL,
+      kXErr,
+      kYErr,
+
+      // global coord
+      kXG,
+      kYG,
+      kZG,
+      kRG,
+      kIPhi,
+
+      // cluster properties
+      kCharge,
+      kXSize,
+      kYSize,
+      kDetInd,
+
+      kAverageGeometry,
+
+      // needed as kernel params...
+      kHitsLayerStart,
+      kHist,
+
+      // This is a SoA view which itself gathers non-owning pointers to the columns above.
+      // This is used to access and modify data on GPU in a SoA format (TrackingRecHit2DSOAView),
+      // while the data itself is owned here in the TrackingRecHit2DAlpaka instance.
+      kView
+    };
+    using Layout = cms::alpakatools::SoALayout<float,
+                                               float,
+                                               float,
+                                               float,
+                                               float,
+                                               float,
+                                               float,
+                                               float,
+                                               int16_t,
+                                               int32_t,
+                                               int16_t,
+                                               int16_t,
+                                               uint16_t,
+                                               TrackingRecHit2DSOAView::AverageGeometry,
+                                               uint32_t,
+                                               Hist,
+                                               TrackingRecHit2DSOAView>;
+
+    template <size_t I>
+    Layout::ColumnType<I>* column() {
+      return m_layout.column<I>(alpaka::getPtrNative(m_buffer));
+    }
+    template <size_t I>
+    Layout::ColumnType<I> const* column() const {
+      return m_layout.column<I>(alpaka::getPtrNative(m_buffer));
+    }
+    template <size_t I>
+    AlpakaDeviceView<const Layout::ColumnType<I>> columnView(uint32_t n) const {
+      return cms::alpakatools::createDeviceView<Layout::ColumnType<I>>(column<I>(), n);
+    }
+
+    // OWNING DEVICE BUFFER
+    Layout m_layout;
+    AlpakaDeviceBuf<std::byte> m_buffer;
   };
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
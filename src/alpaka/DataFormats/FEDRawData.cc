@@ -17,18 +17,35 @@ FEDRawData::FEDRawData(size_t newsize) : data_(newsize) {
     throw std::runtime_error("FEDRawData::resize: " + std::to_string(newsize) + " is not a multiple of 8 bytes.");
 }
 
-FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_) {}
+FEDRawData::FEDRawData(const unsigned char *data, size_t size) : view_(data), viewSize_(size) {
+  if (size % 8 != 0)
+    throw std::runtime_error("FEDRawData: " + std::to_string(size) + " is not a multiple of 8 bytes.");
+}
+
+FEDRawData::FEDRawData(const FEDRawData &in) : data_(in.data_), view_(in.view_), viewSize_(in.viewSize_) {}
 FEDRawData::~FEDRawData() {}
-const unsigned char *FEDRawData::data() const { return data_.data(); }
+const unsigned char *FEDRawData::data() const { return view_ ? view_ : data_.data(); }
 
-unsigned char *FEDRawData::data() { return data_.data(); }
+unsigned char *FEDRawData::data() {
+  detach();
+  return data_.data();
+}
 
 void FEDRawData::resize(size_t newsize) {
   if (size() == newsize)
     return;
 
+  detach();
   data_.resize(newsize);
 
   if (newsize % 8 != 0)
     throw std::runtime_error("FEDRawData::resize: " + std::to_string(newsize) + " is not a multiple of 8 bytes.");
 }
+
+void FEDRawData::detach() {
+  if (view_) {
+    data_.assign(view_, view_ + viewSize_);
+    view_ = nullptr;
+    viewSize_ = 0;
+  }
+}
@@ -29,6 +29,11 @@ public:
   /// word (8 bytes)
   FEDRawData(size_t newsize);
 
+  /// Ctor for a non-owning view over size bytes starting at data.
+  /// The memory must outlive the object (and all its copies); it is
+  /// copied into an owned buffer only if the data are modified.
+  FEDRawData(const unsigned char *data, size_t size);
+
   /// Copy constructor
   FEDRawData(const FEDRawData &);
 
@@ -42,14 +47,19 @@ public:
   unsigned char *data();
 
   /// Lenght of the data buffer in bytes
-  size_t size() const { return data_.size(); }
+  size_t size() const { return view_ ? viewSize_ : data_.size(); }
 
   /// Resize to the specified size in bytes. It is required that
   /// the size is a multiple of the size of a FED word (8 bytes)
   void resize(size_t newsize);
 
 private:
+  /// Copy the viewed data into the owned buffer
+  void detach();
+
   Data data_;
+  const unsigned char *view_ = nullptr;
+  size_t viewSize_ = 0;
 };
 
 #endif
@@ -26,6 +26,9 @@ public:
   FEDRawData& FEDData(int fedid);
 
   FEDRawDataCollection(const FEDRawDataCollection&);
+  FEDRawDataCollection(FEDRawDataCollection&&) = default;
+  FEDRawDataCollection& operator=(const FEDRawDataCollection&) = default;
+  FEDRawDataCollection& operator=(FEDRawDataCollection&&) = default;
 
   void swap(FEDRawDataCollection& other) { data_.swap(other.data_); }
 
@@ -9,6 +9,7 @@ namespace edm {
     ESProducer() = default;
     virtual ~ESProducer() = default;
 
+    // Puts the products in the EventSetup, either directly or with EventSetup::putLazy()
     virtual void produce(EventSetup& eventSetup) = 0;
   };
 }  // namespace edm
@@ -2,6 +2,7 @@
 #define Event_h
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -14,18 +15,25 @@ namespace edm {
   class WrapperBase {
   public:
     virtual ~WrapperBase() = default;
+
+    // destroy the product, keeping the Wrapper itself for the next event
+    virtual void reset() = 0;
   };
 
   template <typename T>
   class Wrapper : public WrapperBase {
   public:
     template <typename... Args>
-    explicit Wrapper(Args&&... args) : obj_{std::forward<Args>(args)...} {}
+    void emplace(Args&&... args) {
+      obj_.emplace(std::forward<Args>(args)...);
+    }
+
+    T const& product() const { return *obj_; }
 
-    T const& product() const { return obj_; }
+    void reset() override { obj_.reset(); }
 
   private:
-    T obj_;
+    std::optional<T> obj_;
   };
 
   class Event {
@@ -43,7 +51,24 @@ namespace edm {
 
     template <typename T, typename... Args>
     void emplace(EDPutTokenT<T> const& token, Args&&... args) {
-      products_[token.index()] = std::make_unique<Wrapper<T>>(std::forward<Args>(args)...);
+      // the product slots are allocated on the first event, and reused by the following ones
+      auto& slot = products_[token.index()];
+      if (not slot) {
+        slot = std::make_unique<Wrapper<T>>();
+      }
+      static_cast<Wrapper<T>&>(*slot).emplace(std::forward<Args>(args)...);
+    }
+
+    // internal interface
+    // The Event objects are owned by the StreamSchedule and recycled from one event to the next
+    void beginEvent(int eventId) { eventId_ = eventId; }
+
+    void endEvent() {
+      for (auto& slot : products_) {
+        if (slot) {
+          slot->reset();
+        }
+      }
     }
 
   private:
@@ -0,0 +1,34 @@
+#include <exception>
+
+#include "Framework/EventSetup.h"
+#include "Framework/FunctorTask.h"
+#include "Framework/NumaDomains.h"
+#include "Framework/WaitingTaskHolder.h"
+
+namespace edm {
+  void EventSetup::prefetchAsync(WaitingTaskHolder holder) const {
+    for (int domain = 0; domain < numa::numberOfDomains(); ++domain) {
+      for (auto const& product : typeToProduct_) {
+        ESWrapperBase const* wrapper = product.second.get();
+        auto prefetch = [wrapper, domain, holder]() mutable {
+          try {
+            wrapper->prefetch(domain);
+          } catch (...) {
+            holder.doneWaiting(std::current_exception());
+            return;
+          }
+          holder.doneWaiting(std::exception_ptr{});
+        };
+        if (numa::numberOfDomains() > 1) {
+          numa::enqueue(domain, std::move(prefetch));
+        } else {
+          auto task = make_functor_task(std::move(prefetch));
+          holder.group()->run([task]() {
+            TaskSentry s{task};
+            task->execute();
+          });
+        }
+      }
+    }
+  }
+}  // namespace edm
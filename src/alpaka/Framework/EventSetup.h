@@ -1,47 +1,82 @@
 #ifndef EventSetup_h
 #define EventSetup_h
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 #include <iostream>
 
+#include "Framework/NumaDomains.h"
+
 namespace edm {
+  class WaitingTaskHolder;
+
   // This is very different from CMSSW, but (hopefully) good-enough
   // for this test
   class ESWrapperBase {
   public:
     virtual ~ESWrapperBase() = default;
+
+    // Makes the copy of the product of a NUMA domain if it is produced lazily and not made yet, thread safe
+    virtual void prefetch(int domain) const = 0;
   };
 
+  // A lazy product is made once per NUMA domain (see Framework/NumaDomains.h), by a thread of that
+  // domain, so that the streams of each domain read a copy in their local memory.
   template <typename T>
   class ESWrapper : public ESWrapperBase {
   public:
-    explicit ESWrapper(std::unique_ptr<T> obj) : obj_{std::move(obj)} {}
+    explicit ESWrapper(std::unique_ptr<T> obj) : products_(1) { products_[0].obj = std::move(obj); }
+    explicit ESWrapper(std::function<std::unique_ptr<T>()> maker)
+        : maker_{std::move(maker)}, products_(numa::numberOfDomains()) {}
 
-    T const& product() const { return *obj_; }
+    void prefetch(int domain) const override {
+      if (maker_) {
+        auto& product = products_[domain];
+        // if the maker throws, the next call tries again
+        std::call_once(product.made, [this, &product]() { product.obj = maker_(); });
+      }
+    }
+
+    T const& product() const {
+      int const domain = products_.size() > 1 ? numa::currentDomain() : 0;
+      prefetch(domain);
+      return *products_[domain].obj;
+    }
 
   private:
-    std::unique_ptr<T> obj_;
+    struct Product {
+      std::once_flag made;
+      std::unique_ptr<T> obj;
+    };
+
+    std::function<std::unique_ptr<T>()> maker_;
+    mutable std::vector<Product> products_;
   };
 
+  // All the products are put before the processing starts, and only get() and prefetchAsync() can be
+  // called concurrently.
   class EventSetup {
   public:
     explicit EventSetup() {}
 
     template <typename T>
     void put(std::unique_ptr<T> prod) {
-#ifdef __cpp_lib_unordered_map_try_emplace
-      auto succeeded =
-          typeToProduct_.try_emplace(std::type_index(typeid(T)), std::make_unique<ESWrapper<T>>(std::move(prod)));
-#else
-      auto succeeded =
-          typeToProduct_.emplace(std::type_index(typeid(T)), std::make_unique<ESWrapper<T>>(std::move(prod)));
-#endif
-      if (not succeeded.second) {
-        throw std::runtime_error(std::string("Product of type ") + typeid(T).name() + " already exists");
-      }
+      insert<T>(std::make_unique<ESWrapper<T>>(std::move(prod)));
+    }
+
+    // The product is made by calling maker on the first get(), or by prefetchAsync(), whichever comes first,
+    // once per NUMA domain.
+    // The maker must not refer to the ESProducer, that may be destroyed in the meantime.
+    template <typename T>
+    void putLazy(std::function<std::unique_ptr<T>()> maker) {
+      insert<T>(std::make_unique<ESWrapper<T>>(std::move(maker)));
     }
 
     template <typename T>
@@ -53,7 +88,23 @@ namespace edm {
       return static_cast<ESWrapper<T> const&>(*(found->second)).product();
     }
 
+    // Makes all the lazy products concurrently, in one task each in the arena of each NUMA domain, and signals
+    // the holder when all are done
+    void prefetchAsync(WaitingTaskHolder holder) const;
+
   private:
+    template <typename T>
+    void insert(std::unique_ptr<ESWrapper<T>> wrapper) {
+#ifdef __cpp_lib_unordered_map_try_emplace
+      auto succeeded = typeToProduct_.try_emplace(std::type_index(typeid(T)), std::move(wrapper));
+#else
+      auto succeeded = typeToProduct_.emplace(std::type_index(typeid(T)), std::move(wrapper));
+#endif
+      if (not succeeded.second) {
+        throw std::runtime_error(std::string("Product of type ") + typeid(T).name() + " already exists");
+      }
+    }
+
     std::unordered_map<std::type_index, std::unique_ptr<ESWrapperBase>> typeToProduct_;
   };
 }  // namespace edm
@@ -0,0 +1,29 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Framework/LatencyHistogram.h"
+
+namespace edm {
+  LatencyHistogram::Duration LatencyHistogram::mean() const {
+    auto const n = count();
+    return Duration(n > 0 ? sum_.load(std::memory_order_relaxed) / n : 0);
+  }
+
+  LatencyHistogram::Duration LatencyHistogram::quantile(double q) const {
+    auto const n = count();
+    if (n == 0) {
+      return Duration(0);
+    }
+    // rank of the quantile, between 1 and n
+    auto const rank = std::clamp<uint64_t>(std::ceil(q * n), 1, n);
+    uint64_t entries = 0;
+    for (int i = 0; i < kBins; ++i) {
+      entries += bins_[i].load(std::memory_order_relaxed);
+      if (entries >= rank) {
+        // the maximum is exact, and tighter than the edge of its bin
+        return Duration(std::min(lastValue(i), max_.load(std::memory_order_relaxed)));
+      }
+    }
+    return max();
+  }
+}  // namespace edm
@@ -0,0 +1,63 @@
+#ifndef LatencyHistogram_h
+#define LatencyHistogram_h
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace edm {
+  // Histogram of durations, filled concurrently by the streams without locks.
+  // The bins are exact up to 64 ns, and then each power of two is split in 64 bins, so that the
+  // quantiles are accurate to better than 2%.
+  class LatencyHistogram {
+  public:
+    using Duration = std::chrono::nanoseconds;
+
+    void fill(Duration duration) {
+      uint64_t const value = duration.count() > 0 ? duration.count() : 0;
+      bins_[bin(value)].fetch_add(1, std::memory_order_relaxed);
+      count_.fetch_add(1, std::memory_order_relaxed);
+      sum_.fetch_add(value, std::memory_order_relaxed);
+      uint64_t max = max_.load(std::memory_order_relaxed);
+      while (value > max and not max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+      }
+    }
+
+    // to be read after all the fill() calls
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    Duration mean() const;
+    Duration max() const { return Duration(max_.load(std::memory_order_relaxed)); }
+    // largest value of the bin that contains the quantile q, in [0, 1]
+    Duration quantile(double q) const;
+
+    static constexpr int kSubBits = 6;
+    static constexpr uint64_t kSubBins = 1 << kSubBits;
+    static constexpr int kBins = (64 - kSubBits + 1) * kSubBins;
+
+    // bin of a value in ns, and largest value in that bin
+    static int bin(uint64_t value) {
+      if (value < kSubBins) {
+        return value;
+      }
+      int const shift = 63 - __builtin_clzll(value) - kSubBits;
+      return (shift + 1) * kSubBins + ((value >> shift) - kSubBins);
+    }
+
+    static uint64_t lastValue(int bin) {
+      if (bin < static_cast<int>(kSubBins)) {
+        return bin;
+      }
+      int const shift = bin / kSubBins - 1;
+      return ((kSubBins + bin % kSubBins) << shift) + ((uint64_t(1) << shift) - 1);
+    }
+
+  private:
+    std::array<std::atomic<uint64_t>, kBins> bins_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+  };
+}  // namespace edm
+
+#endif
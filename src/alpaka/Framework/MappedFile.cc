@@ -0,0 +1,45 @@
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Framework/MappedFile.h"
+
+namespace edm {
+  MappedFile::MappedFile(std::filesystem::path const& filename) : name_(filename.string()) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open " + name_ + ": " + std::strerror(errno));
+    }
+    size_ = std::filesystem::file_size(filename);
+    if (size_ == 0) {
+      close(fd);
+      throw std::runtime_error("File " + name_ + " is empty");
+    }
+    void* map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+      throw std::runtime_error("Failed to map " + name_ + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<unsigned char const*>(map);
+  }
+
+  MappedFile::~MappedFile() { munmap(const_cast<unsigned char*>(data_), size_); }
+
+  unsigned char const* MappedFileReader::next(size_t bytes, size_t alignment) {
+    if (offset_ + bytes > file_.size()) {
+      throw std::runtime_error("Truncated file " + file_.name() + ": reading " + std::to_string(bytes) +
+                               " bytes at offset " + std::to_string(offset_) + " of " + std::to_string(file_.size()));
+    }
+    auto const* ptr = file_.data() + offset_;
+    if (reinterpret_cast<uintptr_t>(ptr) % alignment != 0) {
+      throw std::runtime_error("Misaligned field in file " + file_.name() + ": offset " + std::to_string(offset_) +
+                               " is not a multiple of " + std::to_string(alignment));
+    }
+    offset_ += bytes;
+    return ptr;
+  }
+}  // namespace edm
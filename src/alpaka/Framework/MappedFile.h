@@ -0,0 +1,58 @@
+#ifndef MappedFile_h
+#define MappedFile_h
+
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+namespace edm {
+  // Read-only memory mapping of a whole file, unmapped on destruction
+  class MappedFile {
+  public:
+    explicit MappedFile(std::filesystem::path const& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::string const& name() const { return name_; }
+    unsigned char const* data() const { return data_; }
+    size_t size() const { return size_; }
+
+  private:
+    std::string name_;
+    unsigned char const* data_ = nullptr;
+    size_t size_ = 0;
+  };
+
+  // Sequential reader of a MappedFile, that throws if the file is shorter than expected.
+  // The mapping starts on a page boundary, but the position of each field depends on the file layout:
+  // view() throws if it is not aligned for the type of the field, read() copies it to an aligned value.
+  class MappedFileReader {
+  public:
+    explicit MappedFileReader(MappedFile const& file) : file_(file) {}
+
+    // copy of a value from a possibly unaligned address
+    template <typename T>
+    T read() {
+      T value;
+      std::memcpy(&value, next(sizeof(T)), sizeof(T));
+      return value;
+    }
+
+    // n consecutive values in the mapped memory, to be copied with alpaka::memcpy or std::memcpy
+    template <typename T>
+    T const* view(size_t n) {
+      return reinterpret_cast<T const*>(next(n * sizeof(T), alignof(T)));
+    }
+
+  private:
+    unsigned char const* next(size_t bytes, size_t alignment = 1);
+
+    MappedFile const& file_;
+    size_t offset_ = 0;
+  };
+}  // namespace edm
+
+#endif
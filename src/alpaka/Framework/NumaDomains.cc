@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef ALPAKA_USE_HWLOC
+#include <hwloc.h>
+#endif
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "Framework/NumaDomains.h"
+
+namespace {
+  thread_local int threadDomain = 0;
+
+#ifdef ALPAKA_USE_HWLOC
+  // binding of the thread before it entered the arena of a domain; the arenas are never nested
+  thread_local hwloc_bitmap_t previousBinding = nullptr;
+
+  // Binds the threads that enter the arena of a domain to the cores of the domain, and restores their
+  // binding when they leave it, as the TBB worker threads move between the arenas
+  class DomainBinder : public tbb::task_scheduler_observer {
+  public:
+    DomainBinder(tbb::task_arena& arena, hwloc_topology_t topology, hwloc_const_cpuset_t cpuset, int domain)
+        : tbb::task_scheduler_observer(arena), topology_(topology), cpuset_(cpuset), domain_(domain) {
+      observe(true);
+    }
+    ~DomainBinder() override { observe(false); }
+
+    void on_scheduler_entry(bool) override {
+      if (previousBinding == nullptr) {
+        previousBinding = hwloc_bitmap_alloc();
+      }
+      hwloc_get_cpubind(topology_, previousBinding, HWLOC_CPUBIND_THREAD);
+      hwloc_set_cpubind(topology_, cpuset_, HWLOC_CPUBIND_THREAD);
+      threadDomain = domain_;
+    }
+
+    void on_scheduler_exit(bool) override {
+      threadDomain = 0;
+      hwloc_set_cpubind(topology_, previousBinding, HWLOC_CPUBIND_THREAD);
+    }
+
+  private:
+    hwloc_topology_t topology_;
+    hwloc_const_cpuset_t cpuset_;
+    int domain_;
+  };
+
+  struct Domain {
+    Domain(hwloc_topology_t topology, hwloc_const_cpuset_t cpuset, int domain, int numberOfThreads)
+        // only the arena of the first domain is joined by the main thread while it waits for the events
+        : arena(numberOfThreads, domain == 0 ? 1 : 0) {
+      arena.initialize();
+      binder = std::make_unique<DomainBinder>(arena, topology, cpuset, domain);
+    }
+
+    tbb::task_arena arena;
+    std::unique_ptr<DomainBinder> binder;
+  };
+
+  struct Domains {
+    hwloc_topology_t topology = nullptr;
+    std::vector<std::unique_ptr<Domain>> domains;
+  };
+
+  // Never destroyed, as the arenas must not be terminated after the TBB scheduler
+  Domains* domains = nullptr;
+#endif
+}  // namespace
+
+namespace edm {
+  namespace numa {
+    void enable(int numberOfThreads, int numberOfStreams) {
+#ifdef ALPAKA_USE_HWLOC
+      if (domains != nullptr) {
+        throw std::logic_error("The NUMA domains are already enabled");
+      }
+      auto state = std::make_unique<Domains>();
+      hwloc_topology_init(&state->topology);
+      hwloc_topology_load(state->topology);
+
+      // the nodes without cores, e.g. of high-bandwidth memory, can not host a domain
+      std::vector<hwloc_obj_t> nodes;
+      hwloc_obj_t node = nullptr;
+      while ((node = hwloc_get_next_obj_by_type(state->topology, HWLOC_OBJ_NUMANODE, node)) != nullptr) {
+        if (node->cpuset != nullptr and not hwloc_bitmap_iszero(node->cpuset)) {
+          nodes.push_back(node);
+        }
+      }
+
+      int const n = std::min({static_cast<int>(nodes.size()), numberOfStreams, numberOfThreads});
+      if (n > 1) {
+        for (int i = 0; i < n; ++i) {
+          int const threads = numberOfThreads / n + (i < numberOfThreads % n ? 1 : 0);
+          state->domains.push_back(std::make_unique<Domain>(state->topology, nodes[i]->cpuset, i, threads));
+        }
+      }
+      domains = state.release();
+#else
+      throw std::runtime_error("The NUMA domains require hwloc, rebuild with ALPAKA_USE_HWLOC=1");
+#endif
+    }
+
+    int numberOfDomains() {
+#ifdef ALPAKA_USE_HWLOC
+      if (domains != nullptr and not domains->domains.empty()) {
+        return domains->domains.size();
+      }
+#endif
+      return 1;
+    }
+
+    int currentDomain() { return threadDomain; }
+
+    void execute(int domain, std::function<void()> const& f) {
+#ifdef ALPAKA_USE_HWLOC
+      if (numberOfDomains() > 1) {
+        domains->domains.at(domain)->arena.execute(f);
+        return;
+      }
+#endif
+      f();
+    }
+
+    void enqueue(int domain, std::function<void()> f) {
+#ifdef ALPAKA_USE_HWLOC
+      if (numberOfDomains() > 1) {
+        domains->domains.at(domain)->arena.enqueue(std::move(f));
+        return;
+      }
+#endif
+      tbb::this_task_arena::enqueue(std::move(f));
+    }
+  }  // namespace numa
+}  // namespace edm
@@ -0,0 +1,38 @@
+#ifndef NumaDomains_h
+#define NumaDomains_h
+
+#include <functional>
+
+namespace edm {
+  namespace numa {
+
+    // Unless enabled, the program sees a single domain, and none of the functions below changes how the
+    // work is scheduled. Once enabled, the streams are spread over the NUMA domains of the machine, and
+    // each domain runs its tasks in a TBB arena of its own, whose threads are bound to the cores of the
+    // domain. The memory is placed on first touch, so what a thread of a domain allocates and initialises
+    // lands in the memory local to that domain.
+
+    // Use up to one domain per NUMA node, but not more than numberOfStreams, and split numberOfThreads
+    // between them. To be called once, after the TBB scheduler has been initialised and before the
+    // processing starts. Throws if the program was built without hwloc.
+    void enable(int numberOfThreads, int numberOfStreams);
+
+    // 1 unless enabled on a machine with several NUMA nodes
+    int numberOfDomains();
+
+    // Domain whose arena the current thread is working in, 0 outside of the arenas
+    int currentDomain();
+
+    // Domain that processes the events of a stream
+    inline int domainOfStream(int streamId) { return streamId % numberOfDomains(); }
+
+    // Run f in the arena of the domain, and wait for it to return
+    void execute(int domain, std::function<void()> const& f);
+
+    // Run f in the arena of the domain, asynchronously
+    void enqueue(int domain, std::function<void()> f);
+
+  }  // namespace numa
+}  // namespace edm
+
+#endif
@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cxxabi.h>
+
+#include "Framework/Timing.h"
+
+namespace edm::timing::detail {
+  bool enabled = false;
+}  // namespace edm::timing::detail
+
+namespace {
+  using edm::timing::Clock;
+  using edm::timing::Kind;
+
+  // bound the memory used by the trace, about 50 bytes per interval
+  constexpr size_t kMaxIntervals = 1 << 22;
+
+  struct Stats {
+    size_t calls = 0;
+    Clock::duration total{};
+    Clock::duration max{};
+
+    void add(Clock::duration duration) {
+      ++calls;
+      total += duration;
+      max = std::max(max, duration);
+    }
+
+    void merge(Stats const& other) {
+      calls += other.calls;
+      total += other.total;
+      max = std::max(max, other.max);
+    }
+  };
+
+  struct Interval {
+    Kind kind;
+    char const* name;
+    int stream;
+    Clock::time_point begin;
+    Clock::time_point end;
+  };
+
+  // the statistics are keyed by the address of the name, and merged by name at the end of the job
+  using Key = std::pair<Kind, char const*>;
+  struct KeyHash {
+    size_t operator()(Key const& key) const {
+      return std::hash<char const*>()(key.second) ^ static_cast<size_t>(key.first);
+    }
+  };
+
+  // filled only by its own thread, so that the measurements do not need any synchronisation
+  struct ThreadData {
+    int id;
+    std::unordered_map<Key, Stats, KeyHash> stats;
+    std::vector<Interval> intervals;
+  };
+
+  struct StreamState {
+    std::mutex mutex;
+    int running = 0;
+    Clock::time_point idleSince;
+    std::string name;
+  };
+
+  struct Registry {
+    std::mutex mutex;
+    // owned here rather than by the threads, as the worker threads of the queues may exit before the end of the job
+    std::vector<std::unique_ptr<ThreadData>> threads;
+    std::unique_ptr<StreamState[]> streams;
+    int numberOfStreams = 0;
+    bool trace = false;
+    Clock::time_point start;
+    std::atomic<size_t> intervals{0};
+  };
+
+  Registry& registry() {
+    static Registry instance;
+    return instance;
+  }
+
+  thread_local ThreadData* threadData = nullptr;
+  thread_local int threadStream = -1;
+
+  ThreadData& localData() {
+    if (threadData == nullptr) {
+      auto& reg = registry();
+      std::scoped_lock lock(reg.mutex);
+      reg.threads.push_back(std::make_unique<ThreadData>());
+      threadData = reg.threads.back().get();
+      threadData->id = reg.threads.size();
+    }
+    return *threadData;
+  }
+
+  char const* kindName(Kind kind) {
+    switch (kind) {
+      case Kind::Acquire:
+        return "acquire";
+      case Kind::Produce:
+        return "produce";
+      case Kind::QueueWait:
+        return "queue wait";
+      case Kind::Kernel:
+        return "kernel";
+      case Kind::Idle:
+        return "idle";
+    }
+    return "";
+  }
+
+  // the kernels are identified by the mangled name of their type, that the module labels are not
+  std::string displayName(char const* name) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status == 0) {
+      std::string ret(demangled);
+      std::free(demangled);
+      return ret;
+    }
+    return name;
+  }
+
+  std::string jsonEscape(std::string const& str) {
+    std::string ret;
+    ret.reserve(str.size());
+    for (char c : str) {
+      if (c == '"' or c == '\\') {
+        ret += '\\';
+      }
+      ret += c;
+    }
+    return ret;
+  }
+
+  double milliseconds(Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); }
+
+  double microseconds(Clock::duration duration) { return std::chrono::duration<double, std::micro>(duration).count(); }
+}  // namespace
+
+namespace edm::timing {
+  void enable(int numberOfStreams, bool trace) {
+    auto& reg = registry();
+    reg.numberOfStreams = numberOfStreams;
+    reg.streams = std::make_unique<StreamState[]>(numberOfStreams);
+    for (int i = 0; i < numberOfStreams; ++i) {
+      reg.streams[i].name = "stream " + std::to_string(i);
+    }
+    reg.trace = trace;
+    reg.start = Clock::now();
+    detail::enabled = true;
+  }
+
+  int currentStream() { return threadStream; }
+
+  void record(Kind kind, char const* name, int stream, Clock::time_point begin, Clock::time_point end) {
+    auto& data = localData();
+    data.stats[Key(kind, name)].add(end - begin);
+    auto& reg = registry();
+    if (reg.trace and reg.intervals.fetch_add(1, std::memory_order_relaxed) < kMaxIntervals) {
+      data.intervals.push_back(Interval{kind, name, stream, begin, end});
+    }
+  }
+
+  void ModuleScope::start(std::string const& label) {
+    label_ = label.c_str();
+    previousStream_ = threadStream;
+    threadStream = stream_;
+    begin_ = Clock::now();
+    if (kind_ == Kind::Produce and acquireEnd_ != Clock::time_point()) {
+      record(Kind::QueueWait, label_, stream_, acquireEnd_, begin_);
+      acquireEnd_ = Clock::time_point();
+    }
+
+    // the stream is idle between the end of its last running module and the start of the next one
+    auto& state = registry().streams[stream_];
+    Clock::time_point idleSince;
+    {
+      std::scoped_lock lock(state.mutex);
+      if (state.running++ == 0) {
+        idleSince = state.idleSince;
+      }
+    }
+    if (idleSince != Clock::time_point()) {
+      record(Kind::Idle, state.name.c_str(), stream_, idleSince, begin_);
+    }
+  }
+
+  void ModuleScope::stop() {
+    auto const end = Clock::now();
+    record(kind_, label_, stream_, begin_, end);
+    if (kind_ == Kind::Acquire) {
+      acquireEnd_ = end;
+    }
+    threadStream = previousStream_;
+
+    auto& state = registry().streams[stream_];
+    std::scoped_lock lock(state.mutex);
+    if (--state.running == 0) {
+      state.idleSince = end;
+    }
+  }
+
+  void printSummary(std::ostream& out) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    std::map<std::pair<Kind, std::string>, Stats> merged;
+    for (auto const& data : reg.threads) {
+      for (auto const& [key, stats] : data->stats) {
+        merged[std::make_pair(key.first, displayName(key.second))].merge(stats);
+      }
+    }
+
+    // within each kind, the most expensive first
+    std::vector<std::pair<std::pair<Kind, std::string>, Stats>> entries(merged.begin(), merged.end());
+    std::stable_sort(entries.begin(), entries.end(), [](auto const& a, auto const& b) {
+      if (a.first.first != b.first.first) {
+        return a.first.first < b.first.first;
+      }
+      return a.second.total > b.second.total;
+    });
+
+    auto const flags = out.flags();
+    auto const precision = out.precision();
+    out << "Timing summary, wall clock time in ms\n"
+        << "  " << std::left << std::setw(12) << "kind" << std::right << std::setw(10) << "calls" << std::setw(14)
+        << "total" << std::setw(12) << "mean" << std::setw(12) << "max"
+        << "  name\n";
+    out << std::fixed << std::setprecision(3);
+    for (auto const& [key, stats] : entries) {
+      out << "  " << std::left << std::setw(12) << kindName(key.first) << std::right << std::setw(10) << stats.calls
+          << std::setw(14) << milliseconds(stats.total) << std::setw(12) << milliseconds(stats.total) / stats.calls
+          << std::setw(12) << milliseconds(stats.max) << "  " << key.second << "\n";
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out.flush();
+  }
+
+  void writeTrace(std::string const& fileName) {
+    auto& reg = registry();
+    std::scoped_lock lock(reg.mutex);
+    std::ofstream out(fileName);
+    // one process per stream: the modules and the kernels are shown in the thread that runs them, the idle time of
+    // the stream in a thread of its own, and the queue waits, that overlap, as asynchronous events
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&]() -> std::ostream& {
+      if (not first) {
+        out << ",\n";
+      }
+      first = false;
+      return out;
+    };
+    for (int i = -1; i < reg.numberOfStreams; ++i) {
+      separator() << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << i << ",\"args\":{\"name\":\""
+                  << (i < 0 ? std::string("outside of the modules") : reg.streams[i].name) << "\"}}";
+      separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << i
+                  << ",\"tid\":0,\"args\":{\"name\":\"idle\"}}";
+    }
+    out << std::fixed << std::setprecision(3);
+    size_t id = 0;
+    std::unordered_map<char const*, std::string> names;
+    for (auto const& data : reg.threads) {
+      for (auto const& interval : data->intervals) {
+        auto found = names.find(interval.name);
+        if (found == names.end()) {
+          found = names.emplace(interval.name, jsonEscape(displayName(interval.name))).first;
+        }
+        auto const ts = microseconds(interval.begin - reg.start);
+        auto const dur = microseconds(interval.end - interval.begin);
+        if (interval.kind == Kind::QueueWait) {
+          ++id;
+          separator() << "{\"name\":\"" << found->second << "\",\"cat\":\"queue wait\",\"ph\":\"b\",\"id\":" << id
+                      << ",\"ts\":" << ts << ",\"pid\":" << interval.stream << ",\"tid\":0}";
+          separator() << "{\"name\":\"" << found->second << "\",\"cat\":\"queue wait\",\"ph\":\"e\",\"id\":" << id
+                      << ",\"ts\":" << ts + dur << ",\"pid\":" << interval.stream << ",\"tid\":0}";
+        } else {
+          int const tid = interval.kind == Kind::Idle ? 0 : data->id;
+          separator() << "{\"name\":\"" << found->second << "\",\"cat\":\"" << kindName(interval.kind)
+                      << "\",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur << ",\"pid\":" << interval.stream
+                      << ",\"tid\":" << tid << "}";
+        }
+      }
+    }
+    out << "\n]}\n";
+
+    auto const recorded = reg.intervals.load();
+    if (recorded > kMaxIntervals) {
+      std::cout << "Timing trace limited to the first " << kMaxIntervals << " of " << recorded << " intervals"
+                << std::endl;
+    }
+  }
+}  // namespace edm::timing
@@ -0,0 +1,81 @@
+#ifndef Timing_h
+#define Timing_h
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+
+namespace edm {
+  namespace timing {
+
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind {
+      Acquire,    // acquire() method of a module
+      Produce,    // produce() method of a module
+      QueueWait,  // from the end of acquire() to the start of produce(), or from the enqueue to the start of a kernel
+      Kernel,     // execution of a kernel
+      Idle        // no module of the stream is running, e.g. while the stream waits for the device
+    };
+
+    namespace detail {
+      // set once, before the processing starts
+      extern bool enabled;
+    }  // namespace detail
+
+    // The measurements are off unless enabled, and cost a single branch in that case
+    inline bool enabled() { return detail::enabled; }
+
+    // Enable the measurements for numberOfStreams streams, before the processing starts.
+    // With trace, also keep the individual intervals for writeTrace().
+    void enable(int numberOfStreams, bool trace);
+
+    // Stream whose module is running in the current thread, -1 outside of the modules
+    int currentStream();
+
+    // Record an interval; name must outlive the job (e.g. a module label, or the name of a kernel type)
+    void record(Kind kind, char const* name, int stream, Clock::time_point begin, Clock::time_point end);
+
+    // Measure the acquire() or produce() method of a module, and the idle time of its stream.
+    // acquireEnd keeps the end of the acquire() method, to measure the wait until the produce() method.
+    class ModuleScope {
+    public:
+      ModuleScope(Kind kind, std::string const& label, int stream, Clock::time_point& acquireEnd)
+          : kind_(kind), stream_(stream), acquireEnd_(acquireEnd) {
+        if (enabled()) {
+          start(label);
+        }
+      }
+      ~ModuleScope() {
+        if (label_) {
+          stop();
+        }
+      }
+
+      ModuleScope(ModuleScope const&) = delete;
+      ModuleScope& operator=(ModuleScope const&) = delete;
+
+    private:
+      void start(std::string const& label);
+      void stop();
+
+      Kind kind_;
+      int stream_;
+      Clock::time_point& acquireEnd_;
+      char const* label_ = nullptr;
+      int previousStream_ = -1;
+      Clock::time_point begin_;
+    };
+
+    // Print the calls, total, mean and maximum time of each module, kernel and stream.
+    // Not thread safe, to be called after the processing has finished.
+    void printSummary(std::ostream& out);
+
+    // Write the intervals in the Chrome trace event format (chrome://tracing or https://ui.perfetto.dev).
+    // Not thread safe, to be called after the processing has finished.
+    void writeTrace(std::string const& fileName);
+
+  }  // namespace timing
+}  // namespace edm
+
+#endif
@@ -2,16 +2,18 @@
 #define Worker_h
 
 #include <atomic>
+#include <string>
 #include <vector>
 //#include <iostream>
 
+#include "Framework/Event.h"
+#include "Framework/Timing.h"
 #include "Framework/WaitingTask.h"
 #include "Framework/WaitingTaskHolder.h"
 #include "Framework/WaitingTaskList.h"
 #include "Framework/WaitingTaskWithArenaHolder.h"
 
 namespace edm {
-  class Event;
   class EventSetup;
   class ProductRegistry;
 
@@ -20,14 +22,18 @@ namespace edm {
     Worker() : prefetchRequested_{false} {}
     virtual ~Worker() = default;
 
+    // not thread safe
+    void setLabel(std::string label) { label_ = std::move(label); }
+    std::string const& label() const { return label_; }
+
     // not thread safe
     void setItemsToGet(std::vector<Worker*> workers) { itemsToGet_ = std::move(workers); }
 
     // thread safe
-    void prefetchAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask);
+    void prefetchAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask);
 
     // not thread safe
-    virtual void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask) = 0;
+    virtual void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask) = 0;
 
     // not thread safe
     virtual void doEndJob() = 0;
@@ -42,6 +48,7 @@ namespace edm {
     virtual void doReset() = 0;
 
   private:
+    std::string label_;
     std::vector<Worker*> itemsToGet_;
     std::atomic<bool> prefetchRequested_;
   };
@@ -51,21 +58,23 @@ namespace edm {
   public:
     explicit WorkerT(ProductRegistry& reg) : producer_(reg), workStarted_{false} {}
 
-    void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask) override {
-      waitingTasksWork_.add(iTask);
+    void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask) override {
+      auto group = iTask.group();
+      waitingTasksWork_.add(std::move(iTask));
       //std::cout << "doWorkAsync for " << this << " with iTask " << iTask << std::endl;
       bool expected = false;
       if (workStarted_.compare_exchange_strong(expected, true)) {
         //std::cout << "first doWorkAsync call" << std::endl;
 
-        WaitingTask* moduleTask = make_waiting_task(
-            tbb::task::allocate_root(), [this, &event, &eventSetup](std::exception_ptr const* iPtr) mutable {
+        WaitingTaskHolder moduleTask(
+            *group, make_waiting_task([this, &event, &eventSetup](std::exception_ptr const* iPtr) mutable {
               if (iPtr) {
                 waitingTasksWork_.doneWaiting(*iPtr);
               } else {
                 std::exception_ptr exceptionPtr;
                 try {
                   //std::cout << "calling doProduce " << this << std::endl;
+                  timing::ModuleScope scope(timing::Kind::Produce, label(), event.streamID(), acquireEnd_);
                   producer_.doProduce(event, eventSetup);
                 } catch (...) {
                   exceptionPtr = std::current_exception();
@@ -73,27 +82,29 @@ namespace edm {
                 //std::cout << "waitingTasksWork_.doneWaiting " << this << std::endl;
                 waitingTasksWork_.doneWaiting(exceptionPtr);
               }
-            });
+            }));
         if (producer_.hasAcquire()) {
-          WaitingTaskWithArenaHolder runProduceHolder{moduleTask};
-          moduleTask = make_waiting_task(tbb::task::allocate_root(),
-                                         [this, &event, &eventSetup, runProduceHolder = std::move(runProduceHolder)](
-                                             std::exception_ptr const* iPtr) mutable {
-                                           if (iPtr) {
-                                             runProduceHolder.doneWaiting(*iPtr);
-                                           } else {
-                                             std::exception_ptr exceptionPtr;
-                                             try {
-                                               producer_.doAcquire(event, eventSetup, runProduceHolder);
-                                             } catch (...) {
-                                               exceptionPtr = std::current_exception();
-                                             }
-                                             runProduceHolder.doneWaiting(exceptionPtr);
-                                           }
-                                         });
+          WaitingTaskWithArenaHolder runProduceHolder{std::move(moduleTask)};
+          moduleTask = WaitingTaskHolder(
+              *group,
+              make_waiting_task([this, &event, &eventSetup, runProduceHolder = std::move(runProduceHolder)](
+                                    std::exception_ptr const* iPtr) mutable {
+                if (iPtr) {
+                  runProduceHolder.doneWaiting(*iPtr);
+                } else {
+                  std::exception_ptr exceptionPtr;
+                  try {
+                    timing::ModuleScope scope(timing::Kind::Acquire, label(), event.streamID(), acquireEnd_);
+                    producer_.doAcquire(event, eventSetup, runProduceHolder);
+                  } catch (...) {
+                    exceptionPtr = std::current_exception();
+                  }
+                  runProduceHolder.doneWaiting(exceptionPtr);
+                }
+              }));
         }
         //std::cout << "calling prefetchAsync " << this << " with moduleTask " << moduleTask << std::endl;
-        prefetchAsync(event, eventSetup, moduleTask);
+        prefetchAsync(event, eventSetup, std::move(moduleTask));
       }
     }
 
@@ -108,6 +119,7 @@ namespace edm {
     T producer_;
     WaitingTaskList waitingTasksWork_;
     std::atomic<bool> workStarted_;
+    timing::Clock::time_point acquireEnd_;
   };
 }  // namespace edm
 #endif
@@ -1,5 +1,11 @@
-#include "Framework/EmptyWaitingTask.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <tbb/task_group.h>
+
 #include "Framework/ESPluginFactory.h"
+#include "Framework/NumaDomains.h"
 #include "Framework/WaitingTask.h"
 #include "Framework/WaitingTaskHolder.h"
 
@@ -7,12 +13,15 @@
 
 namespace edm {
   EventProcessor::EventProcessor(int maxEvents,
-                                 int numberOfStreams,
-                                 std::vector<std::string> const& path,
+                                 std::vector<Path> const& paths,
                                  std::vector<std::string> const& esproducers,
                                  std::filesystem::path const& datadir,
-                                 bool validation)
-      : source_(maxEvents, registry_, datadir, validation) {
+                                 bool validation,
+                                 bool mapRaw,
+                                 bool keepEventLatencies)
+      : source_(maxEvents, registry_, datadir, validation, mapRaw), paths_(paths) {
+    // The ESProducers only register how to make their products, that are made on first use or by the
+    // prefetching in runToCompletion()
     for (auto const& name : esproducers) {
       pluginManager_.load(name);
       auto esp = ESPluginFactory::create(name, datadir);
@@ -20,26 +29,73 @@ namespace edm {
     }
 
     //schedules_.reserve(numberOfStreams);
-    for (int i = 0; i < numberOfStreams; ++i) {
-      schedules_.emplace_back(registry_, pluginManager_, &source_, &eventSetup_, i, path);
+    for (int p = 0; p < static_cast<int>(paths_.size()); ++p) {
+      for (int i = 0; i < paths_[p].numberOfStreams; ++i) {
+        int const streamId = schedules_.size();
+        schedules_.emplace_back(registry_,
+                                pluginManager_,
+                                &source_,
+                                &eventSetup_,
+                                streamId,
+                                paths_[p].modules,
+                                &eventLatency_,
+                                keepEventLatencies);
+        streamPath_.push_back(p);
+      }
     }
   }
 
   void EventProcessor::runToCompletion() {
     // The task that waits for all other work
-    auto globalWaitTask = make_empty_waiting_task();
-    globalWaitTask->increment_ref_count();
+    tbb::task_group group;
+    FinalWaitingTask globalWaitTask{group};
+    // Make the EventSetup products concurrently with the processing of the first events
+    eventSetup_.prefetchAsync(WaitingTaskHolder(group, &globalWaitTask));
     for (auto& s : schedules_) {
-      s.runToCompletionAsync(WaitingTaskHolder(globalWaitTask.get()));
-    }
-    globalWaitTask->wait_for_all();
-    if (globalWaitTask->exceptionPtr()) {
-      std::rethrow_exception(*(globalWaitTask->exceptionPtr()));
+      s.runToCompletionAsync(WaitingTaskHolder(group, &globalWaitTask));
     }
+    // with NUMA domains, the main thread helps the first domain while it waits
+    numa::execute(0, [&globalWaitTask]() { globalWaitTask.wait(); });
   }
 
   void EventProcessor::endJob() {
-    // Only on the first stream...
-    schedules_[0].endJob();
+    // Only on the first stream of each path...
+    for (size_t i = 0; i < schedules_.size(); ++i) {
+      if (i == 0 or streamPath_[i] != streamPath_[i - 1]) {
+        schedules_[i].endJob();
+      }
+    }
+  }
+
+  int EventProcessor::processedEvents(int path) const {
+    int events = 0;
+    for (size_t i = 0; i < schedules_.size(); ++i) {
+      if (streamPath_[i] == path) {
+        events += schedules_[i].processedEvents();
+      }
+    }
+    return events;
+  }
+
+  void EventProcessor::writeEventLatencies(std::string const& fileName) const {
+    // the start of the events relative to the start of the first one
+    auto start = std::chrono::steady_clock::time_point::max();
+    for (auto const& s : schedules_) {
+      for (auto const& event : s.eventLatencies()) {
+        start = std::min(start, event.begin);
+      }
+    }
+    std::ofstream out(fileName);
+    if (not out) {
+      throw std::runtime_error("Can not write the event latencies file " + fileName);
+    }
+    out << "stream,event,start_ms,latency_ms\n";
+    for (auto const& s : schedules_) {
+      for (auto const& event : s.eventLatencies()) {
+        out << s.streamId() << "," << event.eventId << ","
+            << std::chrono::duration<double, std::milli>(event.begin - start).count() << ","
+            << std::chrono::duration<double, std::milli>(event.end - event.begin).count() << "\n";
+      }
+    }
   }
 }  // namespace edm
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Framework/EventSetup.h"
+#include "Framework/LatencyHistogram.h"
 
 #include "PluginManager.h"
 #include "StreamSchedule.h"
@@ -14,25 +15,48 @@
 namespace edm {
   class EventProcessor {
   public:
+    // Modules run by a group of streams. Each stream runs the path of its group; in the dispatcher
+    // mode there is one group per backend, and the streams of all groups take the events from the
+    // same Source whenever they are free.
+    struct Path {
+      std::string name;
+      std::vector<std::string> modules;
+      int numberOfStreams;
+    };
+
     explicit EventProcessor(int maxEvents,
-                            int numberOfStreams,
-                            std::vector<std::string> const& path,
+                            std::vector<Path> const& paths,
                             std::vector<std::string> const& esproducers,
                             std::filesystem::path const& datadir,
-                            bool validation);
+                            bool validation,
+                            bool mapRaw,
+                            bool keepEventLatencies);
 
     int maxEvents() const { return source_.maxEvents(); }
 
+    std::vector<Path> const& paths() const { return paths_; }
+    // number of events processed by the streams of a path
+    int processedEvents(int path) const;
+
     void runToCompletion();
 
     void endJob();
 
+    // time from the start of Source::produce() to the end of each event
+    LatencyHistogram const& eventLatency() const { return eventLatency_; }
+    // write the latency of each event as CSV, requires keepEventLatencies
+    void writeEventLatencies(std::string const& fileName) const;
+
   private:
     edmplugin::PluginManager pluginManager_;
     ProductRegistry registry_;
     Source source_;
     EventSetup eventSetup_;
+    LatencyHistogram eventLatency_;
+    std::vector<Path> paths_;
     std::vector<StreamSchedule> schedules_;
+    // path of each stream
+    std::vector<int> streamPath_;
   };
 }  // namespace edm
 
@@ -1,7 +1,11 @@
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <stdexcept>
+
+#include "Framework/NumaDomains.h"
 
 #include "Source.h"
 
@@ -20,38 +24,68 @@ namespace {
     return rawCollection;
   }
 
+  // read a value from a possibly unaligned address, and advance the pointer
+  template <typename T>
+  T readValue(unsigned char const *&ptr) {
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return value;
+  }
+
 }  // namespace
 
 namespace edm {
-  Source::Source(int maxEvents, ProductRegistry &reg, std::filesystem::path const &datadir, bool validation)
-      : maxEvents_(maxEvents), numEvents_(0), rawToken_(reg.produces<FEDRawDataCollection>()), validation_(validation) {
-    std::ifstream in_raw(datadir / "raw.bin", std::ios::binary);
-    std::ifstream in_digiclusters;
-    std::ifstream in_tracks;
-    std::ifstream in_vertices;
+  Source::Source(
+      int maxEvents, ProductRegistry &reg, std::filesystem::path const &datadir, bool validation, bool mapRaw)
+      : maxEvents_(maxEvents),
+        numEvents_(0),
+        rawToken_(reg.produces<FEDRawDataCollection>()),
+        validation_(validation),
+        mapRaw_(mapRaw) {
+    if (mapRaw_) {
+      mapRawFile(datadir / "raw.bin");
+    } else {
+      std::ifstream in_raw(datadir / "raw.bin", std::ios::binary);
+      auto &raw = raw_.emplace_back();
+
+      unsigned int nfeds;
+      in_raw.exceptions(std::ifstream::badbit);
+      in_raw.read(reinterpret_cast<char *>(&nfeds), sizeof(unsigned int));
+      while (not in_raw.eof()) {
+        in_raw.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
+
+        raw.emplace_back(readRaw(in_raw, nfeds));
+
+        // next event
+        in_raw.exceptions(std::ifstream::badbit);
+        in_raw.read(reinterpret_cast<char *>(&nfeds), sizeof(unsigned int));
+      }
+
+      // each domain gets a copy made by one of its threads; the mapped file is shared by all of them
+      if (numa::numberOfDomains() > 1) {
+        std::vector<std::vector<FEDRawDataCollection>> replicas(numa::numberOfDomains());
+        for (int domain = 0; domain < numa::numberOfDomains(); ++domain) {
+          numa::execute(domain, [&]() { replicas[domain] = raw_.front(); });
+        }
+        raw_ = std::move(replicas);
+      }
+    }
+    const size_t nevents = mapRaw_ ? rawOffsets_.size() : raw_.front().size();
 
     if (validation_) {
       digiClusterToken_ = reg.produces<DigiClusterCount>();
       trackToken_ = reg.produces<TrackCount>();
       vertexToken_ = reg.produces<VertexCount>();
 
-      in_digiclusters = std::ifstream(datadir / "digicluster.bin", std::ios::binary);
-      in_tracks = std::ifstream(datadir / "tracks.bin", std::ios::binary);
-      in_vertices = std::ifstream(datadir / "vertices.bin", std::ios::binary);
+      std::ifstream in_digiclusters(datadir / "digicluster.bin", std::ios::binary);
+      std::ifstream in_tracks(datadir / "tracks.bin", std::ios::binary);
+      std::ifstream in_vertices(datadir / "vertices.bin", std::ios::binary);
       in_digiclusters.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
       in_tracks.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
       in_vertices.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
-    }
-
-    unsigned int nfeds;
-    in_raw.exceptions(std::ifstream::badbit);
-    in_raw.read(reinterpret_cast<char *>(&nfeds), sizeof(unsigned int));
-    while (not in_raw.eof()) {
-      in_raw.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
 
-      raw_.emplace_back(readRaw(in_raw, nfeds));
-
-      if (validation_) {
+      for (size_t i = 0; i < nevents; ++i) {
         unsigned int nm, nd, nc, nt, nv;
         in_digiclusters.read(reinterpret_cast<char *>(&nm), sizeof(unsigned int));
         in_digiclusters.read(reinterpret_cast<char *>(&nd), sizeof(unsigned int));
@@ -63,38 +97,81 @@ namespace edm {
         vertices_.emplace_back(nv);
       }
 
-      // next event
-      in_raw.exceptions(std::ifstream::badbit);
-      in_raw.read(reinterpret_cast<char *>(&nfeds), sizeof(unsigned int));
+      assert(nevents == digiclusters_.size());
+      assert(nevents == tracks_.size());
+      assert(nevents == vertices_.size());
     }
 
-    if (validation_) {
-      assert(raw_.size() == digiclusters_.size());
-      assert(raw_.size() == tracks_.size());
-      assert(raw_.size() == vertices_.size());
+    if (maxEvents_ < 0) {
+      maxEvents_ = nevents;
     }
+  }
 
-    if (maxEvents_ < 0) {
-      maxEvents_ = raw_.size();
+  void Source::mapRawFile(std::filesystem::path const &filename) {
+    rawFile_ = std::make_unique<MappedFile>(filename);
+    unsigned char const *rawMap = rawFile_->data();
+    size_t const rawMapSize = rawFile_->size();
+
+    // Index the events, reading only the FED headers. The events beyond maxEvents are never used.
+    size_t offset = 0;
+    while (offset < rawMapSize and (maxEvents_ < 0 or rawOffsets_.size() < static_cast<size_t>(maxEvents_))) {
+      rawOffsets_.push_back(offset);
+      if (offset + sizeof(unsigned int) > rawMapSize) {
+        throw std::runtime_error("Truncated event " + std::to_string(rawOffsets_.size()) + " in " + filename.string());
+      }
+      unsigned char const *ptr = rawMap + offset;
+      auto const nfeds = readValue<unsigned int>(ptr);
+      offset += sizeof(unsigned int);
+      for (unsigned int ifed = 0; ifed < nfeds; ++ifed) {
+        if (offset + 2 * sizeof(unsigned int) > rawMapSize) {
+          throw std::runtime_error("Truncated event " + std::to_string(rawOffsets_.size()) + " in " +
+                                   filename.string());
+        }
+        ptr = rawMap + offset + sizeof(unsigned int);
+        auto const fedSize = readValue<unsigned int>(ptr);
+        offset += 2 * sizeof(unsigned int) + fedSize;
+      }
+      if (offset > rawMapSize) {
+        throw std::runtime_error("Truncated event " + std::to_string(rawOffsets_.size()) + " in " + filename.string());
+      }
+    }
+  }
+
+  FEDRawDataCollection Source::mappedRaw(int index) const {
+    // The FEDRawData refer to the mapped memory, that stays valid for the lifetime of the Source.
+    // NB: the FED payloads are only guaranteed to be 4-byte aligned in the file.
+    FEDRawDataCollection rawCollection;
+    unsigned char const *ptr = rawFile_->data() + rawOffsets_[index];
+    auto const nfeds = readValue<unsigned int>(ptr);
+    for (unsigned int ifed = 0; ifed < nfeds; ++ifed) {
+      auto const fedId = readValue<unsigned int>(ptr);
+      auto const fedSize = readValue<unsigned int>(ptr);
+      rawCollection.FEDData(fedId) = FEDRawData(ptr, fedSize);
+      ptr += fedSize;
     }
+    return rawCollection;
   }
 
-  std::unique_ptr<Event> Source::produce(int streamId, ProductRegistry const &reg) {
+  bool Source::produce(Event &event) {
     const int old = numEvents_.fetch_add(1);
     const int iev = old + 1;
     if (old >= maxEvents_) {
-      return nullptr;
+      return false;
     }
-    auto ev = std::make_unique<Event>(streamId, iev, reg);
-    const int index = old % raw_.size();
+    event.beginEvent(iev);
+    const int index = old % (mapRaw_ ? rawOffsets_.size() : raw_.front().size());
 
-    ev->emplace(rawToken_, raw_[index]);
+    if (mapRaw_) {
+      event.emplace(rawToken_, mappedRaw(index));
+    } else {
+      event.emplace(rawToken_, raw_[raw_.size() > 1 ? numa::currentDomain() : 0][index]);
+    }
     if (validation_) {
-      ev->emplace(digiClusterToken_, digiclusters_[index]);
-      ev->emplace(trackToken_, tracks_[index]);
-      ev->emplace(vertexToken_, vertices_[index]);
+      event.emplace(digiClusterToken_, digiclusters_[index]);
+      event.emplace(trackToken_, tracks_[index]);
+      event.emplace(vertexToken_, vertices_[index]);
     }
 
-    return ev;
+    return true;
   }
 }  // namespace edm
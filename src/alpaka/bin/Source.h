@@ -2,11 +2,14 @@
 #define Source_h
 
 #include <atomic>
+#include <cstddef>
 #include <filesystem>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "Framework/Event.h"
+#include "Framework/MappedFile.h"
 #include "DataFormats/FEDRawDataCollection.h"
 #include "DataFormats/DigiClusterCount.h"
 #include "DataFormats/TrackCount.h"
@@ -15,25 +18,40 @@
 namespace edm {
   class Source {
   public:
-    explicit Source(int maxEvents, ProductRegistry& reg, std::filesystem::path const& datadir, bool validation);
+    // If mapRaw is true, the raw data file is memory-mapped instead of being read in memory, and each
+    // event gets a FEDRawDataCollection that refers to the mapped bytes without copying them
+    explicit Source(
+        int maxEvents, ProductRegistry& reg, std::filesystem::path const& datadir, bool validation, bool mapRaw);
+
+    Source(Source const&) = delete;
+    Source& operator=(Source const&) = delete;
 
     int maxEvents() const { return maxEvents_; }
 
     // thread safe
-    std::unique_ptr<Event> produce(int streamId, ProductRegistry const& reg);
+    // Fills the (recycled) event with the next input, returns false when there are no more events
+    bool produce(Event& event);
 
   private:
+    void mapRawFile(std::filesystem::path const& filename);
+    FEDRawDataCollection mappedRaw(int index) const;
+
     int maxEvents_;
     std::atomic<int> numEvents_;
     EDPutTokenT<FEDRawDataCollection> const rawToken_;
     EDPutTokenT<DigiClusterCount> digiClusterToken_;
     EDPutTokenT<TrackCount> trackToken_;
     EDPutTokenT<VertexCount> vertexToken_;
-    std::vector<FEDRawDataCollection> raw_;
+    // one copy of the raw data per NUMA domain, in the memory local to the domain
+    std::vector<std::vector<FEDRawDataCollection>> raw_;
+    // memory-mapped raw data file, and offset of each event in it
+    std::unique_ptr<MappedFile> rawFile_;
+    std::vector<size_t> rawOffsets_;
     std::vector<DigiClusterCount> digiclusters_;
     std::vector<TrackCount> tracks_;
     std::vector<VertexCount> vertices_;
     bool const validation_;
+    bool const mapRaw_;
   };
 }  // namespace edm
 
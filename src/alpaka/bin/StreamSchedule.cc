@@ -1,8 +1,9 @@
 //#include <iostream>
 
-#include <tbb/task.h>
-
+#include "Framework/Event.h"
 #include "Framework/FunctorTask.h"
+#include "Framework/LatencyHistogram.h"
+#include "Framework/NumaDomains.h"
 #include "Framework/PluginFactory.h"
 #include "Framework/WaitingTask.h"
 #include "Framework/Worker.h"
@@ -17,14 +18,22 @@ namespace edm {
                                  Source* source,
                                  EventSetup const* eventSetup,
                                  int streamId,
-                                 std::vector<std::string> const& path)
-      : registry_(std::move(reg)), source_(source), eventSetup_(eventSetup), streamId_(streamId) {
+                                 std::vector<std::string> const& path,
+                                 LatencyHistogram* eventLatency,
+                                 bool keepEventLatencies)
+      : registry_(std::move(reg)),
+        source_(source),
+        eventSetup_(eventSetup),
+        streamId_(streamId),
+        eventLatency_(eventLatency),
+        keepEventLatencies_(keepEventLatencies) {
     path_.reserve(path.size());
     int modInd = 1;
     for (auto const& name : path) {
       pluginManager.load(name);
       registry_.beginModuleConstruction(modInd);
       path_.emplace_back(PluginFactory::create(name, registry_));
+      path_.back()->setLabel(name);
       //std::cout << "module " << modInd << " " << path_.back().get() << std::endl;
       std::vector<Worker*> consumes;
       for (unsigned int depInd : registry_.consumedModules()) {
@@ -36,6 +45,7 @@ namespace edm {
       path_.back()->setItemsToGet(std::move(consumes));
       ++modInd;
     }
+    event_ = std::make_unique<Event>(streamId_, 0, registry_);
   }
 
   StreamSchedule::~StreamSchedule() = default;
@@ -43,49 +53,61 @@ namespace edm {
   StreamSchedule& StreamSchedule::operator=(StreamSchedule&&) = default;
 
   void StreamSchedule::runToCompletionAsync(WaitingTaskHolder h) {
-    auto task =
-        make_functor_task(tbb::task::allocate_root(), [this, h]() mutable { processOneEventAsync(std::move(h)); });
-    if (streamId_ == 0) {
-      tbb::task::spawn(*task);
-    } else {
-      tbb::task::enqueue(*task);
+    // all the tasks of the stream follow from the first one, and stay in the arena of its NUMA domain
+    if (numa::numberOfDomains() > 1) {
+      numa::enqueue(numa::domainOfStream(streamId_), [this, h]() mutable { processOneEventAsync(std::move(h)); });
+      return;
     }
+    auto group = h.group();
+    auto task = make_functor_task([this, h = std::move(h)]() mutable { processOneEventAsync(std::move(h)); });
+    group->run([task]() {
+      TaskSentry s{task};
+      task->execute();
+    });
   }
 
   void StreamSchedule::processOneEventAsync(WaitingTaskHolder h) {
-    auto event = source_->produce(streamId_, registry_);
-    if (event) {
-      // Pass the event object ownership to the "end-of-event" task
-      // Pass a non-owning pointer to the event to preceding tasks
-      //std::cout << "Begin processing event " << event->eventID() << std::endl;
-      auto eventPtr = event.get();
+    auto const eventBegin = std::chrono::steady_clock::now();
+    if (source_->produce(*event_)) {
+      //std::cout << "Begin processing event " << event_->eventID() << std::endl;
+      auto group = h.group();
       auto nextEventTask =
-          make_waiting_task(tbb::task::allocate_root(),
-                            [this, h = std::move(h), ev = std::move(event)](std::exception_ptr const* iPtr) mutable {
-                              ev.reset();
-                              if (iPtr) {
-                                h.doneWaiting(*iPtr);
-                              } else {
-                                for (auto const& worker : path_) {
-                                  worker->reset();
-                                }
-                                processOneEventAsync(std::move(h));
-                              }
-                            });
+          make_waiting_task([this, h = std::move(h), eventBegin](std::exception_ptr const* iPtr) mutable {
+            // destroy the products, but keep the Event and its product slots for the next event
+            event_->endEvent();
+            recordEventLatency(eventBegin);
+            ++processedEvents_;
+            if (iPtr) {
+              h.doneWaiting(*iPtr);
+            } else {
+              for (auto const& worker : path_) {
+                worker->reset();
+              }
+              processOneEventAsync(std::move(h));
+            }
+          });
       // To guarantee that the nextEventTask is spawned also in
       // absence of Workers, and also to prevent spawning it before
       // all workers have been processed (should not happen though)
-      auto nextEventTaskHolder = WaitingTaskHolder(nextEventTask);
+      auto nextEventTaskHolder = WaitingTaskHolder(*group, nextEventTask);
 
       for (auto iWorker = path_.rbegin(); iWorker != path_.rend(); ++iWorker) {
         //std::cout << "calling doWorkAsync for " << iWorker->get() << " with nextEventTask " << nextEventTask << std::endl;
-        (*iWorker)->doWorkAsync(*eventPtr, *eventSetup_, nextEventTask);
+        (*iWorker)->doWorkAsync(*event_, *eventSetup_, nextEventTaskHolder);
       }
     } else {
       h.doneWaiting(std::exception_ptr{});
     }
   }
 
+  void StreamSchedule::recordEventLatency(std::chrono::steady_clock::time_point begin) {
+    auto const end = std::chrono::steady_clock::now();
+    eventLatency_->fill(end - begin);
+    if (keepEventLatencies_) {
+      eventLatencies_.push_back(EventLatency{event_->eventID(), begin, end});
+    }
+  }
+
   void StreamSchedule::endJob() {
     for (auto& w : path_) {
       w->doEndJob();
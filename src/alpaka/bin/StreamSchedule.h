@@ -1,6 +1,7 @@
 #ifndef StreamSchedule_h
 #define StreamSchedule_h
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -13,20 +14,30 @@ namespace edmplugin {
 }
 
 namespace edm {
+  class Event;
   class EventSetup;
+  class LatencyHistogram;
   class Source;
   class Worker;
 
   // Schedule of modules per stream (concurrent event)
   class StreamSchedule {
   public:
+    struct EventLatency {
+      int eventId;
+      std::chrono::steady_clock::time_point begin;
+      std::chrono::steady_clock::time_point end;
+    };
+
     // copy ProductRegistry per stream
     explicit StreamSchedule(ProductRegistry reg,
                             edmplugin::PluginManager& pluginManager,
                             Source* source,
                             EventSetup const* eventSetup,
                             int streamId,
-                            std::vector<std::string> const& path);
+                            std::vector<std::string> const& path,
+                            LatencyHistogram* eventLatency,
+                            bool keepEventLatencies);
     ~StreamSchedule();
     StreamSchedule(StreamSchedule const&) = delete;
     StreamSchedule& operator=(StreamSchedule const&) = delete;
@@ -37,14 +48,27 @@ namespace edm {
 
     void endJob();
 
+    int streamId() const { return streamId_; }
+    int processedEvents() const { return processedEvents_; }
+    // filled only with keepEventLatencies
+    std::vector<EventLatency> const& eventLatencies() const { return eventLatencies_; }
+
   private:
     void processOneEventAsync(WaitingTaskHolder h);
+    void recordEventLatency(std::chrono::steady_clock::time_point begin);
 
     ProductRegistry registry_;
     Source* source_;
     EventSetup const* eventSetup_;
     std::vector<std::unique_ptr<Worker>> path_;
+    // only one event is in flight in a stream, so a single Event object is recycled for all of them
+    std::unique_ptr<Event> event_;
     int streamId_;
+    int processedEvents_ = 0;
+    // time from the start of Source::produce() to the end of the event
+    LatencyHistogram* eventLatency_;
+    bool keepEventLatencies_;
+    std::vector<EventLatency> eventLatencies_;
   };
 }  // namespace edm
 
@@ -4,11 +4,17 @@
 #include <iomanip>
 #include <iostream>
 #include <filesystem>
+#include <numeric>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "AlpakaCore/alpakaConfigCommon.h"
-#include <tbb/task_scheduler_init.h>
+#include "AlpakaCore/allocatorStatus.h"
+#include "AlpakaCore/workDivTuning.h"
+#include "Framework/NumaDomains.h"
+#include "Framework/Timing.h"
+#include <tbb/global_control.h>
 
 #include "EventProcessor.h"
 
@@ -17,7 +23,9 @@ namespace {
     std::cout
         << name
         << ": [--serial] [--tbb] [--cuda] [--numberOfThreads NT] [--numberOfStreams NS] [--maxEvents ME] [--data PATH] "
-           "[--transfer] [--validation]\n\n"
+           "[--transfer] [--validation] [--dispatch] [--backendStreams NS1,NS2,...] [--mmap] [--numa] [--timing] "
+           "[--timingTrace FILE] [--latencyCSV FILE] [--workDivTuning FILE] [--calibrateWorkDivs FILE] "
+           "[--allocatorStatus]\n\n"
         << "Options\n"
         << " --serial            Use CPU Serial backend\n"
         << " --tbb               Use CPU TBB backend\n"
@@ -30,10 +38,27 @@ namespace {
         << " --validation        Run (rudimentary) validation at the end (implies --transfer)\n"
         << " --histogram         Produce histograms at the end (implies --transfer)\n"
         << " --empty             Ignore all producers (for testing only)\n"
+        << " --dispatch          Bind each stream to one of the backends, instead of running all the backends in each "
+           "stream\n"
+        << " --backendStreams    Number of streams of each backend, in the order of the backend options (requires "
+           "--dispatch, default is to split numberOfStreams evenly)\n"
+        << " --mmap              Memory-map the raw data file instead of reading it in memory at startup\n"
+        << " --numa              Spread the streams over the NUMA nodes (requires building with ALPAKA_USE_HWLOC=1)\n"
+        << " --timing            Measure the modules, the CPU kernels and the idle time of the streams\n"
+        << " --timingTrace       Also write the measurements to FILE in the Chrome trace format (implies --timing)\n"
+        << " --latencyCSV        Write the latency of each event to FILE\n"
+        << " --workDivTuning     Read the work divisions of the tuned kernels from FILE\n"
+        << " --calibrateWorkDivs Try the candidate work divisions of the tuned kernels, and write the fastest ones to "
+           "FILE\n"
+        << " --allocatorStatus   Print the usage of the caching allocators at the end\n"
         << std::endl;
   }
 
   enum class Backend { SERIAL, TBB, CUDA };
+
+  std::string backendName(Backend backend) {
+    return backend == Backend::SERIAL ? "serial" : backend == Backend::TBB ? "tbb" : "cuda";
+  }
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -48,6 +73,16 @@ int main(int argc, char** argv) {
   bool validation = false;
   bool histogram = false;
   bool empty = false;
+  bool dispatch = false;
+  std::vector<int> backendStreams;
+  bool mapRaw = false;
+  bool numa = false;
+  bool timing = false;
+  std::string timingTrace;
+  std::string latencyCSV;
+  std::string workDivTuning;
+  std::string calibrateWorkDivs;
+  bool allocatorStatus = false;
   for (auto i = args.begin() + 1, e = args.end(); i != e; ++i) {
     if (*i == "-h" or *i == "--help") {
       print_help(args.front());
@@ -80,15 +115,69 @@ int main(int argc, char** argv) {
       histogram = true;
     } else if (*i == "--empty") {
       empty = true;
+    } else if (*i == "--dispatch") {
+      dispatch = true;
+    } else if (*i == "--backendStreams") {
+      ++i;
+      std::stringstream ss(*i);
+      for (std::string n; std::getline(ss, n, ',');) {
+        backendStreams.push_back(std::stoi(n));
+      }
+    } else if (*i == "--mmap") {
+      mapRaw = true;
+    } else if (*i == "--numa") {
+      numa = true;
+    } else if (*i == "--timing") {
+      timing = true;
+    } else if (*i == "--timingTrace") {
+      ++i;
+      timing = true;
+      timingTrace = *i;
+    } else if (*i == "--latencyCSV") {
+      ++i;
+      latencyCSV = *i;
+    } else if (*i == "--workDivTuning") {
+      ++i;
+      workDivTuning = *i;
+    } else if (*i == "--calibrateWorkDivs") {
+      ++i;
+      calibrateWorkDivs = *i;
+    } else if (*i == "--allocatorStatus") {
+      allocatorStatus = true;
     } else {
       std::cout << "Invalid parameter " << *i << std::endl << std::endl;
       print_help(args.front());
       return EXIT_FAILURE;
     }
   }
+  // each backend is enabled once, in the order of the options
+  for (auto i = backends.begin(); i != backends.end();) {
+    i = std::find(backends.begin(), i, *i) != i ? backends.erase(i) : i + 1;
+  }
   if (numberOfStreams == 0) {
     numberOfStreams = numberOfThreads;
   }
+  if (dispatch) {
+    if (backends.empty()) {
+      std::cout << "--dispatch requires at least one backend" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (backendStreams.empty()) {
+      for (size_t i = 0; i < backends.size(); ++i) {
+        backendStreams.push_back(numberOfStreams / backends.size() + (i < numberOfStreams % backends.size() ? 1 : 0));
+      }
+    }
+    if (backendStreams.size() != backends.size() or
+        std::any_of(backendStreams.begin(), backendStreams.end(), [](int n) { return n < 1; })) {
+      std::cout << "--dispatch needs at least one stream for each of the " << backends.size() << " backends"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+    numberOfStreams = std::accumulate(backendStreams.begin(), backendStreams.end(), 0);
+  } else if (not backendStreams.empty()) {
+    std::cout << "--backendStreams requires --dispatch" << std::endl;
+    return EXIT_FAILURE;
+  }
   if (datadir.empty()) {
     datadir = std::filesystem::path(args[0]).parent_path() / "data";
   }
@@ -97,65 +186,108 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
-  // TO DO: Debug TBB backend.
-  if (auto found = std::find(backends.begin(), backends.end(), Backend::TBB); found != backends.end()) {
-    numberOfStreams = 1;  // Study intra-event parallelization.
-    // TO DO: Warning: does not seem to be able to control the number of threads in TBB pool
-    // from here with a tbb::task_scheduler_init init(numThreads).
-    // Successfully managed to control the number of threads in TBB pool for now, by adding & updating
-    // tbb::task_scheduler_init init(2) directly inside:
-    // external/alpaka/include/alpaka/kernel/TaskKernelCpuTbbBlocks.hpp (and make clean_alpaka).
+  // The TBB thread pool is shared between the framework, that processes numberOfStreams events
+  // concurrently, and the kernels of the TBB backend, that parallelise over the blocks of each
+  // kernel. The kernels of a non-blocking queue are launched from the worker thread of the queue,
+  // outside of the arena of the framework: use a global_control to limit the total number of
+  // threads, so that the inter- and intra-event parallelism draw from the same numberOfThreads.
+  tbb::global_control globalControl(tbb::global_control::max_allowed_parallelism, numberOfThreads);
 
-    numberOfThreads = tbb::task_scheduler_init::
-        default_num_threads();  // By default, this number of threads is chosen in Alpaka for the TBB pool.
+  // The NUMA domains must be set up before the EventProcessor, that makes the per-domain copies of the
+  // input data and of the conditions.
+  if (numa) {
+    try {
+      edm::numa::enable(numberOfThreads, numberOfStreams);
+    } catch (std::exception& e) {
+      std::cout << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "Spreading the streams over " << edm::numa::numberOfDomains() << " NUMA domains" << std::endl;
+  }
+
+  // The work divisions of the tuned kernels are chosen on each launch, see AlpakaCore/workDivTuning.h
+  if (not workDivTuning.empty()) {
+    try {
+      cms::alpakatools::tuning::load(workDivTuning);
+    } catch (std::exception& e) {
+      std::cout << e.what() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (not calibrateWorkDivs.empty()) {
+    cms::alpakatools::tuning::calibrate();
   }
 
   // NB: The choice & tuning of device at runtime needs to be handled properly
   // inside a ALPAKA_ACCELERATOR_NAMESPACE.
-  // For now, the choice is made at run time
-  // with --serial, --tbb (by default, numberOfThreads = TBB pool default), --cuda (1 GPU only).
+  // For now, the choice is made at run time with --serial, --tbb, --cuda (1 GPU only).
 
   // Initialize EventProcessor
-  std::vector<std::string> edmodules;
+  std::vector<edm::EventProcessor::Path> paths;
   std::vector<std::string> esmodules;
-  if (not empty) {
+  if (empty) {
+    paths.push_back(edm::EventProcessor::Path{"", {}, numberOfStreams});
+  } else {
     esmodules = {"BeamSpotESProducer", "SiPixelFedIdsESProducer"};
-    if (not backends.empty()) {
-      auto addModules = [&](std::string const& prefix, Backend backend) {
+    auto backendModules = [&](Backend backend) {
+      std::string const prefix = backend == Backend::SERIAL ? "alpaka_serial_sync::"
+                                 : backend == Backend::TBB  ? "alpaka_tbb_async::"
+                                                            : "alpaka_cuda_async::";
+      std::vector<std::string> edmodules;
+      edmodules.emplace_back(prefix + "BeamSpotToAlpaka");
+      edmodules.emplace_back(prefix + "SiPixelRawToCluster");
+      edmodules.emplace_back(prefix + "SiPixelRecHitAlpaka");
+      edmodules.emplace_back(prefix + "CAHitNtupletAlpaka");
+      edmodules.emplace_back(prefix + "PixelVertexProducerAlpaka");
+      if (transfer) {
+        edmodules.emplace_back(prefix + "PixelTrackSoAFromAlpaka");
+        edmodules.emplace_back(prefix + "PixelVertexSoAFromAlpaka");
+      }
+      if (validation) {
+        edmodules.emplace_back(prefix + "CountValidator");
+      }
+      if (histogram) {
+        edmodules.emplace_back(prefix + "HistoValidator");
+      }
+
+      esmodules.emplace_back(prefix + "SiPixelFedCablingMapESProducer");
+      esmodules.emplace_back(prefix + "SiPixelGainCalibrationForHLTESProducer");
+      esmodules.emplace_back(prefix + "PixelCPEFastESProducer");
+      return edmodules;
+    };
+    if (dispatch) {
+      // one path per backend, whose streams take whichever event is next
+      for (size_t i = 0; i < backends.size(); ++i) {
+        paths.push_back(
+            edm::EventProcessor::Path{backendName(backends[i]), backendModules(backends[i]), backendStreams[i]});
+      }
+    } else {
+      // every event goes through all the backends
+      paths.push_back(edm::EventProcessor::Path{"", {}, numberOfStreams});
+      for (auto backend : {Backend::SERIAL, Backend::TBB, Backend::CUDA}) {
         if (std::find(backends.begin(), backends.end(), backend) != backends.end()) {
-          edmodules.emplace_back(prefix + "BeamSpotToAlpaka");
-          edmodules.emplace_back(prefix + "SiPixelRawToCluster");
-          edmodules.emplace_back(prefix + "SiPixelRecHitAlpaka");
-          edmodules.emplace_back(prefix + "CAHitNtupletAlpaka");
-          edmodules.emplace_back(prefix + "PixelVertexProducerAlpaka");
-          if (transfer) {
-            edmodules.emplace_back(prefix + "PixelTrackSoAFromAlpaka");
-            edmodules.emplace_back(prefix + "PixelVertexSoAFromAlpaka");
-          }
-          if (validation) {
-            edmodules.emplace_back(prefix + "CountValidator");
-          }
-          if (histogram) {
-            edmodules.emplace_back(prefix + "HistoValidator");
-          }
-
-          esmodules.emplace_back(prefix + "SiPixelFedCablingMapESProducer");
-          esmodules.emplace_back(prefix + "SiPixelGainCalibrationForHLTESProducer");
-          esmodules.emplace_back(prefix + "PixelCPEFastESProducer");
+          auto edmodules = backendModules(backend);
+          paths.front().modules.insert(paths.front().modules.end(), edmodules.begin(), edmodules.end());
         }
-      };
-      addModules("alpaka_serial_sync::", Backend::SERIAL);
-      addModules("alpaka_tbb_async::", Backend::TBB);
-      addModules("alpaka_cuda_async::", Backend::CUDA);
+      }
     }
   }
-  edm::EventProcessor processor(
-      maxEvents, numberOfStreams, std::move(edmodules), std::move(esmodules), datadir, validation);
+  edm::EventProcessor processor(maxEvents,
+                                paths,
+                                std::move(esmodules),
+                                datadir,
+                                validation,
+                                mapRaw,
+                                not latencyCSV.empty());
   maxEvents = processor.maxEvents();
 
   std::cout << "Processing " << maxEvents << " events, of which " << numberOfStreams << " concurrently, with "
             << numberOfThreads << " threads." << std::endl;
 
+  if (timing) {
+    edm::timing::enable(numberOfStreams, not timingTrace.empty());
+  }
+
   // Run work
   auto start = std::chrono::high_resolution_clock::now();
   try {
@@ -190,10 +322,61 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
+  // Report the usage of the caching allocators
+  if (allocatorStatus) {
+    cms::alpakatools::allocator::printAllocatorStatus(std::cout);
+  }
+
+  if (not calibrateWorkDivs.empty()) {
+    cms::alpakatools::tuning::save(calibrateWorkDivs);
+    std::cout << "Work division tuning written to " << calibrateWorkDivs << std::endl;
+  }
+
+  // Report the time spent in the modules and in the kernels
+  if (timing) {
+    edm::timing::printSummary(std::cout);
+    if (not timingTrace.empty()) {
+      edm::timing::writeTrace(timingTrace);
+      std::cout << "Timing trace written to " << timingTrace << std::endl;
+    }
+  }
+
+  // Report the latency of the events, from the start of reading them to the end of their processing
+  {
+    auto const& latency = processor.eventLatency();
+    auto ms = [](auto duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+    std::string backendNames;
+    for (auto backend : backends) {
+      backendNames += backendNames.empty() ? "" : ",";
+      backendNames += backendName(backend);
+    }
+    std::cout << "Event latency with " << (backendNames.empty() ? "no" : backendNames) << " backend and "
+              << numberOfStreams << " streams: mean " << ms(latency.mean()) << " ms, p50 " << ms(latency.quantile(0.5))
+              << " ms, p90 " << ms(latency.quantile(0.9)) << " ms, p99 " << ms(latency.quantile(0.99)) << " ms, max "
+              << ms(latency.max()) << " ms" << std::endl;
+    if (not latencyCSV.empty()) {
+      try {
+        processor.writeEventLatencies(latencyCSV);
+      } catch (std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "Event latencies written to " << latencyCSV << std::endl;
+    }
+  }
+
   // Work done, report timing
   auto diff = stop - start;
   auto time = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(diff).count()) / 1e6;
   std::cout << "Processed " << maxEvents << " events in " << std::scientific << time << " seconds, throughput "
             << std::defaultfloat << (maxEvents / time) << " events/s." << std::endl;
+  if (dispatch and not empty) {
+    for (int i = 0; i < static_cast<int>(processor.paths().size()); ++i) {
+      auto const& path = processor.paths()[i];
+      auto const events = processor.processedEvents(i);
+      std::cout << "  backend " << path.name << " with " << path.numberOfStreams << " streams: " << events
+                << " events, throughput " << (events / time) << " events/s." << std::endl;
+    }
+  }
   return EXIT_SUCCESS;
 }
@@ -17,13 +17,15 @@ private:
 };
 
 void BeamSpotESProducer::produce(edm::EventSetup& eventSetup) {
-  auto bs = std::make_unique<BeamSpotPOD>();
+  eventSetup.putLazy<BeamSpotPOD>([filename = data_ / "beamspot.bin"]() {
+    auto bs = std::make_unique<BeamSpotPOD>();
 
-  std::ifstream in(data_ / "beamspot.bin", std::ios::binary);
-  in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
-  in.read(reinterpret_cast<char*>(bs.get()), sizeof(BeamSpotPOD));
+    std::ifstream in(filename, std::ios::binary);
+    in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
+    in.read(reinterpret_cast<char*>(bs.get()), sizeof(BeamSpotPOD));
 
-  eventSetup.put(std::move(bs));
+    return bs;
+  });
 }
 
 DEFINE_FWK_EVENTSETUP_MODULE(BeamSpotESProducer);
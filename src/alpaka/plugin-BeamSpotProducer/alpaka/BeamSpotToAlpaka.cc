@@ -1,3 +1,4 @@
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaDataFormats/BeamSpotAlpaka.h"
 
 #include "Framework/EDProducer.h"
@@ -5,34 +6,45 @@
 #include "Framework/EventSetup.h"
 #include "Framework/PluginFactory.h"
 
+#include <optional>
+
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class BeamSpotToAlpaka : public edm::EDProducer {
+  class BeamSpotToAlpaka : public edm::EDProducerExternalWork {
   public:
     explicit BeamSpotToAlpaka(edm::ProductRegistry& reg);
     ~BeamSpotToAlpaka() override = default;
 
+    void acquire(edm::Event const& iEvent,
+                 edm::EventSetup const& iSetup,
+                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
   private:
     edm::EDPutTokenT<BeamSpotAlpaka> bsPutToken_;
     // TO DO: Add implementation of cms::alpaka::Product?
     // const edm::EDPutTokenT<cms::alpaka::Product<BeamSpotAlpaka>> bsPutToken_;
+
+    Queue queue_;
+    std::optional<BeamSpotAlpaka> bs_;
   };
 
-  BeamSpotToAlpaka::BeamSpotToAlpaka(edm::ProductRegistry& reg) : bsPutToken_{reg.produces<BeamSpotAlpaka>()} {}
+  BeamSpotToAlpaka::BeamSpotToAlpaka(edm::ProductRegistry& reg)
+      : bsPutToken_{reg.produces<BeamSpotAlpaka>()}, queue_{device} {}
 
-  void BeamSpotToAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  void BeamSpotToAlpaka::acquire(edm::Event const& iEvent,
+                                 edm::EventSetup const& iSetup,
+                                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
+    // the EventSetup product outlives the asynchronous copy
     auto const& bsRaw = iSetup.get<BeamSpotPOD>();
+    bs_.emplace(&bsRaw, queue_);
 
-    // TO DO: Add inter-event parallelization. cms::alpaka::ScopedContextProduce?
-    // cms::alpaka::ScopedContextProduce ctx{iEvent.streamID()};
-    Queue queue(device);
-    BeamSpotAlpaka bs{&bsRaw, queue};
-
-    iEvent.emplace(bsPutToken_, std::move(bs));
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
+  }
 
-    alpaka::wait(queue);
+  void BeamSpotToAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+    iEvent.emplace(bsPutToken_, std::move(*bs_));
+    bs_.reset();
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
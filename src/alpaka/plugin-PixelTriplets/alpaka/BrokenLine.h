@@ -1,8 +1,11 @@
 #ifndef RecoPixelVertexing_PixelTrackFitting_interface_BrokenLine_h
 #define RecoPixelVertexing_PixelTrackFitting_interface_BrokenLine_h
 
+#include <type_traits>
+
 #include <Eigen/Eigenvalues>
 
+#include "FitLanes.h"
 #include "FitUtils.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -16,18 +19,27 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   */
     using karimaki_circle_fit = ALPAKA_ACCELERATOR_NAMESPACE::Rfit::circle_fit;
 
+    /*!
+    The functions below are templates on the scalar type T of the fit: Rfit::fit_t to fit one track, or
+    Rfit::Lanes<L> to fit L tracks at once, one per SIMD lane (see FitLanes.h).
+  */
+    template <typename T>
+    using karimaki_circle_fit_t = typename Rfit::LaneTraits<T>::circle_fit;
+    template <typename T>
+    using line_fit_t = typename Rfit::LaneTraits<T>::line_fit;
+
     /*!
     \brief data needed for the Broken Line fit procedure.
   */
-    template <int N>
+    template <int N, typename T = Rfit::fit_t>
     struct PreparedBrokenLineData {
-      int q;                      //!< particle charge
-      Rfit::Matrix2xNd<N> radii;  //!< xy data in the system in which the pre-fitted center is the origin
-      Rfit::VectorNd<N> s;        //!< total distance traveled in the transverse plane
-                                  //   starting from the pre-fitted closest approach
-      Rfit::VectorNd<N> S;        //!< total distance traveled (three-dimensional)
-      Rfit::VectorNd<N> Z;        //!< orthogonal coordinate to the pre-fitted line in the sz plane
-      Rfit::VectorNd<N> VarBeta;  //!< kink angles in the SZ plane
+      typename Rfit::LaneTraits<T>::charge_t q;  //!< particle charge
+      Eigen::Matrix<T, 2, N> radii;  //!< xy data in the system in which the pre-fitted center is the origin
+      Eigen::Matrix<T, N, 1> s;      //!< total distance traveled in the transverse plane
+                                     //   starting from the pre-fitted closest approach
+      Eigen::Matrix<T, N, 1> S;      //!< total distance traveled (three-dimensional)
+      Eigen::Matrix<T, N, 1> Z;      //!< orthogonal coordinate to the pre-fitted line in the sz plane
+      Eigen::Matrix<T, N, 1> VarBeta;  //!< kink angles in the SZ plane
     };
 
     /*!
@@ -44,20 +56,23 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     
     \return the variance of the planar angle ((theta_0)^2 /3).
   */
-    ALPAKA_FN_HOST_ACC inline double MultScatt(
-        const double& length, const double B, const double R, int Layer, double slope) {
+    template <typename T>
+    ALPAKA_FN_HOST_ACC inline T MultScatt(const T& length, const Rfit::fit_t B, const T R, int Layer, T slope) {
+      using std::abs;
+      using std::log;
+      using std::min;
       // limit R to 20GeV...
-      auto pt2 = std::min(20., B * R);
+      auto pt2 = min(Rfit::fit_t(20.), B * R);
       pt2 *= pt2;
-      constexpr double XXI_0 = 0.06 / 16.;  //!< inverse of radiation length of the material in cm
+      constexpr Rfit::fit_t XXI_0 = 0.06 / 16.;  //!< inverse of radiation length of the material in cm
       //if(Layer==1) XXI_0=0.06/16.;
       // else XXI_0=0.06/16.;
       //XX_0*=1;
-      constexpr double geometry_factor =
+      constexpr Rfit::fit_t geometry_factor =
           0.7;  //!< number between 1/3 (uniform material) and 1 (thin scatterer) to be manually tuned
-      constexpr double fact = geometry_factor * Rfit::sqr(13.6 / 1000.);
-      return fact / (pt2 * (1. + Rfit::sqr(slope))) * (std::abs(length) * XXI_0) *
-             Rfit::sqr(1. + 0.038 * log(std::abs(length) * XXI_0));
+      constexpr Rfit::fit_t fact = geometry_factor * Rfit::sqr(13.6 / 1000.);
+      return fact / (pt2 * (1. + Rfit::sqr(slope))) * (abs(length) * XXI_0) *
+             Rfit::sqr(1. + 0.038 * log(abs(length) * XXI_0));
     }
 
     /*!
@@ -67,8 +82,10 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     
     \return 2D rotation matrix.
   */
-    ALPAKA_FN_HOST_ACC inline Rfit::Matrix2d RotationMatrix(double slope) {
-      Rfit::Matrix2d Rot;
+    template <typename T>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, 2, 2> RotationMatrix(T slope) {
+      using std::sqrt;
+      Eigen::Matrix<T, 2, 2> Rot;
       Rot(0, 0) = 1. / sqrt(1. + Rfit::sqr(slope));
       Rot(0, 1) = slope * Rot(0, 0);
       Rot(1, 0) = -Rot(0, 1);
@@ -84,11 +101,16 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \param y0 y coordinate of the translation vector.
     \param jacobian passed by reference in order to save stack.
   */
-    ALPAKA_FN_HOST_ACC inline void TranslateKarimaki(karimaki_circle_fit& circle,
-                                                     double x0,
-                                                     double y0,
-                                                     Rfit::Matrix3d& jacobian) {
-      double A, U, BB, C, DO, DP, uu, xi, v, mu, lambda, zeta;
+    template <typename T>
+    ALPAKA_FN_HOST_ACC inline void TranslateKarimaki(karimaki_circle_fit_t<T>& circle,
+                                                     T x0,
+                                                     T y0,
+                                                     Eigen::Matrix<T, 3, 3>& jacobian) {
+      using std::atan2;
+      using std::cos;
+      using std::sin;
+      using std::sqrt;
+      T A, U, BB, C, DO, DP, uu, xi, v, mu, lambda, zeta;
       DP = x0 * cos(circle.par(0)) + y0 * sin(circle.par(0));
       DO = x0 * sin(circle.par(0)) - y0 * cos(circle.par(0)) + circle.par(1);
       uu = 1 + circle.par(2) * circle.par(1);
@@ -121,48 +143,49 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \param B magnetic field in Gev/cm/c.
     \param results PreparedBrokenLineData to be filled (see description of PreparedBrokenLineData).
   */
-    template <typename M3xN, typename V4, int N>
+    template <typename M3xN, typename V4, int N, typename T>
     ALPAKA_FN_HOST_ACC inline void prepareBrokenLineData(const M3xN& hits,
                                                          const V4& fast_fit,
-                                                         const double B,
-                                                         PreparedBrokenLineData<N>& results) {
+                                                         const Rfit::fit_t B,
+                                                         PreparedBrokenLineData<N, T>& results) {
+      using std::atan2;
       constexpr auto n = N;
       u_int i;
-      Rfit::Vector2d d;
-      Rfit::Vector2d e;
+      Eigen::Matrix<T, 2, 1> d;
+      Eigen::Matrix<T, 2, 1> e;
 
-      d = hits.block(0, 1, 2, 1) - hits.block(0, 0, 2, 1);
-      e = hits.block(0, n - 1, 2, 1) - hits.block(0, n - 2, 2, 1);
-      results.q = Rfit::cross2D(d, e) > 0 ? -1 : 1;
+      d = hits.template block<2, 1>(0, 1) - hits.template block<2, 1>(0, 0);
+      e = hits.template block<2, 1>(0, n - 1) - hits.template block<2, 1>(0, n - 2);
+      results.q = Rfit::chargeFromCross(Rfit::cross2D(d, e));
 
-      const double slope = -results.q / fast_fit(3);
+      const T slope = -results.q / fast_fit(3);
 
-      Rfit::Matrix2d R = RotationMatrix(slope);
+      Eigen::Matrix<T, 2, 2> R = RotationMatrix(slope);
 
       // calculate radii and s
-      results.radii = hits.block(0, 0, 2, n) - fast_fit.head(2) * Rfit::MatrixXd::Constant(1, n, 1);
-      e = -fast_fit(2) * fast_fit.head(2) / fast_fit.head(2).norm();
+      results.radii = hits.template block<2, N>(0, 0).colwise() - fast_fit.template head<2>();
+      e = -fast_fit(2) * fast_fit.template head<2>() / fast_fit.template head<2>().norm();
       for (i = 0; i < n; i++) {
-        d = results.radii.block(0, i, 2, 1);
+        d = results.radii.template block<2, 1>(0, i);
         results.s(i) = results.q * fast_fit(2) * atan2(Rfit::cross2D(d, e), d.dot(e));  // calculates the arc length
       }
-      Rfit::VectorNd<N> z = hits.block(2, 0, 1, n).transpose();
+      Eigen::Matrix<T, N, 1> z = hits.template block<1, N>(2, 0).transpose();
 
       //calculate S and Z
-      Rfit::Matrix2xNd<N> pointsSZ = Rfit::Matrix2xNd<N>::Zero();
+      Eigen::Matrix<T, 2, N> pointsSZ = Eigen::Matrix<T, 2, N>::Zero();
       for (i = 0; i < n; i++) {
         pointsSZ(0, i) = results.s(i);
         pointsSZ(1, i) = z(i);
-        pointsSZ.block(0, i, 2, 1) = R * pointsSZ.block(0, i, 2, 1);
+        pointsSZ.template block<2, 1>(0, i) = R * pointsSZ.template block<2, 1>(0, i);
       }
-      results.S = pointsSZ.block(0, 0, 1, n).transpose();
-      results.Z = pointsSZ.block(1, 0, 1, n).transpose();
+      results.S = pointsSZ.template block<1, N>(0, 0).transpose();
+      results.Z = pointsSZ.template block<1, N>(1, 0).transpose();
 
       //calculate VarBeta
       results.VarBeta(0) = results.VarBeta(n - 1) = 0;
       for (i = 1; i < n - 1; i++) {
-        results.VarBeta(i) = MultScatt(results.S(i + 1) - results.S(i), B, fast_fit(2), i + 2, slope) +
-                             MultScatt(results.S(i) - results.S(i - 1), B, fast_fit(2), i + 1, slope);
+        results.VarBeta(i) = MultScatt<T>(results.S(i + 1) - results.S(i), B, fast_fit(2), i + 2, slope) +
+                             MultScatt<T>(results.S(i) - results.S(i - 1), B, fast_fit(2), i + 1, slope);
       }
     }
 
@@ -175,14 +198,14 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     
     \return the n-by-n matrix of the linear system
   */
-    template <int N>
-    ALPAKA_FN_HOST_ACC inline Rfit::MatrixNd<N> MatrixC_u(const Rfit::VectorNd<N>& w,
-                                                          const Rfit::VectorNd<N>& S,
-                                                          const Rfit::VectorNd<N>& VarBeta) {
+    template <typename T, int N>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, N, N> MatrixC_u(const Eigen::Matrix<T, N, 1>& w,
+                                                               const Eigen::Matrix<T, N, 1>& S,
+                                                               const Eigen::Matrix<T, N, 1>& VarBeta) {
       constexpr u_int n = N;
       u_int i;
 
-      Rfit::MatrixNd<N> C_U = Rfit::MatrixNd<N>::Zero();
+      Eigen::Matrix<T, N, N> C_U = Eigen::Matrix<T, N, N>::Zero();
       for (i = 0; i < n; i++) {
         C_U(i, i) = w(i);
         if (i > 1)
@@ -219,23 +242,27 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     template <typename M3xN, typename V4>
     ALPAKA_FN_HOST_ACC inline void BL_Fast_fit(const M3xN& hits, V4& result) {
+      using T = typename M3xN::Scalar;
+      using std::abs;
+      using std::atan2;
+      using std::sqrt;
       constexpr uint32_t N = M3xN::ColsAtCompileTime;
       constexpr auto n = N;  // get the number of hits
 
-      const Rfit::Vector2d a = hits.block(0, n / 2, 2, 1) - hits.block(0, 0, 2, 1);
-      const Rfit::Vector2d b = hits.block(0, n - 1, 2, 1) - hits.block(0, n / 2, 2, 1);
-      const Rfit::Vector2d c = hits.block(0, 0, 2, 1) - hits.block(0, n - 1, 2, 1);
+      const Eigen::Matrix<T, 2, 1> a = hits.template block<2, 1>(0, n / 2) - hits.template block<2, 1>(0, 0);
+      const Eigen::Matrix<T, 2, 1> b = hits.template block<2, 1>(0, n - 1) - hits.template block<2, 1>(0, n / 2);
+      const Eigen::Matrix<T, 2, 1> c = hits.template block<2, 1>(0, 0) - hits.template block<2, 1>(0, n - 1);
 
       auto tmp = 0.5 / Rfit::cross2D(c, a);
       result(0) = hits(0, 0) - (a(1) * c.squaredNorm() + c(1) * a.squaredNorm()) * tmp;
       result(1) = hits(1, 0) + (a(0) * c.squaredNorm() + c(0) * a.squaredNorm()) * tmp;
       // check Wikipedia for these formulas
 
-      result(2) = sqrt(a.squaredNorm() * b.squaredNorm() * c.squaredNorm()) / (2. * std::abs(Rfit::cross2D(b, a)));
+      result(2) = sqrt(a.squaredNorm() * b.squaredNorm() * c.squaredNorm()) / (2. * abs(Rfit::cross2D(b, a)));
       // Using Math Olympiad's formula R=abc/(4A)
 
-      const Rfit::Vector2d d = hits.block(0, 0, 2, 1) - result.head(2);
-      const Rfit::Vector2d e = hits.block(0, n - 1, 2, 1) - result.head(2);
+      const Eigen::Matrix<T, 2, 1> d = hits.template block<2, 1>(0, 0) - result.template head<2>();
+      const Eigen::Matrix<T, 2, 1> e = hits.template block<2, 1>(0, n - 1) - result.template head<2>();
 
       result(3) = result(2) * atan2(Rfit::cross2D(d, e), d.dot(e)) / (hits(2, n - 1) - hits(2, 0));
       // ds/dz slope between last and first point
@@ -258,13 +285,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     The step 2 is the least square fit, done by imposing the minimum constraint on the cost function and solving the consequent linear system. It determines the fitted parameters u and \Delta\kappa and their covariance matrix.
     The step 3 is the correction of the fast pre-fitted parameters for the innermost part of the track. It is first done in a comfortable coordinate system (the one in which the first hit is the origin) and then the parameters and their covariance matrix are transformed to the original coordinate system.
   */
-    template <typename M3xN, typename M6xN, typename V4, int N>
+    template <typename M3xN, typename M6xN, typename V4, int N, typename T>
     ALPAKA_FN_HOST_ACC inline void BL_Circle_fit(const M3xN& hits,
                                                  const M6xN& hits_ge,
                                                  const V4& fast_fit,
-                                                 const double B,
-                                                 PreparedBrokenLineData<N>& data,
-                                                 karimaki_circle_fit& circle_results) {
+                                                 const Rfit::fit_t B,
+                                                 PreparedBrokenLineData<N, T>& data,
+                                                 karimaki_circle_fit_t<T>& circle_results) {
+      using std::atan2;
+      using std::sqrt;
       constexpr u_int n = N;
       u_int i;
 
@@ -274,16 +303,16 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       const auto& S = data.S;
       auto& Z = data.Z;
       auto& VarBeta = data.VarBeta;
-      const double slope = -circle_results.q / fast_fit(3);
+      const T slope = -circle_results.q / fast_fit(3);
       VarBeta *= 1. + Rfit::sqr(slope);  // the kink angles are projected!
 
       for (i = 0; i < n; i++) {
-        Z(i) = radii.block(0, i, 2, 1).norm() - fast_fit(2);
+        Z(i) = radii.template block<2, 1>(0, i).norm() - fast_fit(2);
       }
 
-      Rfit::Matrix2d V;     // covariance matrix
-      Rfit::VectorNd<N> w;  // weights
-      Rfit::Matrix2d RR;    // rotation matrix point by point
+      Eigen::Matrix<T, 2, 2> V;  // covariance matrix
+      Eigen::Matrix<T, N, 1> w;  // weights
+      Eigen::Matrix<T, 2, 2> RR;  // rotation matrix point by point
       //double Slope; // slope of the circle point by point
       for (i = 0; i < n; i++) {
         V(0, 0) = hits_ge.col(i)[0];            // x errors
@@ -294,14 +323,14 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         w(i) = 1. / ((RR * V * RR.transpose())(1, 1));  // compute the orthogonal weight point by point
       }
 
-      Rfit::VectorNplusONEd<N> r_u;
+      Eigen::Matrix<T, N + 1, 1> r_u;
       r_u(n) = 0;
       for (i = 0; i < n; i++) {
         r_u(i) = w(i) * Z(i);
       }
 
-      Rfit::MatrixNplusONEd<N> C_U;
-      C_U.block(0, 0, n, n) = MatrixC_u(w, s, VarBeta);
+      Eigen::Matrix<T, N + 1, N + 1> C_U;
+      C_U.template block<N, N>(0, 0) = MatrixC_u(w, s, VarBeta);
       C_U(n, n) = 0;
       //add the border to the C_u matrix
       for (i = 0; i < n; i++) {
@@ -324,38 +353,47 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #ifdef CPP_DUMP
       std::cout << "CU5\n" << C_U << std::endl;
 #endif
-      Rfit::MatrixNplusONEd<N> I;
+      Eigen::Matrix<T, N + 1, N + 1> I;
       math::cholesky::invert(C_U, I);
       // Rfit::MatrixNplusONEd<N> I = C_U.inverse();
 #ifdef CPP_DUMP
       std::cout << "I5\n" << I << std::endl;
 #endif
 
-      Rfit::VectorNplusONEd<N> u = I * r_u;  // obtain the fitted parameters by solving the linear system
+      Eigen::Matrix<T, N + 1, 1> u = I * r_u;  // obtain the fitted parameters by solving the linear system
 
       // compute (phi, d_ca, k) in the system in which the midpoint of the first two corrected hits is the origin...
 
-      radii.block(0, 0, 2, 1) /= radii.block(0, 0, 2, 1).norm();
-      radii.block(0, 1, 2, 1) /= radii.block(0, 1, 2, 1).norm();
+      radii.template block<2, 1>(0, 0) /= radii.template block<2, 1>(0, 0).norm();
+      radii.template block<2, 1>(0, 1) /= radii.template block<2, 1>(0, 1).norm();
 
-      Rfit::Vector2d d = hits.block(0, 0, 2, 1) + (-Z(0) + u(0)) * radii.block(0, 0, 2, 1);
-      Rfit::Vector2d e = hits.block(0, 1, 2, 1) + (-Z(1) + u(1)) * radii.block(0, 1, 2, 1);
+      Eigen::Matrix<T, 2, 1> d = hits.template block<2, 1>(0, 0) + (-Z(0) + u(0)) * radii.template block<2, 1>(0, 0);
+      Eigen::Matrix<T, 2, 1> e = hits.template block<2, 1>(0, 1) + (-Z(1) + u(1)) * radii.template block<2, 1>(0, 1);
 
-      circle_results.par << atan2((e - d)(1), (e - d)(0)),
-          -circle_results.q * (fast_fit(2) - sqrt(Rfit::sqr(fast_fit(2)) - 0.25 * (e - d).squaredNorm())),
+      // d_ca = R - sqrt(R^2 - |e - d|^2 / 4); in single precision it is written without the cancellation, that
+      // float cannot afford, while the double precision fit keeps the original expression and its results
+      const T halfChord2 = 0.25 * (e - d).squaredNorm();
+      T dca;
+      if constexpr (std::is_same_v<Rfit::fit_t, float>) {
+        dca = halfChord2 / (fast_fit(2) + sqrt(Rfit::sqr(fast_fit(2)) - halfChord2));
+      } else {
+        dca = fast_fit(2) - sqrt(Rfit::sqr(fast_fit(2)) - halfChord2);
+      }
+      circle_results.par << atan2((e - d)(1), (e - d)(0)), -circle_results.q * dca,
           circle_results.q * (1. / fast_fit(2) + u(n));
 
-      assert(circle_results.q * circle_results.par(1) <= 0);
+      for (int l = 0; l < Rfit::LaneTraits<T>::lanes; ++l)
+        assert(Rfit::lane(circle_results.q * circle_results.par(1), l) <= 0);
 
-      Rfit::Vector2d eMinusd = e - d;
-      double tmp1 = eMinusd.squaredNorm();
+      Eigen::Matrix<T, 2, 1> eMinusd = e - d;
+      T tmp1 = eMinusd.squaredNorm();
 
-      Rfit::Matrix3d jacobian;
+      Eigen::Matrix<T, 3, 3> jacobian;
       jacobian << (radii(1, 0) * eMinusd(0) - eMinusd(1) * radii(0, 0)) / tmp1,
           (radii(1, 1) * eMinusd(0) - eMinusd(1) * radii(0, 1)) / tmp1, 0,
-          (circle_results.q / 2) * (eMinusd(0) * radii(0, 0) + eMinusd(1) * radii(1, 0)) /
+          Rfit::halfCharge(circle_results.q) * (eMinusd(0) * radii(0, 0) + eMinusd(1) * radii(1, 0)) /
               sqrt(Rfit::sqr(2 * fast_fit(2)) - tmp1),
-          (circle_results.q / 2) * (eMinusd(0) * radii(0, 1) + eMinusd(1) * radii(1, 1)) /
+          Rfit::halfCharge(circle_results.q) * (eMinusd(0) * radii(0, 1) + eMinusd(1) * radii(1, 1)) /
               sqrt(Rfit::sqr(2 * fast_fit(2)) - tmp1),
           0, 0, 0, circle_results.q;
 
@@ -365,12 +403,12 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
       //...Translate in the system in which the first corrected hit is the origin, adding the m.s. correction...
 
-      TranslateKarimaki(circle_results, 0.5 * (e - d)(0), 0.5 * (e - d)(1), jacobian);
-      circle_results.cov(0, 0) += (1 + Rfit::sqr(slope)) * MultScatt(S(1) - S(0), B, fast_fit(2), 2, slope);
+      TranslateKarimaki<T>(circle_results, 0.5 * (e - d)(0), 0.5 * (e - d)(1), jacobian);
+      circle_results.cov(0, 0) += (1 + Rfit::sqr(slope)) * MultScatt<T>(S(1) - S(0), B, fast_fit(2), 2, slope);
 
       //...And translate back to the original system
 
-      TranslateKarimaki(circle_results, d(0), d(1), jacobian);
+      TranslateKarimaki<T>(circle_results, d(0), d(1), jacobian);
 
       // compute chi2
       circle_results.chi2 = 0;
@@ -403,12 +441,12 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     The step 2 is the least square fit, done by imposing the minimum constraint on the cost function and solving the consequent linear system. It determines the fitted parameters u and their covariance matrix.
     The step 3 is the correction of the fast pre-fitted parameters for the innermost part of the track. It is first done in a comfortable coordinate system (the one in which the first hit is the origin) and then the parameters and their covariance matrix are transformed to the original coordinate system.
   */
-    template <typename V4, typename M6xN, int N>
+    template <typename V4, typename M6xN, int N, typename T>
     ALPAKA_FN_HOST_ACC inline void BL_Line_fit(const M6xN& hits_ge,
                                                const V4& fast_fit,
-                                               const double B,
-                                               const PreparedBrokenLineData<N>& data,
-                                               Rfit::line_fit& line_results) {
+                                               const Rfit::fit_t B,
+                                               const PreparedBrokenLineData<N, T>& data,
+                                               line_fit_t<T>& line_results) {
       constexpr u_int n = N;
       u_int i;
 
@@ -417,13 +455,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       const auto& Z = data.Z;
       const auto& VarBeta = data.VarBeta;
 
-      const double slope = -data.q / fast_fit(3);
-      Rfit::Matrix2d R = RotationMatrix(slope);
+      const T slope = -data.q / fast_fit(3);
+      Eigen::Matrix<T, 2, 2> R = RotationMatrix(slope);
 
-      Rfit::Matrix3d V = Rfit::Matrix3d::Zero();  // covariance matrix XYZ
-      Rfit::Matrix2x3d JacobXYZtosZ =
-          Rfit::Matrix2x3d::Zero();  // jacobian for computation of the error on s (xyz -> sz)
-      Rfit::VectorNd<N> w = Rfit::VectorNd<N>::Zero();
+      Eigen::Matrix<T, 3, 3> V = Eigen::Matrix<T, 3, 3>::Zero();  // covariance matrix XYZ
+      Eigen::Matrix<T, 2, 3> JacobXYZtosZ =
+          Eigen::Matrix<T, 2, 3>::Zero();  // jacobian for computation of the error on s (xyz -> sz)
+      Eigen::Matrix<T, N, 1> w = Eigen::Matrix<T, N, 1>::Zero();
       for (i = 0; i < n; i++) {
         V(0, 0) = hits_ge.col(i)[0];            // x errors
         V(0, 1) = V(1, 0) = hits_ge.col(i)[1];  // cov_xy
@@ -431,7 +469,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         V(1, 1) = hits_ge.col(i)[2];            // y errors
         V(2, 1) = V(1, 2) = hits_ge.col(i)[4];  // cov_yz
         V(2, 2) = hits_ge.col(i)[5];            // z errors
-        auto tmp = 1. / radii.block(0, i, 2, 1).norm();
+        auto tmp = 1. / radii.template block<2, 1>(0, i).norm();
         JacobXYZtosZ(0, 0) = radii(1, i) * tmp;
         JacobXYZtosZ(0, 1) = -radii(0, i) * tmp;
         JacobXYZtosZ(1, 2) = 1.;
@@ -439,31 +477,31 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                         1, 1));  // compute the orthogonal weight point by point
       }
 
-      Rfit::VectorNd<N> r_u;
+      Eigen::Matrix<T, N, 1> r_u;
       for (i = 0; i < n; i++) {
         r_u(i) = w(i) * Z(i);
       }
 #ifdef CPP_DUMP
       std::cout << "CU4\n" << MatrixC_u(w, S, VarBeta) << std::endl;
 #endif
-      Rfit::MatrixNd<N> I;
+      Eigen::Matrix<T, N, N> I;
       math::cholesky::invert(MatrixC_u(w, S, VarBeta), I);
       //    Rfit::MatrixNd<N> I=MatrixC_u(w,S,VarBeta).inverse();
 #ifdef CPP_DUMP
       std::cout << "I4\n" << I << std::endl;
 #endif
 
-      Rfit::VectorNd<N> u = I * r_u;  // obtain the fitted parameters by solving the linear system
+      Eigen::Matrix<T, N, 1> u = I * r_u;  // obtain the fitted parameters by solving the linear system
 
       // line parameters in the system in which the first hit is the origin and with axis along SZ
       line_results.par << (u(1) - u(0)) / (S(1) - S(0)), u(0);
       auto idiff = 1. / (S(1) - S(0));
       line_results.cov << (I(0, 0) - 2 * I(0, 1) + I(1, 1)) * Rfit::sqr(idiff) +
-                              MultScatt(S(1) - S(0), B, fast_fit(2), 2, slope),
+                              MultScatt<T>(S(1) - S(0), B, fast_fit(2), 2, slope),
           (I(0, 1) - I(0, 0)) * idiff, (I(0, 1) - I(0, 0)) * idiff, I(0, 0);
 
       // translate to the original SZ system
-      Rfit::Matrix2d jacobian;
+      Eigen::Matrix<T, 2, 2> jacobian;
       jacobian(0, 0) = 1.;
       jacobian(0, 1) = 0;
       jacobian(1, 0) = -S(0);
@@ -532,7 +570,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     template <int N>
     inline Rfit::helix_fit BL_Helix_fit(const Rfit::Matrix3xNd<N>& hits,
                                         const Eigen::Matrix<float, 6, 4>& hits_ge,
-                                        const double B) {
+                                        const Rfit::fit_t B) {
       Rfit::helix_fit helix;
       Rfit::Vector4d fast_fit;
       BL_Fast_fit(hits, fast_fit);
@@ -1,6 +1,7 @@
 #include "BrokenLineFitOnGPU.h"
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
@@ -17,118 +18,117 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks / 4), Vec1::all(blockSize));
 
     //  Fit internals
-    auto hitsGPU_ = cms::alpakatools::allocDeviceBuf<double>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix3xNd<4>) /
-                                                             sizeof(double));
+    // the buffers are allocated on the queue, so they can go out of scope while the fits are still running
+    auto hitsGPU_ = allocDeviceBuf<Rfit::scratch_t>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix3x4d) / sizeof(Rfit::scratch_t), queue);
 
-    auto hits_geGPU_ =
-        cms::alpakatools::allocDeviceBuf<float>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix6x4f) / sizeof(float));
+    auto hits_geGPU_ = allocDeviceBuf<float>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix6x4f) / sizeof(float), queue);
 
-    auto fast_fit_resultsGPU_ =
-        cms::alpakatools::allocDeviceBuf<double>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Vector4d) / sizeof(double));
+    auto fast_fit_resultsGPU_ = allocDeviceBuf<Rfit::scratch_t>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Vector4s) / sizeof(Rfit::scratch_t), queue);
 
     for (uint32_t offset = 0; offset < maxNumberOfTuples; offset += maxNumberOfConcurrentFits_) {
       // fit triplets
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivTriplets,
-                                                     kernelBLFastFit<3>(),
-                                                     tuples_d,
-                                                     tupleMultiplicity_d,
-                                                     hv,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     3,
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivTriplets,
-                                                     kernelBLFit<3>(),
-                                                     tupleMultiplicity_d,
-                                                     bField_,
-                                                     outputSoa_d,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     3,
-                                                     offset));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivTriplets,
+                                            kernelBLFastFit<3>(),
+                                            tuples_d,
+                                            tupleMultiplicity_d,
+                                            hv,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            3,
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivTriplets,
+                                            kernelBLFit<3>(),
+                                            tupleMultiplicity_d,
+                                            bField_,
+                                            outputSoa_d,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            3,
+                                            offset);
 
       // fit quads
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                     kernelBLFastFit<4>(),
-                                                     tuples_d,
-                                                     tupleMultiplicity_d,
-                                                     hv,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     4,
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                     kernelBLFit<4>(),
-                                                     tupleMultiplicity_d,
-                                                     bField_,
-                                                     outputSoa_d,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     4,
-                                                     offset));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivQuadsPenta,
+                                            kernelBLFastFit<4>(),
+                                            tuples_d,
+                                            tupleMultiplicity_d,
+                                            hv,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            4,
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivQuadsPenta,
+                                            kernelBLFit<4>(),
+                                            tupleMultiplicity_d,
+                                            bField_,
+                                            outputSoa_d,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            4,
+                                            offset);
 
       if (fit5as4_) {
         // fit penta (only first 4)
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelBLFastFit<4>(),
-                                                       tuples_d,
-                                                       tupleMultiplicity_d,
-                                                       hv,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       5,
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelBLFit<4>(),
-                                                       tupleMultiplicity_d,
-                                                       bField_,
-                                                       outputSoa_d,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       5,
-                                                       offset));
-        alpaka::wait(queue);
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelBLFastFit<4>(),
+                                              tuples_d,
+                                              tupleMultiplicity_d,
+                                              hv,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              5,
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelBLFit<4>(),
+                                              tupleMultiplicity_d,
+                                              bField_,
+                                              outputSoa_d,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              5,
+                                              offset);
       } else {
         // fit penta (all 5)
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelBLFastFit<5>(),
-                                                       tuples_d,
-                                                       tupleMultiplicity_d,
-                                                       hv,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       5,
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelBLFit<5>(),
-                                                       tupleMultiplicity_d,
-                                                       bField_,
-                                                       outputSoa_d,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       5,
-                                                       offset));
-        alpaka::wait(queue);
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelBLFastFit<5>(),
+                                              tuples_d,
+                                              tupleMultiplicity_d,
+                                              hv,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              5,
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelBLFit<5>(),
+                                              tupleMultiplicity_d,
+                                              bField_,
+                                              outputSoa_d,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              5,
+                                              offset);
       }
 
     }  // loop on concurrent fits
@@ -4,6 +4,7 @@
 
 // #define BROKENLINE_DEBUG
 
+#include <algorithm>
 #include <cstdint>
 
 #include "AlpakaCore/alpakaKernelCommon.h"
@@ -29,9 +30,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   Tuples const *__restrict__ foundNtuplets,
                                   CAConstants::TupleMultiplicity const *__restrict__ tupleMultiplicity,
                                   HitsOnGPU const *__restrict__ hhp,
-                                  double *__restrict__ phits,
+                                  Rfit::scratch_t *__restrict__ phits,
                                   float *__restrict__ phits_ge,
-                                  double *__restrict__ pfast_fit,
+                                  Rfit::scratch_t *__restrict__ pfast_fit,
                                   uint32_t nHits,
                                   uint32_t offset) const {
       constexpr uint32_t hitsInFit = N;
@@ -65,7 +66,6 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         assert(foundNtuplets->size(tkid) == nHits);
 
         Rfit::Map3xNd<N> hits(phits + local_idx);
-        Rfit::Map4d fast_fit(pfast_fit + local_idx);
         Rfit::Map6xNf<N> hits_ge(phits_ge + local_idx);
 
 #ifdef BL_DUMP_HITS
@@ -108,14 +108,40 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           hits.col(i) << hhp->xGlobal(hit), hhp->yGlobal(hit), hhp->zGlobal(hit);
           hits_ge.col(i) << ge[0], ge[1], ge[2], ge[3], ge[4], ge[5];
         }
-        BrokenLine::BL_Fast_fit(hits, fast_fit);
+        // on the CPU backends the fast fit is done below, on the tracks loaded by this thread
+#if !defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED && !defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        Rfit::Vector4d fast_fit;
+        BrokenLine::BL_Fast_fit(hits.template cast<Rfit::fit_t>(), fast_fit);
 
         // no NaN here....
         assert(fast_fit(0) == fast_fit(0));
         assert(fast_fit(1) == fast_fit(1));
         assert(fast_fit(2) == fast_fit(2));
         assert(fast_fit(3) == fast_fit(3));
+
+        Rfit::Map4d fast_fit_s(pfast_fit + local_idx);
+        fast_fit_s = fast_fit.template cast<Rfit::scratch_t>();
+#endif
+      });
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      const auto nFits = Rfit::batched::numberOfFits(tupleMultiplicity, nHits, offset);
+      cms::alpakatools::for_each_batch_in_grid_strided<Rfit::fitLanes>(acc, nFits, [&](uint32_t first, uint32_t n) {
+        Rfit::LaneMatrix<3, N, Rfit::fitLanes> hits;
+        Rfit::batched::loadLanes(phits + first, n, hits);
+
+        Rfit::LaneMatrix<4, 1, Rfit::fitLanes> fast_fit;
+        BrokenLine::BL_Fast_fit(hits, fast_fit);
+
+        for (uint32_t k = 0; k < 4; ++k) {
+          for (uint32_t l = 0; l < n; ++l) {
+            // no NaN here....
+            assert(fast_fit(k)[l] == fast_fit(k)[l]);
+            pfast_fit[first + l + k * Rfit::stride()] = fast_fit(k)[l];
+          }
+        }
       });
+#endif
 
     }  // kernel operator()
   };   // struct
@@ -127,9 +153,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   CAConstants::TupleMultiplicity const *__restrict__ tupleMultiplicity,
                                   double B,
                                   OutputSoA *results,
-                                  double *__restrict__ phits,
+                                  Rfit::scratch_t *__restrict__ phits,
                                   float *__restrict__ phits_ge,
-                                  double *__restrict__ pfast_fit,
+                                  Rfit::scratch_t *__restrict__ pfast_fit,
                                   uint32_t nHits,
                                   uint32_t offset) const {
       assert(N <= nHits);
@@ -143,6 +169,50 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       //auto local_start = blockIdx.x * blockDim.x + threadIdx.x;
       //for (int local_idx = local_start, nt = Rfit::maxNumberOfConcurrentFits(); local_idx < nt;
       //local_idx += gridDim.x * blockDim.x) {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      const auto nFits = Rfit::batched::numberOfFits(tupleMultiplicity, nHits, offset);
+      cms::alpakatools::for_each_batch_in_grid_strided<Rfit::fitLanes>(acc, nFits, [&](uint32_t first, uint32_t n) {
+        Rfit::LaneMatrix<3, N, Rfit::fitLanes> hits;
+        Rfit::LaneMatrix<6, N, Rfit::fitLanes> hits_ge;
+        Rfit::LaneMatrix<4, 1, Rfit::fitLanes> fast_fit;
+        Rfit::batched::loadLanes(phits + first, n, hits);
+        Rfit::batched::loadLanes(phits_ge + first, n, hits_ge);
+        Rfit::batched::loadLanes(pfast_fit + first, n, fast_fit);
+
+        BrokenLine::PreparedBrokenLineData<N, Rfit::Lanes<Rfit::fitLanes>> data;
+        BrokenLine::karimaki_circle_fit_t<Rfit::Lanes<Rfit::fitLanes>> circle;
+        BrokenLine::line_fit_t<Rfit::Lanes<Rfit::fitLanes>> line;
+
+        BrokenLine::prepareBrokenLineData(hits, fast_fit, B, data);
+        BrokenLine::BL_Line_fit(hits_ge, fast_fit, B, data, line);
+        BrokenLine::BL_Circle_fit(hits, hits_ge, fast_fit, B, data, circle);
+
+        for (uint32_t l = 0; l < n; ++l) {
+          // get it for the ntuple container (one to one to helix)
+          auto tkid = *(tupleMultiplicity->begin(nHits) + first + l + offset);
+
+          Rfit::Vector3d circlePar;
+          Rfit::Matrix3d circleCov;
+          Rfit::Vector2d linePar;
+          Rfit::Matrix2d lineCov;
+          for (int i = 0; i < 3; ++i) {
+            circlePar(i) = circle.par(i)[l];
+            for (int j = 0; j < 3; ++j)
+              circleCov(i, j) = circle.cov(i, j)[l];
+          }
+          for (int i = 0; i < 2; ++i) {
+            linePar(i) = line.par(i)[l];
+            for (int j = 0; j < 2; ++j)
+              lineCov(i, j) = line.cov(i, j)[l];
+          }
+
+          results->stateAtBS.copyFromCircle(circlePar, circleCov, linePar, lineCov, 1.f / float(B), tkid);
+          results->pt(tkid) = float(B) / float(std::abs(circlePar(2)));
+          results->eta(tkid) = asinhf(linePar(0));
+          results->chi2(tkid) = (circle.chi2[l] + line.chi2[l]) / (2 * N - 5);
+        }
+      });
+#else
       const auto nt = Rfit::maxNumberOfConcurrentFits();
       cms::alpakatools::for_each_element_in_grid_strided(acc, nt, [&](uint32_t local_idx) {
         auto tuple_idx = local_idx + offset;
@@ -152,8 +222,11 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         // get it for the ntuple container (one to one to helix)
         auto tkid = *(tupleMultiplicity->begin(nHits) + tuple_idx);
 
-        Rfit::Map3xNd<N> hits(phits + local_idx);
-        Rfit::Map4d fast_fit(pfast_fit + local_idx);
+        // the fits read the scratch buffers converted to the precision of the arithmetic
+        Rfit::Map3xNd<N> hits_s(phits + local_idx);
+        Rfit::Map4d fast_fit_s(pfast_fit + local_idx);
+        auto hits = hits_s.template cast<Rfit::fit_t>();
+        auto fast_fit = fast_fit_s.template cast<Rfit::fit_t>();
         Rfit::Map6xNf<N> hits_ge(phits_ge + local_idx);
 
         BrokenLine::PreparedBrokenLineData<N> data;
@@ -192,6 +265,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                line.cov(1, 1));
 #endif
       });
+#endif
 
     }  // kernel operator()
   };   // struct
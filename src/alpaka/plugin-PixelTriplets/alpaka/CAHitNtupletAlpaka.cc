@@ -8,35 +8,53 @@
 #include "AlpakaDataFormats/TrackingRecHit2DAlpaka.h"
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
+
+#include <optional>
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class CAHitNtupletAlpaka : public edm::EDProducer {
+  class CAHitNtupletAlpaka : public edm::EDProducerExternalWork {
   public:
     explicit CAHitNtupletAlpaka(edm::ProductRegistry& reg);
     ~CAHitNtupletAlpaka() override = default;
 
   private:
+    void acquire(const edm::Event& iEvent,
+                 const edm::EventSetup& iSetup,
+                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
     edm::EDGetTokenT<TrackingRecHit2DAlpaka> tokenHitGPU_;
     edm::EDPutTokenT<PixelTrackAlpaka> tokenTrackGPU_;
 
     CAHitNtupletGeneratorOnGPU gpuAlgo_;
+
+    Queue queue_;
+    std::optional<PixelTrackAlpaka> tracks_;
   };
 
   CAHitNtupletAlpaka::CAHitNtupletAlpaka(edm::ProductRegistry& reg)
       : tokenHitGPU_{reg.consumes<TrackingRecHit2DAlpaka>()},
         tokenTrackGPU_{reg.produces<PixelTrackAlpaka>()},
-        gpuAlgo_(reg) {}
+        gpuAlgo_(reg),
+        queue_(device) {}
 
-  void CAHitNtupletAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& es) {
+  void CAHitNtupletAlpaka::acquire(const edm::Event& iEvent,
+                                   const edm::EventSetup& es,
+                                   edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
     auto bf = 0.0114256972711507;  // 1/fieldInGeV
 
     auto const& hits = iEvent.get(tokenHitGPU_);
 
-    Queue queue(device);
-    iEvent.emplace(tokenTrackGPU_, gpuAlgo_.makeTuplesAsync(hits, bf, queue));
+    tracks_.emplace(gpuAlgo_.makeTuplesAsync(hits, bf, queue_));
+
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
+  }
+
+  void CAHitNtupletAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& es) {
+    iEvent.emplace(tokenTrackGPU_, std::move(*tracks_));
+    tracks_.reset();
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
@@ -2,6 +2,7 @@
 #include "CAHitNtupletGeneratorKernelsImpl.h"
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
@@ -10,11 +11,8 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     const auto blockSize = 128;
     const auto numberOfBlocks = (HitContainer::capacity() + blockSize - 1) / blockSize;
     const WorkDiv1 fillHitDetWorkDiv = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(
-        queue,
-        alpaka::createTaskKernel<Acc1>(
-            fillHitDetWorkDiv, kernel_fillHitDetIndices(), &tracks_d->hitIndices, hv, &tracks_d->detIndices));
-    alpaka::wait(queue);
+    cms::alpakatools::enqueueKernel<Acc1>(
+        queue, fillHitDetWorkDiv, kernel_fillHitDetIndices(), &tracks_d->hitIndices, hv, &tracks_d->detIndices);
   }
 
   void CAHitNtupletGeneratorKernels::launchKernels(HitsOnCPU const &hh, TkSoA *tracks_d, Queue &queue) {
@@ -35,7 +33,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     // applying conbinatoric cleaning such as fishbone at this stage is too expensive
     //
 
-    const uint32_t nthTot = 64;
+    // the default can be replaced by a calibrated value, see AlpakaCore/workDivTuning.h
+    const auto connectTuning = cms::alpakatools::tuneWorkDiv<Acc2>("kernel_connect", nhits, 64);
+    const uint32_t nthTot = connectTuning.value;
     const uint32_t stride = 4;
     uint32_t blockSize = nthTot / stride;
     uint32_t numberOfBlocks = (3 * m_params.maxNumberOfDoublets_ / 4 + blockSize - 1) / blockSize;
@@ -47,23 +47,24 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     const Vec2 blks(numberOfBlocks, 1u);
     const Vec2 thrs(blockSize, stride);
     const WorkDiv2 kernelConnectWorkDiv = cms::alpakatools::make_workdiv(blks, thrs);
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc2>(
-                        kernelConnectWorkDiv,
-                        kernel_connect(),
-                        alpaka::getPtrNative(device_hitTuple_apc_),
-                        alpaka::getPtrNative(device_hitToTuple_apc_),  // needed only to be reset, ready for next kernel
-                        hh.view(),
-                        alpaka::getPtrNative(device_theCells_),
-                        alpaka::getPtrNative(device_nCells_),
-                        alpaka::getPtrNative(device_theCellNeighbors_),
-                        alpaka::getPtrNative(device_isOuterHitOfCell_),
-                        m_params.hardCurvCut_,
-                        m_params.ptmin_,
-                        m_params.CAThetaCutBarrel_,
-                        m_params.CAThetaCutForward_,
-                        m_params.dcaCutInnerTriplet_,
-                        m_params.dcaCutOuterTriplet_));
+    cms::alpakatools::enqueueTunedKernel<Acc2>(
+        queue,
+        connectTuning,
+        kernelConnectWorkDiv,
+        kernel_connect(),
+        alpaka::getPtrNative(device_hitTuple_apc_),
+        alpaka::getPtrNative(device_hitToTuple_apc_),  // needed only to be reset, ready for next kernel
+        hh.view(),
+        alpaka::getPtrNative(device_theCells_),
+        alpaka::getPtrNative(device_nCells_),
+        alpaka::getPtrNative(device_theCellNeighbors_),
+        alpaka::getPtrNative(device_isOuterHitOfCell_),
+        m_params.hardCurvCut_,
+        m_params.ptmin_,
+        m_params.CAThetaCutBarrel_,
+        m_params.CAThetaCutForward_,
+        m_params.dcaCutInnerTriplet_,
+        m_params.dcaCutOuterTriplet_);
 
     if (nhits > 1 && m_params.earlyFishbone_) {
       const uint32_t nthTot = 128;
@@ -74,40 +75,39 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       const Vec2 thrs(blockSize, stride);
       const WorkDiv2 fishboneWorkDiv = cms::alpakatools::make_workdiv(blks, thrs);
 
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc2>(fishboneWorkDiv,
-                                                     gpuPixelDoublets::fishbone(),
-                                                     hh.view(),
-                                                     alpaka::getPtrNative(device_theCells_),
-                                                     alpaka::getPtrNative(device_nCells_),
-                                                     alpaka::getPtrNative(device_isOuterHitOfCell_),
-                                                     nhits,
-                                                     false));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc2>(queue,
+                                            fishboneWorkDiv,
+                                            gpuPixelDoublets::fishbone(),
+                                            hh.view(),
+                                            alpaka::getPtrNative(device_theCells_),
+                                            alpaka::getPtrNative(device_nCells_),
+                                            alpaka::getPtrNative(device_isOuterHitOfCell_),
+                                            nhits,
+                                            false);
     }
 
     blockSize = 64;
     numberOfBlocks = (3 * m_params.maxNumberOfDoublets_ / 4 + blockSize - 1) / blockSize;
     WorkDiv1 workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                   kernel_find_ntuplets(),
-                                                   hh.view(),
-                                                   alpaka::getPtrNative(device_theCells_),
-                                                   alpaka::getPtrNative(device_nCells_),
-                                                   alpaka::getPtrNative(device_theCellTracks_),
-                                                   tuples_d,
-                                                   alpaka::getPtrNative(device_hitTuple_apc_),
-                                                   quality_d,
-                                                   m_params.minHitsPerNtuplet_));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_find_ntuplets(),
+                                          hh.view(),
+                                          alpaka::getPtrNative(device_theCells_),
+                                          alpaka::getPtrNative(device_nCells_),
+                                          alpaka::getPtrNative(device_theCellTracks_),
+                                          tuples_d,
+                                          alpaka::getPtrNative(device_hitTuple_apc_),
+                                          quality_d,
+                                          m_params.minHitsPerNtuplet_);
 
     if (m_params.doStats_) {
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     kernel_mark_used(),
-                                                     hh.view(),
-                                                     alpaka::getPtrNative(device_theCells_),
-                                                     alpaka::getPtrNative(device_nCells_)));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            kernel_mark_used(),
+                                            hh.view(),
+                                            alpaka::getPtrNative(device_theCells_),
+                                            alpaka::getPtrNative(device_nCells_));
     }
 
 #ifdef GPU_DEBUG
@@ -117,39 +117,39 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     blockSize = 128;
     numberOfBlocks = (HitContainer::totbins() + blockSize - 1) / blockSize;
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(
-        queue,
-        alpaka::createTaskKernel<Acc1>(
-            workDiv1D, cms::alpakatools::finalizeBulk(), alpaka::getPtrNative(device_hitTuple_apc_), tuples_d));
+    cms::alpakatools::enqueueKernel<Acc1>(
+        queue, workDiv1D, cms::alpakatools::finalizeBulk(), alpaka::getPtrNative(device_hitTuple_apc_), tuples_d);
 
     // remove duplicates (tracks that share a doublet)
     numberOfBlocks = (3 * m_params.maxNumberOfDoublets_ / 4 + blockSize - 1) / blockSize;
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                   kernel_earlyDuplicateRemover(),
-                                                   alpaka::getPtrNative(device_theCells_),
-                                                   alpaka::getPtrNative(device_nCells_),
-                                                   tuples_d,
-                                                   quality_d));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_earlyDuplicateRemover(),
+                                          alpaka::getPtrNative(device_theCells_),
+                                          alpaka::getPtrNative(device_nCells_),
+                                          tuples_d,
+                                          quality_d);
 
     blockSize = 128;
     numberOfBlocks = (3 * CAConstants::maxTuples() / 4 + blockSize - 1) / blockSize;
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                   kernel_countMultiplicity(),
-                                                   tuples_d,
-                                                   quality_d,
-                                                   alpaka::getPtrNative(device_tupleMultiplicity_)));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_countMultiplicity(),
+                                          tuples_d,
+                                          quality_d,
+                                          alpaka::getPtrNative(device_tupleMultiplicity_));
 
     cms::alpakatools::launchFinalize(alpaka::getPtrNative(device_tupleMultiplicity_), queue);
 
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(
-        queue,
-        alpaka::createTaskKernel<Acc1>(
-            workDiv1D, kernel_fillMultiplicity(), tuples_d, quality_d, alpaka::getPtrNative(device_tupleMultiplicity_)));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_fillMultiplicity(),
+                                          tuples_d,
+                                          quality_d,
+                                          alpaka::getPtrNative(device_tupleMultiplicity_));
 
     if (nhits > 1 && m_params.lateFishbone_) {
       const uint32_t nthTot = 128;
@@ -160,36 +160,34 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       const Vec2 blks(numberOfBlocks, 1u);
       const Vec2 thrs(blockSize, stride);
       const WorkDiv2 workDiv2D = cms::alpakatools::make_workdiv(blks, thrs);
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc2>(workDiv2D,
-                                                     gpuPixelDoublets::fishbone(),
-                                                     hh.view(),
-                                                     alpaka::getPtrNative(device_theCells_),
-                                                     alpaka::getPtrNative(device_nCells_),
-                                                     alpaka::getPtrNative(device_isOuterHitOfCell_),
-                                                     nhits,
-                                                     true));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc2>(queue,
+                                            workDiv2D,
+                                            gpuPixelDoublets::fishbone(),
+                                            hh.view(),
+                                            alpaka::getPtrNative(device_theCells_),
+                                            alpaka::getPtrNative(device_nCells_),
+                                            alpaka::getPtrNative(device_isOuterHitOfCell_),
+                                            nhits,
+                                            true);
     }
 
     if (m_params.doStats_) {
       numberOfBlocks = (std::max(nhits, m_params.maxNumberOfDoublets_) + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     kernel_checkOverflows(),
-                                                     tuples_d,
-                                                     alpaka::getPtrNative(device_tupleMultiplicity_),
-                                                     alpaka::getPtrNative(device_hitTuple_apc_),
-                                                     alpaka::getPtrNative(device_theCells_),
-                                                     alpaka::getPtrNative(device_nCells_),
-                                                     alpaka::getPtrNative(device_theCellNeighbors_),
-                                                     alpaka::getPtrNative(device_theCellTracks_),
-                                                     alpaka::getPtrNative(device_isOuterHitOfCell_),
-                                                     nhits,
-                                                     m_params.maxNumberOfDoublets_,
-                                                     alpaka::getPtrNative(counters_)));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            kernel_checkOverflows(),
+                                            tuples_d,
+                                            alpaka::getPtrNative(device_tupleMultiplicity_),
+                                            alpaka::getPtrNative(device_hitTuple_apc_),
+                                            alpaka::getPtrNative(device_theCells_),
+                                            alpaka::getPtrNative(device_nCells_),
+                                            alpaka::getPtrNative(device_theCellNeighbors_),
+                                            alpaka::getPtrNative(device_theCellTracks_),
+                                            alpaka::getPtrNative(device_isOuterHitOfCell_),
+                                            nhits,
+                                            m_params.maxNumberOfDoublets_,
+                                            alpaka::getPtrNative(counters_));
     }
 #ifdef GPU_DEBUG
     alpaka::wait(queue);
@@ -217,16 +215,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // at least one block!
       int blocks = (std::max(1U, nhits) + threadsPerBlock - 1) / threadsPerBlock;
       const WorkDiv1 workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(blocks), Vec1::all(threadsPerBlock));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     gpuPixelDoublets::initDoublets(),
-                                                     alpaka::getPtrNative(device_isOuterHitOfCell_),
-                                                     nhits,
-                                                     alpaka::getPtrNative(device_theCellNeighbors_),
-                                                     alpaka::getPtrNative(device_theCellNeighborsContainer_),
-                                                     alpaka::getPtrNative(device_theCellTracks_),
-                                                     alpaka::getPtrNative(device_theCellTracksContainer_)));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            gpuPixelDoublets::initDoublets(),
+                                            alpaka::getPtrNative(device_isOuterHitOfCell_),
+                                            nhits,
+                                            alpaka::getPtrNative(device_theCellNeighbors_),
+                                            alpaka::getPtrNative(device_theCellNeighborsContainer_),
+                                            alpaka::getPtrNative(device_theCellTracks_),
+                                            alpaka::getPtrNative(device_theCellTracksContainer_));
     }
 
 #ifdef GPU_DEBUG
@@ -251,22 +248,21 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     const Vec2 blks(blocks, 1u);
     const Vec2 thrs(threadsPerBlock, stride);
     const WorkDiv2 workDiv2D = cms::alpakatools::make_workdiv(blks, thrs);
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc2>(workDiv2D,
-                                                   gpuPixelDoublets::getDoubletsFromHisto(),
-                                                   alpaka::getPtrNative(device_theCells_),
-                                                   alpaka::getPtrNative(device_nCells_),
-                                                   alpaka::getPtrNative(device_theCellNeighbors_),
-                                                   alpaka::getPtrNative(device_theCellTracks_),
-                                                   hh.view(),
-                                                   alpaka::getPtrNative(device_isOuterHitOfCell_),
-                                                   nActualPairs,
-                                                   m_params.idealConditions_,
-                                                   m_params.doClusterCut_,
-                                                   m_params.doZ0Cut_,
-                                                   m_params.doPtCut_,
-                                                   m_params.maxNumberOfDoublets_));
-    alpaka::wait(queue);
+    cms::alpakatools::enqueueKernel<Acc2>(queue,
+                                          workDiv2D,
+                                          gpuPixelDoublets::getDoubletsFromHisto(),
+                                          alpaka::getPtrNative(device_theCells_),
+                                          alpaka::getPtrNative(device_nCells_),
+                                          alpaka::getPtrNative(device_theCellNeighbors_),
+                                          alpaka::getPtrNative(device_theCellTracks_),
+                                          hh.view(),
+                                          alpaka::getPtrNative(device_isOuterHitOfCell_),
+                                          nActualPairs,
+                                          m_params.idealConditions_,
+                                          m_params.doClusterCut_,
+                                          m_params.doZ0Cut_,
+                                          m_params.doPtCut_,
+                                          m_params.maxNumberOfDoublets_);
 
 #ifdef GPU_DEBUG
     alpaka::wait(queue);
@@ -283,83 +279,73 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     // classify tracks based on kinematics
     auto numberOfBlocks = (3 * CAConstants::maxNumberOfQuadruplets() / 4 + blockSize - 1) / blockSize;
     WorkDiv1 workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(
-                        workDiv1D, kernel_classifyTracks(), tuples_d, tracks_d, m_params.cuts_, quality_d));
+    cms::alpakatools::enqueueKernel<Acc1>(
+        queue, workDiv1D, kernel_classifyTracks(), tuples_d, tracks_d, m_params.cuts_, quality_d);
 
     if (m_params.lateFishbone_) {
       // apply fishbone cleaning to good tracks
       numberOfBlocks = (3 * m_params.maxNumberOfDoublets_ / 4 + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     kernel_fishboneCleaner(),
-                                                     alpaka::getPtrNative(device_theCells_),
-                                                     alpaka::getPtrNative(device_nCells_),
-                                                     quality_d));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            kernel_fishboneCleaner(),
+                                            alpaka::getPtrNative(device_theCells_),
+                                            alpaka::getPtrNative(device_nCells_),
+                                            quality_d);
     }
 
     // remove duplicates (tracks that share a doublet)
     numberOfBlocks = (3 * m_params.maxNumberOfDoublets_ / 4 + blockSize - 1) / blockSize;
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                   kernel_fastDuplicateRemover(),
-                                                   alpaka::getPtrNative(device_theCells_),
-                                                   alpaka::getPtrNative(device_nCells_),
-                                                   tuples_d,
-                                                   tracks_d));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_fastDuplicateRemover(),
+                                          alpaka::getPtrNative(device_theCells_),
+                                          alpaka::getPtrNative(device_nCells_),
+                                          tuples_d,
+                                          tracks_d);
 
     if (m_params.minHitsPerNtuplet_ < 4 || m_params.doStats_) {
       // fill hit->track "map"
       numberOfBlocks = (3 * CAConstants::maxNumberOfQuadruplets() / 4 + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(
-          queue,
-          alpaka::createTaskKernel<Acc1>(
-              workDiv1D, kernel_countHitInTracks(), tuples_d, quality_d, alpaka::getPtrNative(device_hitToTuple_)));
+      cms::alpakatools::enqueueKernel<Acc1>(
+          queue, workDiv1D, kernel_countHitInTracks(), tuples_d, quality_d, alpaka::getPtrNative(device_hitToTuple_));
 
       cms::alpakatools::launchFinalize(alpaka::getPtrNative(device_hitToTuple_), queue);
 
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(
-          queue,
-          alpaka::createTaskKernel<Acc1>(
-              workDiv1D, kernel_fillHitInTracks(), tuples_d, quality_d, alpaka::getPtrNative(device_hitToTuple_)));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(
+          queue, workDiv1D, kernel_fillHitInTracks(), tuples_d, quality_d, alpaka::getPtrNative(device_hitToTuple_));
     }
     if (m_params.minHitsPerNtuplet_ < 4) {
       // remove duplicates (tracks that share a hit)
       numberOfBlocks = (HitToTuple::capacity() + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     kernel_tripletCleaner(),
-                                                     hh.view(),
-                                                     tuples_d,
-                                                     tracks_d,
-                                                     quality_d,
-                                                     alpaka::getPtrNative(device_hitToTuple_)));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            kernel_tripletCleaner(),
+                                            hh.view(),
+                                            tuples_d,
+                                            tracks_d,
+                                            quality_d,
+                                            alpaka::getPtrNative(device_hitToTuple_));
     }
 
     if (m_params.doStats_) {
       // counters (add flag???)
       numberOfBlocks = (HitToTuple::capacity() + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                     kernel_doStatsForHitInTracks(),
-                                                     alpaka::getPtrNative(device_hitToTuple_),
-                                                     alpaka::getPtrNative(counters_)));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDiv1D,
+                                            kernel_doStatsForHitInTracks(),
+                                            alpaka::getPtrNative(device_hitToTuple_),
+                                            alpaka::getPtrNative(counters_));
 
       numberOfBlocks = (3 * CAConstants::maxNumberOfQuadruplets() / 4 + blockSize - 1) / blockSize;
       workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(
-                          workDiv1D, kernel_doStatsForTracks(), tuples_d, quality_d, alpaka::getPtrNative(counters_)));
-      alpaka::wait(queue);
+      cms::alpakatools::enqueueKernel<Acc1>(
+          queue, workDiv1D, kernel_doStatsForTracks(), tuples_d, quality_d, alpaka::getPtrNative(counters_));
     }
 #ifdef GPU_DEBUG
     alpaka::wait(queue);
@@ -369,24 +355,22 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     static std::atomic<int> iev(0);
     ++iev;
     workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(1u), Vec1::all(32u));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D,
-                                                   kernel_print_found_ntuplets(),
-                                                   hh.view(),
-                                                   tuples_d,
-                                                   tracks_d,
-                                                   quality_d,
-                                                   alpaka::getPtrNative(device_hitToTuple_),
-                                                   100,
-                                                   iev));
+    cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                          workDiv1D,
+                                          kernel_print_found_ntuplets(),
+                                          hh.view(),
+                                          tuples_d,
+                                          tracks_d,
+                                          quality_d,
+                                          alpaka::getPtrNative(device_hitToTuple_),
+                                          100,
+                                          iev);
 #endif
   }
 
   void CAHitNtupletGeneratorKernels::printCounters(Queue &queue) {
     const WorkDiv1 workDiv1D = cms::alpakatools::make_workdiv(Vec1::all(1u), Vec1::all(1u));
-    alpaka::enqueue(queue,
-                    alpaka::createTaskKernel<Acc1>(workDiv1D, kernel_printCounters(), alpaka::getPtrNative(counters_)));
-    alpaka::wait(queue);
+    cms::alpakatools::enqueueKernel<Acc1>(queue, workDiv1D, kernel_printCounters(), alpaka::getPtrNative(counters_));
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
@@ -155,47 +155,42 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     using TkSoA = pixelTrack::TrackSoA;
     using HitContainer = pixelTrack::HitContainer;
 
-    CAHitNtupletGeneratorKernels(Params const& params, uint32_t nhits)
+    CAHitNtupletGeneratorKernels(Params const& params, uint32_t nhits, Queue& queue)
         : m_params(params),
           //////////////////////////////////////////////////////////
           // ALLOCATIONS FOR THE INTERMEDIATE RESULTS (STAYS ON WORKER)
           //////////////////////////////////////////////////////////
-          counters_{cms::alpakatools::allocDeviceBuf<Counters>(1u)},
+          counters_{allocDeviceBuf<Counters>(1u, queue)},
 
-          device_hitToTuple_{cms::alpakatools::allocDeviceBuf<HitToTuple>(1u)},
-          device_tupleMultiplicity_{cms::alpakatools::allocDeviceBuf<TupleMultiplicity>(1u)},
+          device_hitToTuple_{allocDeviceBuf<HitToTuple>(1u, queue)},
+          device_tupleMultiplicity_{allocDeviceBuf<TupleMultiplicity>(1u, queue)},
 
-          device_theCells_{cms::alpakatools::allocDeviceBuf<GPUCACell>(params.maxNumberOfDoublets_)},
+          device_theCells_{allocDeviceBuf<GPUCACell>(params.maxNumberOfDoublets_, queue)},
           // in principle we can use "nhits" to heuristically dimension the workspace...
-          device_isOuterHitOfCell_{cms::alpakatools::allocDeviceBuf<GPUCACell::OuterHitOfCell>(std::max(1U, nhits))},
+          device_isOuterHitOfCell_{allocDeviceBuf<GPUCACell::OuterHitOfCell>(std::max(1U, nhits), queue)},
 
-          device_theCellNeighbors_{cms::alpakatools::allocDeviceBuf<CAConstants::CellNeighborsVector>(1u)},
-          device_theCellTracks_{cms::alpakatools::allocDeviceBuf<CAConstants::CellTracksVector>(1u)},
+          device_theCellNeighbors_{allocDeviceBuf<CAConstants::CellNeighborsVector>(1u, queue)},
+          device_theCellTracks_{allocDeviceBuf<CAConstants::CellTracksVector>(1u, queue)},
 
-          //cellStorage_{cms::alpakatools::allocDeviceBuf<unsigned char>(CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellNeighbors) + CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellTracks))},
+          //cellStorage_{allocDeviceBuf<unsigned char>(CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellNeighbors) + CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellTracks))},
           device_theCellNeighborsContainer_{
-              cms::alpakatools::allocDeviceBuf<CAConstants::CellNeighbors>(CAConstants::maxNumOfActiveDoublets())},
+              allocDeviceBuf<CAConstants::CellNeighbors>(CAConstants::maxNumOfActiveDoublets(), queue)},
           device_theCellTracksContainer_{
-              cms::alpakatools::allocDeviceBuf<CAConstants::CellTracks>(CAConstants::maxNumOfActiveDoublets())},
+              allocDeviceBuf<CAConstants::CellTracks>(CAConstants::maxNumOfActiveDoublets(), queue)},
 
-          //device_storage_{cms::alpakatools::allocDeviceBuf<cms::cuda::AtomicPairCounter::c_type>(3u)},
+          //device_storage_{allocDeviceBuf<cms::cuda::AtomicPairCounter::c_type>(3u)},
           //device_hitTuple_apc_ = (cms::cuda::AtomicPairCounter*)device_storage_.get()},
           //device_hitToTuple_apc_ = (cms::cuda::AtomicPairCounter*)device_storage_.get() + 1;
           //device_nCells_ = (uint32_t*)(device_storage_.get() + 2)},
-          device_hitTuple_apc_{cms::alpakatools::allocDeviceBuf<cms::alpakatools::AtomicPairCounter>(1u)},
-          device_hitToTuple_apc_{cms::alpakatools::allocDeviceBuf<cms::alpakatools::AtomicPairCounter>(1u)},
-          device_nCells_{cms::alpakatools::allocDeviceBuf<uint32_t>(1u)} {
-      Queue queue(device);
-
+          device_hitTuple_apc_{allocDeviceBuf<cms::alpakatools::AtomicPairCounter>(1u, queue)},
+          device_hitToTuple_apc_{allocDeviceBuf<cms::alpakatools::AtomicPairCounter>(1u, queue)},
+          device_nCells_{allocDeviceBuf<uint32_t>(1u, queue)} {
       alpaka::memset(queue, counters_, 0, 1u);
 
       alpaka::memset(queue, device_nCells_, 0, 1u);
 
       launchZero(alpaka::getPtrNative(device_tupleMultiplicity_), queue);
       launchZero(alpaka::getPtrNative(device_hitToTuple_), queue);
-
-      // we may wish to keep it in the edm...
-      alpaka::wait(queue);
     }
 
     ~CAHitNtupletGeneratorKernels() = default;
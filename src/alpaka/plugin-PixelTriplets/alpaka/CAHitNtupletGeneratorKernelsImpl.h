@@ -358,6 +358,23 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   HitContainer const *__restrict__ foundNtuplets,
                                   Quality const *__restrict__ quality,
                                   CAConstants::TupleMultiplicity *tupleMultiplicity) const {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      // on the CPU backends each block is run by a single thread: count the tuples of the block in a partial
+      // histogram of its own, and merge it with one atomic operation per bin instead of one per tuple
+      CAConstants::TupleMultiplicity::CountersOnly local;
+      local.zero();
+      cms::alpakatools::for_each_element_in_grid_strided(acc, foundNtuplets->nbins(), [&](uint32_t it) {
+        auto nhits = foundNtuplets->size(it);
+        if (nhits >= 3 && quality[it] != trackQuality::dup) {
+          assert(quality[it] == trackQuality::bad);
+          if (nhits > 5)
+            printf("wrong mult %d %d\n", it, nhits);
+          assert(nhits < 8);
+          local.countDirectLocal(nhits);
+        }
+      });
+      tupleMultiplicity->add(acc, local);
+#else
       cms::alpakatools::for_each_element_in_grid_strided(acc, foundNtuplets->nbins(), [&](uint32_t it) {
         auto nhits = foundNtuplets->size(it);
         if (nhits >= 3 && quality[it] != trackQuality::dup) {
@@ -368,6 +385,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           tupleMultiplicity->countDirect(acc, nhits);
         }
       });
+#endif
     }
   };
 
@@ -377,6 +395,24 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   HitContainer const *__restrict__ foundNtuplets,
                                   Quality const *__restrict__ quality,
                                   CAConstants::TupleMultiplicity *tupleMultiplicity) const {
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      // count again the tuples of the block, reserve their slots in one atomic operation per bin, and fill them
+      CAConstants::TupleMultiplicity::CountersOnly local;
+      local.zero();
+      cms::alpakatools::for_each_element_in_grid_strided(acc, foundNtuplets->nbins(), [&](uint32_t it) {
+        auto nhits = foundNtuplets->size(it);
+        if (nhits >= 3 && quality[it] != trackQuality::dup) {
+          local.countDirectLocal(nhits);
+        }
+      });
+      tupleMultiplicity->reserve(acc, local);
+      cms::alpakatools::for_each_element_in_grid_strided(acc, foundNtuplets->nbins(), [&](uint32_t it) {
+        auto nhits = foundNtuplets->size(it);
+        if (nhits >= 3 && quality[it] != trackQuality::dup) {
+          tupleMultiplicity->fillDirectReserved(local, nhits, it);
+        }
+      });
+#else
       cms::alpakatools::for_each_element_in_grid_strided(acc, foundNtuplets->nbins(), [&](uint32_t it) {
         auto nhits = foundNtuplets->size(it);
         if (nhits >= 3 && quality[it] != trackQuality::dup) {
@@ -387,6 +423,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           tupleMultiplicity->fillDirect(acc, nhits, it);
         }
       });
+#endif
     }
   };
 
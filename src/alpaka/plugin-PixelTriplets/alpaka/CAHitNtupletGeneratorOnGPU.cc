@@ -91,10 +91,10 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   PixelTrackAlpaka CAHitNtupletGeneratorOnGPU::makeTuplesAsync(TrackingRecHit2DAlpaka const& hits_d,
                                                                float bfield,
                                                                Queue& queue) const {
-    PixelTrackAlpaka tracks{cms::alpakatools::allocDeviceBuf<pixelTrack::TrackSoA>(1u)};
+    PixelTrackAlpaka tracks{allocDeviceBuf<pixelTrack::TrackSoA>(1u)};
     auto* soa = alpaka::getPtrNative(tracks);
 
-    CAHitNtupletGeneratorKernels kernels(m_params, hits_d.nHits());
+    CAHitNtupletGeneratorKernels kernels(m_params, hits_d.nHits(), queue);
     kernels.buildDoublets(hits_d, queue);
     kernels.launchKernels(hits_d, soa, queue);
     kernels.fillHitDetIndices(hits_d.view(), soa, queue);  // in principle needed only if Hits not "available"
@@ -112,7 +112,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       kernels.printCounters(queue);
     }
 
-    alpaka::wait(queue);
+    // the workspaces of kernels and fitter are allocated on the queue, and are released when the queue is done
     return tracks;
   }
 
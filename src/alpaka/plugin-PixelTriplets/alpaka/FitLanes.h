@@ -0,0 +1,268 @@
+#ifndef RecoPixelVertexing_PixelTrackFitting_interface_FitLanes_h
+#define RecoPixelVertexing_PixelTrackFitting_interface_FitLanes_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+#include "AlpakaCore/alpakaConfig.h"
+
+#include "FitResult.h"
+
+namespace ALPAKA_ACCELERATOR_NAMESPACE {
+
+  namespace Rfit {
+
+    /*!
+    \brief L values of the same quantity for L independent fits.
+
+    Each operation is a loop over the lanes, that the compiler turns into SIMD instructions:
+    a fit written for a generic scalar type, instantiated with Lanes, processes L tracks at once with the same
+    arithmetic as the per-track fit.
+    The operations must be inlined, otherwise every temporary goes through memory.
+  */
+    //! L fit_t in a GCC vector, so that the operations on Lanes look as cheap to the inliner as those on fit_t
+    template <int L>
+    struct LaneVector;
+    template <>
+    struct LaneVector<2> {
+      typedef fit_t type __attribute__((vector_size(2 * sizeof(fit_t))));
+    };
+    template <>
+    struct LaneVector<4> {
+      typedef fit_t type __attribute__((vector_size(4 * sizeof(fit_t))));
+    };
+    template <>
+    struct LaneVector<8> {
+      typedef fit_t type __attribute__((vector_size(8 * sizeof(fit_t))));
+    };
+
+    template <int L>
+    struct Lanes;
+
+    //! the result of a comparison of Lanes, lane by lane
+    template <int L>
+    struct LaneMask {
+      using vector_t = typename LaneVector<L>::type;
+      using mask_t = decltype(vector_t{} < vector_t{});
+      mask_t m;
+    };
+
+    template <int L>
+    struct Lanes {
+      using vector_t = typename LaneVector<L>::type;
+      vector_t v;
+
+      Lanes() = default;
+      ALPAKA_FN_INLINE constexpr Lanes(fit_t x) : v(vector_t{} + x) {}
+
+      ALPAKA_FN_INLINE constexpr fit_t& operator[](int l) { return v[l]; }
+      ALPAKA_FN_INLINE constexpr fit_t operator[](int l) const { return v[l]; }
+
+      ALPAKA_FN_INLINE constexpr Lanes& operator+=(Lanes const& o) {
+        v += o.v;
+        return *this;
+      }
+      ALPAKA_FN_INLINE constexpr Lanes& operator-=(Lanes const& o) {
+        v -= o.v;
+        return *this;
+      }
+      ALPAKA_FN_INLINE constexpr Lanes& operator*=(Lanes const& o) {
+        v *= o.v;
+        return *this;
+      }
+      ALPAKA_FN_INLINE constexpr Lanes& operator/=(Lanes const& o) {
+        v /= o.v;
+        return *this;
+      }
+
+      friend ALPAKA_FN_INLINE constexpr Lanes operator+(Lanes a, Lanes const& b) { return a += b; }
+      friend ALPAKA_FN_INLINE constexpr Lanes operator-(Lanes a, Lanes const& b) { return a -= b; }
+      friend ALPAKA_FN_INLINE constexpr Lanes operator*(Lanes a, Lanes const& b) { return a *= b; }
+      friend ALPAKA_FN_INLINE constexpr Lanes operator/(Lanes a, Lanes const& b) { return a /= b; }
+      friend ALPAKA_FN_INLINE constexpr Lanes operator-(Lanes a) {
+        a.v = -a.v;
+        return a;
+      }
+
+      friend ALPAKA_FN_INLINE constexpr LaneMask<L> operator<(Lanes const& a, Lanes const& b) { return {a.v < b.v}; }
+      friend ALPAKA_FN_INLINE constexpr LaneMask<L> operator>(Lanes const& a, Lanes const& b) { return {a.v > b.v}; }
+
+      // found only by argument dependent lookup, so that they do not hide the std functions for the scalar fits
+      friend ALPAKA_FN_INLINE Lanes sqrt(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::sqrt(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes abs(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::abs(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes log(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::log(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes cos(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::cos(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes sin(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::sin(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes atan(Lanes a) {
+        for (int l = 0; l < L; ++l)
+          a.v[l] = std::atan(a.v[l]);
+        return a;
+      }
+      friend ALPAKA_FN_INLINE Lanes atan2(Lanes const& y, Lanes const& x) {
+        Lanes r;
+        for (int l = 0; l < L; ++l)
+          r.v[l] = std::atan2(y.v[l], x.v[l]);
+        return r;
+      }
+      friend ALPAKA_FN_INLINE Lanes min(fit_t a, Lanes b) {
+        for (int l = 0; l < L; ++l)
+          b.v[l] = std::min(a, b.v[l]);
+        return b;
+      }
+    };
+
+    //! L independent R x C matrices, stored element by element; Eigen treats Lanes as its scalar type (see below)
+    template <int R, int C, int L>
+    using LaneMatrix = Eigen::Matrix<Lanes<L>, R, C>;
+
+    /*!
+    \brief Types of the results of the fits written for one track (T = fit_t) or for several tracks in SIMD lanes
+    (T = Lanes<L>), so that the same code serves both.
+    The charge is an int for one track, and a value per lane otherwise.
+  */
+    template <typename T>
+    struct LaneTraits {
+      static constexpr int lanes = 1;
+      using charge_t = int32_t;
+      using circle_fit = Rfit::circle_fit;
+      using line_fit = Rfit::line_fit;
+    };
+
+    template <int L>
+    struct LaneTraits<Lanes<L>> {
+      static constexpr int lanes = L;
+      using charge_t = Lanes<L>;
+      struct circle_fit {
+        LaneMatrix<3, 1, L> par;
+        LaneMatrix<3, 3, L> cov;
+        Lanes<L> q;
+        Lanes<L> chi2;
+      };
+      struct line_fit {
+        LaneMatrix<2, 1, L> par;
+        LaneMatrix<2, 2, L> cov;
+        Lanes<L> chi2;
+      };
+    };
+
+    //! the value of lane l
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE fit_t lane(fit_t x, int) { return x; }
+    template <int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE fit_t lane(Lanes<L> const& x, int l) {
+      return x[l];
+    }
+
+    //! the values of lane l
+    template <int R, int C, int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE Eigen::Matrix<fit_t, R, C> lane(LaneMatrix<R, C, L> const& m, int l) {
+      Eigen::Matrix<fit_t, R, C> x;
+      for (int j = 0; j < C; ++j)
+        for (int i = 0; i < R; ++i)
+          x(i, j) = m(i, j)[l];
+      return x;
+    }
+
+    //! sets lane l to the values of x
+    template <int R, int C, int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void setLane(LaneMatrix<R, C, L>& m,
+                                                     int l,
+                                                     Eigen::Matrix<fit_t, R, C> const& x) {
+      for (int j = 0; j < C; ++j)
+        for (int i = 0; i < R; ++i)
+          m(i, j)[l] = x(i, j);
+    }
+
+    //! a where c holds, b elsewhere: the branches of the per-track fits are taken lane by lane
+    template <typename A, typename B>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE auto select(bool c, A const& a, B const& b) {
+      return c ? a : b;
+    }
+    template <int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE Lanes<L> select(LaneMask<L> const& c, Lanes<L> a, Lanes<L> const& b) {
+      a.v = c.m ? a.v : b.v;
+      return a;
+    }
+
+    //! the charge from the sign of the cross product of the first and last segments of a track
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE int32_t chargeFromCross(fit_t cross) { return cross > 0 ? -1 : 1; }
+    template <int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE Lanes<L> chargeFromCross(Lanes<L> cross) {
+      for (int l = 0; l < L; ++l)
+        cross[l] = cross[l] > 0 ? -1 : 1;
+      return cross;
+    }
+
+    //! q / 2 with the integer division of the per-track fits
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE int32_t halfCharge(int32_t q) { return q / 2; }
+    template <int L>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE Lanes<L> halfCharge(Lanes<L> q) {
+      for (int l = 0; l < L; ++l)
+        q[l] = int32_t(q[l]) / 2;
+      return q;
+    }
+
+  }  // namespace Rfit
+
+}  // namespace ALPAKA_ACCELERATOR_NAMESPACE
+
+namespace Eigen {
+
+  // Lanes as the scalar type of Eigen matrices, combined with fit_t constants as the per-track fits do
+  template <int L>
+  struct NumTraits<ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>>
+      : NumTraits<ALPAKA_ACCELERATOR_NAMESPACE::Rfit::fit_t> {
+    using Real = ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>;
+    using NonInteger = Real;
+    using Literal = Real;
+    using Nested = Real;
+    enum {
+      IsComplex = 0,
+      IsInteger = 0,
+      IsSigned = 1,
+      RequireInitialization = 0,
+      ReadCost = 1,
+      AddCost = 1,
+      MulCost = 1
+    };
+  };
+
+  template <int L, typename BinaryOp>
+  struct ScalarBinaryOpTraits<ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>,
+                              ALPAKA_ACCELERATOR_NAMESPACE::Rfit::fit_t,
+                              BinaryOp> {
+    using ReturnType = ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>;
+  };
+
+  template <int L, typename BinaryOp>
+  struct ScalarBinaryOpTraits<ALPAKA_ACCELERATOR_NAMESPACE::Rfit::fit_t,
+                              ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>,
+                              BinaryOp> {
+    using ReturnType = ALPAKA_ACCELERATOR_NAMESPACE::Rfit::Lanes<L>;
+  };
+
+}  // namespace Eigen
+
+#endif  // RecoPixelVertexing_PixelTrackFitting_interface_FitLanes_h
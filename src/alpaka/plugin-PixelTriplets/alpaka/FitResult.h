@@ -10,18 +10,37 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
   namespace Rfit {
 
-    using Vector2d = Eigen::Vector2d;
-    using Vector3d = Eigen::Vector3d;
-    using Vector4d = Eigen::Vector4d;
-    using Vector5d = Eigen::Matrix<double, 5, 1>;
-    using Matrix2d = Eigen::Matrix2d;
-    using Matrix3d = Eigen::Matrix3d;
-    using Matrix4d = Eigen::Matrix4d;
-    using Matrix5d = Eigen::Matrix<double, 5, 5>;
-    using Matrix6d = Eigen::Matrix<double, 6, 6>;
+    /*!
+    Precision policy of the helix fits, chosen at compile time:
+    - fit_t is the type of the fit arithmetic and of the Rfit matrices below (the "d" in their names is historical);
+    - scratch_t is the type of the hits and fast fit buffers handed from one fit kernel to the next.
+    The default is double for both; -DRFIT_PRECISION_MIXED stores the scratch buffers as float and keeps the
+    arithmetic in double, -DRFIT_PRECISION_FLOAT uses float for both.
+    The hit errors are always stored as float, and the results as float in the track SoA.
+  */
+#if defined RFIT_PRECISION_FLOAT
+    using fit_t = float;
+    using scratch_t = float;
+#elif defined RFIT_PRECISION_MIXED
+    using fit_t = double;
+    using scratch_t = float;
+#else
+    using fit_t = double;
+    using scratch_t = double;
+#endif
+
+    using Vector2d = Eigen::Matrix<fit_t, 2, 1>;
+    using Vector3d = Eigen::Matrix<fit_t, 3, 1>;
+    using Vector4d = Eigen::Matrix<fit_t, 4, 1>;
+    using Vector5d = Eigen::Matrix<fit_t, 5, 1>;
+    using Matrix2d = Eigen::Matrix<fit_t, 2, 2>;
+    using Matrix3d = Eigen::Matrix<fit_t, 3, 3>;
+    using Matrix4d = Eigen::Matrix<fit_t, 4, 4>;
+    using Matrix5d = Eigen::Matrix<fit_t, 5, 5>;
+    using Matrix6d = Eigen::Matrix<fit_t, 6, 6>;
 
     template <int N>
-    using Matrix3xNd = Eigen::Matrix<double, 3, N>;  // used for inputs hits
+    using Matrix3xNd = Eigen::Matrix<fit_t, 3, N>;  // used for inputs hits
 
     struct circle_fit {
       Vector3d par;  //!< parameter: (X0,Y0,R)
@@ -42,7 +61,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       |cov(c_t,c_t)|cov(Zip,c_t)| \n
       |cov(c_t,Zip)|cov(Zip,Zip)|
     */
-      double chi2;
+      fit_t chi2;
     };
 
     struct helix_fit {
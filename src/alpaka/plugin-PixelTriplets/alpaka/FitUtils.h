@@ -8,47 +8,47 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
   namespace Rfit {
 
-    constexpr double d = 1.e-4;  //!< used in numerical derivative (J2 in Circle_fit())
+    constexpr fit_t d = 1.e-4;  //!< used in numerical derivative (J2 in Circle_fit())
 
-    using VectorXd = Eigen::VectorXd;
-    using MatrixXd = Eigen::MatrixXd;
+    using VectorXd = Eigen::Matrix<fit_t, Eigen::Dynamic, 1>;
+    using MatrixXd = Eigen::Matrix<fit_t, Eigen::Dynamic, Eigen::Dynamic>;
     template <int N>
-    using MatrixNd = Eigen::Matrix<double, N, N>;
+    using MatrixNd = Eigen::Matrix<fit_t, N, N>;
     template <int N>
-    using MatrixNplusONEd = Eigen::Matrix<double, N + 1, N + 1>;
+    using MatrixNplusONEd = Eigen::Matrix<fit_t, N + 1, N + 1>;
     template <int N>
-    using ArrayNd = Eigen::Array<double, N, N>;
+    using ArrayNd = Eigen::Array<fit_t, N, N>;
     template <int N>
-    using Matrix2Nd = Eigen::Matrix<double, 2 * N, 2 * N>;
+    using Matrix2Nd = Eigen::Matrix<fit_t, 2 * N, 2 * N>;
     template <int N>
-    using Matrix3Nd = Eigen::Matrix<double, 3 * N, 3 * N>;
+    using Matrix3Nd = Eigen::Matrix<fit_t, 3 * N, 3 * N>;
     template <int N>
-    using Matrix2xNd = Eigen::Matrix<double, 2, N>;
+    using Matrix2xNd = Eigen::Matrix<fit_t, 2, N>;
     template <int N>
-    using Array2xNd = Eigen::Array<double, 2, N>;
+    using Array2xNd = Eigen::Array<fit_t, 2, N>;
     template <int N>
-    using MatrixNx3d = Eigen::Matrix<double, N, 3>;
+    using MatrixNx3d = Eigen::Matrix<fit_t, N, 3>;
     template <int N>
-    using MatrixNx5d = Eigen::Matrix<double, N, 5>;
+    using MatrixNx5d = Eigen::Matrix<fit_t, N, 5>;
     template <int N>
-    using VectorNd = Eigen::Matrix<double, N, 1>;
+    using VectorNd = Eigen::Matrix<fit_t, N, 1>;
     template <int N>
-    using VectorNplusONEd = Eigen::Matrix<double, N + 1, 1>;
+    using VectorNplusONEd = Eigen::Matrix<fit_t, N + 1, 1>;
     template <int N>
-    using Vector2Nd = Eigen::Matrix<double, 2 * N, 1>;
+    using Vector2Nd = Eigen::Matrix<fit_t, 2 * N, 1>;
     template <int N>
-    using Vector3Nd = Eigen::Matrix<double, 3 * N, 1>;
+    using Vector3Nd = Eigen::Matrix<fit_t, 3 * N, 1>;
     template <int N>
-    using RowVectorNd = Eigen::Matrix<double, 1, 1, N>;
+    using RowVectorNd = Eigen::Matrix<fit_t, 1, 1, N>;
     template <int N>
-    using RowVector2Nd = Eigen::Matrix<double, 1, 2 * N>;
+    using RowVector2Nd = Eigen::Matrix<fit_t, 1, 2 * N>;
 
-    using Matrix2x3d = Eigen::Matrix<double, 2, 3>;
+    using Matrix2x3d = Eigen::Matrix<fit_t, 2, 3>;
 
     using Matrix3f = Eigen::Matrix3f;
     using Vector3f = Eigen::Vector3f;
     using Vector4f = Eigen::Vector4f;
-    using Vector6f = Eigen::Matrix<double, 6, 1>;
+    using Vector6f = Eigen::Matrix<fit_t, 6, 1>;
 
     using u_int = unsigned int;
 
@@ -79,7 +79,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \return z component of the cross product.
   */
 
-    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE double cross2D(const Vector2d& a, const Vector2d& b) {
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE fit_t cross2D(const Vector2d& a, const Vector2d& b) {
+      return a.x() * b.y() - a.y() * b.x();
+    }
+
+    //! the same for the vectors of the fits of several tracks at once (see FitLanes.h)
+    template <typename T>
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE T cross2D(const Eigen::Matrix<T, 2, 1>& a, const Eigen::Matrix<T, 2, 1>& b) {
       return a.x() * b.y() - a.y() * b.x();
     }
 
@@ -173,15 +179,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \param B magnetic field in Gev/cm/c unit.
     \param error flag for errors computation.
   */
-    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void par_uvrtopak(circle_fit& circle, const double B, const bool error) {
+    ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void par_uvrtopak(circle_fit& circle, const fit_t B, const bool error) {
       Vector3d par_pak;
-      const double temp0 = circle.par.head(2).squaredNorm();
-      const double temp1 = sqrt(temp0);
+      const fit_t temp0 = circle.par.head(2).squaredNorm();
+      const fit_t temp1 = sqrt(temp0);
       par_pak << atan2(circle.q * circle.par(0), -circle.q * circle.par(1)), circle.q * (temp1 - circle.par(2)),
           circle.par(2) * B;
       if (error) {
-        const double temp2 = sqr(circle.par(0)) * 1. / temp0;
-        const double temp3 = 1. / temp1 * circle.q;
+        const fit_t temp2 = sqr(circle.par(0)) * 1. / temp0;
+        const fit_t temp3 = 1. / temp1 * circle.q;
         Matrix3d J4;
         J4 << -circle.par(1) * temp2 * 1. / sqr(circle.par(0)), temp2 * 1. / circle.par(0), 0., circle.par(0) * temp3,
             circle.par(1) * temp3, -circle.q, 0., 0., B;
@@ -198,13 +204,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   */
     ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void fromCircleToPerigee(circle_fit& circle) {
       Vector3d par_pak;
-      const double temp0 = circle.par.head(2).squaredNorm();
-      const double temp1 = sqrt(temp0);
+      const fit_t temp0 = circle.par.head(2).squaredNorm();
+      const fit_t temp1 = sqrt(temp0);
       par_pak << atan2(circle.q * circle.par(0), -circle.q * circle.par(1)), circle.q * (temp1 - circle.par(2)),
           circle.q / circle.par(2);
 
-      const double temp2 = sqr(circle.par(0)) * 1. / temp0;
-      const double temp3 = 1. / temp1 * circle.q;
+      const fit_t temp2 = sqr(circle.par(0)) * 1. / temp0;
+      const fit_t temp3 = 1. / temp1 * circle.q;
       Matrix3d J4;
       J4 << -circle.par(1) * temp2 * 1. / sqr(circle.par(0)), temp2 * 1. / circle.par(0), 0., circle.par(0) * temp3,
           circle.par(1) * temp3, -circle.q, 0., 0., -circle.q / (circle.par(2) * circle.par(2));
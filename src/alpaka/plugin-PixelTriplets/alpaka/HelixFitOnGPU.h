@@ -1,11 +1,14 @@
 #ifndef RecoPixelVertexing_PixelTrackFitting_plugins_HelixFitOnGPU_h
 #define RecoPixelVertexing_PixelTrackFitting_plugins_HelixFitOnGPU_h
 
+#include <algorithm>
+
 #include "AlpakaCore/alpakaConfig.h"
 #include "AlpakaDataFormats/PixelTrackAlpaka.h"
 #include "AlpakaDataFormats/TrackingRecHit2DAlpaka.h"
 
 #include "CAConstants.h"
+#include "FitLanes.h"
 #include "FitResult.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -14,23 +17,58 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     // in case of memory issue can be made smaller
     constexpr uint32_t maxNumberOfConcurrentFits() { return CAConstants::maxNumberOfTuples(); }
     constexpr uint32_t stride() { return maxNumberOfConcurrentFits(); }
-    using Matrix3x4d = Eigen::Matrix<double, 3, 4>;
+    // the hits and the fast fit are stored in the scratch buffers as scratch_t (see FitResult.h)
+    using Matrix3x4d = Eigen::Matrix<scratch_t, 3, 4>;
     using Map3x4d = Eigen::Map<Matrix3x4d, 0, Eigen::Stride<3 * stride(), stride()> >;
     using Matrix6x4f = Eigen::Matrix<float, 6, 4>;
     using Map6x4f = Eigen::Map<Matrix6x4f, 0, Eigen::Stride<6 * stride(), stride()> >;
 
     // hits
     template <int N>
-    using Matrix3xNd = Eigen::Matrix<double, 3, N>;
-    template <int N>
-    using Map3xNd = Eigen::Map<Matrix3xNd<N>, 0, Eigen::Stride<3 * stride(), stride()> >;
+    using Map3xNd = Eigen::Map<Eigen::Matrix<scratch_t, 3, N>, 0, Eigen::Stride<3 * stride(), stride()> >;
     // errors
     template <int N>
     using Matrix6xNf = Eigen::Matrix<float, 6, N>;
     template <int N>
     using Map6xNf = Eigen::Map<Matrix6xNf<N>, 0, Eigen::Stride<6 * stride(), stride()> >;
     // fast fit
-    using Map4d = Eigen::Map<Vector4d, 0, Eigen::InnerStride<stride()> >;
+    using Vector4s = Eigen::Matrix<scratch_t, 4, 1>;
+    using Map4d = Eigen::Map<Vector4s, 0, Eigen::InnerStride<stride()> >;
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+    // On the CPU backends each thread fits its consecutive tracks fitLanes at a time, one per SIMD lane.
+    // Two lanes fill the SSE registers; wider batches were measured slower, as their temporaries spill.
+    // This holds also with single precision fits (see Rfit::fit_t), where four lanes would fit.
+    constexpr uint32_t fitLanes = 2;
+
+    namespace batched {
+
+      // number of tracks to fit for this offset
+      ALPAKA_FN_ACC ALPAKA_FN_INLINE uint32_t numberOfFits(
+          CAConstants::TupleMultiplicity const *__restrict__ tupleMultiplicity, uint32_t nHits, uint32_t offset) {
+        uint32_t nTuples = tupleMultiplicity->size(nHits);
+        return offset < nTuples ? std::min(maxNumberOfConcurrentFits(), nTuples - offset) : 0;
+      }
+
+      // copy the n tracks starting at p from the SoA buffers of the fits (see Map3xNd) to the lanes,
+      // the unused lanes repeat the first track so that their computations stay finite
+      template <int R, int C, int L, typename T>
+      ALPAKA_FN_ACC ALPAKA_FN_INLINE void loadLanes(T const *__restrict__ p, uint32_t n, LaneMatrix<R, C, L> &m) {
+        for (int j = 0; j < C; ++j) {
+          for (int i = 0; i < R; ++i) {
+            T const *q = p + (i + R * j) * stride();
+            auto &v = m(i, j);
+            uint32_t l = 0;
+            for (; l < n; ++l)
+              v[l] = q[l];
+            for (; l < L; ++l)
+              v[l] = q[0];
+          }
+        }
+      }
+
+    }  // namespace batched
+#endif
 
   }  // namespace Rfit
 
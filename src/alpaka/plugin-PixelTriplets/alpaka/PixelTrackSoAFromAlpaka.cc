@@ -1,4 +1,5 @@
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaDataFormats/PixelTrackAlpaka.h"
 
 #include "Framework/EventSetup.h"
@@ -6,32 +7,27 @@
 #include "Framework/PluginFactory.h"
 #include "Framework/EDProducer.h"
 
+#include <optional>
+
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-#ifdef TODO
   class PixelTrackSoAFromAlpaka : public edm::EDProducerExternalWork {
-#else
-  class PixelTrackSoAFromAlpaka : public edm::EDProducer {
-#endif
   public:
     explicit PixelTrackSoAFromAlpaka(edm::ProductRegistry& reg);
     ~PixelTrackSoAFromAlpaka() override = default;
 
   private:
-#ifdef TODO
     void acquire(edm::Event const& iEvent,
                  edm::EventSetup const& iSetup,
                  edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
-#endif
     void produce(edm::Event& iEvent, edm::EventSetup const& iSetup) override;
 
     edm::EDGetTokenT<PixelTrackAlpaka> tokenAlpaka_;
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
     edm::EDPutTokenT<PixelTrackHost> tokenSOA_;
-#endif
 
-#ifdef TODO
-    cms::cuda::host::unique_ptr<pixelTrack::TrackSoA> m_soa;
+    Queue queue_;
+    std::optional<PixelTrackHost> m_soa;
 #endif
   };
 
@@ -39,22 +35,23 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       : tokenAlpaka_(reg.consumes<PixelTrackAlpaka>())
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
         ,
-        tokenSOA_(reg.produces<PixelTrackHost>())
+        tokenSOA_(reg.produces<PixelTrackHost>()),
+        queue_(device)
 #endif
   {
   }
 
-#ifdef TODO
   void PixelTrackSoAFromAlpaka::acquire(edm::Event const& iEvent,
                                         edm::EventSetup const& iSetup,
                                         edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
-    cms::cuda::Product<PixelTrackHeterogeneous> const& inputDataWrapped = iEvent.get(tokenAlpaka_);
-    cms::cuda::ScopedContextAcquire ctx{inputDataWrapped, std::move(waitingTaskHolder)};
-    auto const& inputData = ctx.get(inputDataWrapped);
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+    auto const& inputData = iEvent.get(tokenAlpaka_);
+    m_soa.emplace(allocHostBuf<pixelTrack::TrackSoA>(1u));
+    alpaka::memcpy(queue_, *m_soa, inputData, 1u);
 
-    m_soa = inputData.toHostAsync(ctx.stream());
-  }
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
 #endif
+  }
 
   void PixelTrackSoAFromAlpaka::produce(edm::Event& iEvent, edm::EventSetup const& iSetup) {
     /*
@@ -73,14 +70,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   */
 
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-    auto const& inputData = iEvent.get(tokenAlpaka_);
-    auto outputData = cms::alpakatools::allocHostBuf<pixelTrack::TrackSoA>(1u);
-    Queue queue(device);
-    alpaka::memcpy(queue, outputData, inputData, 1u);
-    alpaka::wait(queue);
-
     // DO NOT  make a copy  (actually TWO....)
-    iEvent.emplace(tokenSOA_, std::move(outputData));
+    iEvent.emplace(tokenSOA_, std::move(*m_soa));
+    m_soa.reset();
 #endif
   }
 
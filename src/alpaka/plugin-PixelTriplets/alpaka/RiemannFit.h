@@ -1,11 +1,21 @@
 #ifndef RecoPixelVertexing_PixelTrackFitting_interface_RiemannFit_h
 #define RecoPixelVertexing_PixelTrackFitting_interface_RiemannFit_h
 
+#include "FitLanes.h"
 #include "FitUtils.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
   namespace Rfit {
 
+    /*!
+    The fast, circle and line fits below are templates on the scalar type T of the fit: fit_t to fit one track,
+    or Lanes<L> to fit L tracks at once, one per SIMD lane (see FitLanes.h).
+  */
+    template <typename T>
+    using circle_fit_t = typename LaneTraits<T>::circle_fit;
+    template <typename T>
+    using line_fit_t = typename LaneTraits<T>::line_fit;
+
     /*!  Compute the Radiation length in the uniform hypothesis
  *
  * The Pixel detector, barrel and forward, is considered as an omogeneous
@@ -30,13 +40,14 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     template <typename VNd1, typename VNd2>
     ALPAKA_FN_HOST_ACC inline void computeRadLenUniformMaterial(const VNd1& length_values, VNd2& rad_lengths) {
+      using std::abs;
       // Radiation length of the pixel detector in the uniform assumption, with
       // 0.06 rad_len at 16 cm
-      constexpr double XX_0_inv = 0.06 / 16.;
+      constexpr fit_t XX_0_inv = 0.06 / 16.;
       u_int n = length_values.rows();
       rad_lengths(0) = length_values(0) * XX_0_inv;
       for (u_int j = 1; j < n; ++j) {
-        rad_lengths(j) = std::abs(length_values(j) - length_values(j - 1)) * XX_0_inv;
+        rad_lengths(j) = abs(length_values(j) - length_values(j - 1)) * XX_0_inv;
       }
     }
 
@@ -59,33 +70,35 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     correspond to the case at eta = 0.
  */
 
-    template <typename V4, typename VNd1, typename VNd2, int N>
-    ALPAKA_FN_HOST_ACC inline auto Scatter_cov_line(Matrix2d const* cov_sz,
+    template <typename V4, typename VNd1, typename VNd2, int N, typename T>
+    ALPAKA_FN_HOST_ACC inline auto Scatter_cov_line(Eigen::Matrix<T, 2, 2> const* cov_sz,
                                                     const V4& fast_fit,
                                                     VNd1 const& s_arcs,
                                                     VNd2 const& z_values,
-                                                    const double theta,
-                                                    const double B,
-                                                    MatrixNd<N>& ret) {
+                                                    const T theta,
+                                                    const fit_t B,
+                                                    Eigen::Matrix<T, N, N>& ret) {
+      using std::abs;
+      using std::min;
 #ifdef RFIT_DEBUG
       Rfit::printIt(&s_arcs, "Scatter_cov_line - s_arcs: ");
 #endif
       constexpr u_int n = N;
-      double p_t = std::min(20., fast_fit(2) * B);  // limit pt to avoid too small error!!!
-      double p_2 = p_t * p_t * (1. + 1. / (fast_fit(3) * fast_fit(3)));
-      VectorNd<N> rad_lengths_S;
+      T p_t = min(fit_t(20.), fast_fit(2) * B);  // limit pt to avoid too small error!!!
+      T p_2 = p_t * p_t * (1. + 1. / (fast_fit(3) * fast_fit(3)));
+      Eigen::Matrix<T, N, 1> rad_lengths_S;
       // See documentation at http://eigen.tuxfamily.org/dox/group__TutorialArrayClass.html
       // Basically, to perform cwise operations on Matrices and Vectors, you need
       // to transform them into Array-like objects.
-      VectorNd<N> S_values = s_arcs.array() * s_arcs.array() + z_values.array() * z_values.array();
+      Eigen::Matrix<T, N, 1> S_values = s_arcs.array() * s_arcs.array() + z_values.array() * z_values.array();
       S_values = S_values.array().sqrt();
       computeRadLenUniformMaterial(S_values, rad_lengths_S);
-      VectorNd<N> sig2_S;
+      Eigen::Matrix<T, N, 1> sig2_S;
       sig2_S = .000225 / p_2 * (1. + 0.038 * rad_lengths_S.array().log()).abs2() * rad_lengths_S.array();
 #ifdef RFIT_DEBUG
       Rfit::printIt(cov_sz, "Scatter_cov_line - cov_sz: ");
 #endif
-      Matrix2Nd<N> tmp = Matrix2Nd<N>::Zero();
+      Eigen::Matrix<T, 2 * N, 2 * N> tmp = Eigen::Matrix<T, 2 * N, 2 * N>::Zero();
       for (u_int k = 0; k < n; ++k) {
         tmp(k, k) = cov_sz[k](0, 0);
         tmp(k + n, k + n) = cov_sz[k](1, 1);
@@ -94,7 +107,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       for (u_int k = 0; k < n; ++k) {
         for (u_int l = k; l < n; ++l) {
           for (u_int i = 0; i < std::min(k, l); ++i) {
-            tmp(k + n, l + n) += std::abs(S_values(k) - S_values(i)) * std::abs(S_values(l) - S_values(i)) * sig2_S(i);
+            tmp(k + n, l + n) += abs(S_values(k) - S_values(i)) * abs(S_values(l) - S_values(i)) * sig2_S(i);
           }
           tmp(l + n, k + n) = tmp(k + n, l + n);
         }
@@ -120,31 +133,33 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \details Only the tangential component is computed (the radial one is
     negligible).
  */
-    template <typename M2xN, typename V4, int N>
-    ALPAKA_FN_HOST_ACC inline MatrixNd<N> Scatter_cov_rad(const M2xN& p2D,
-                                                          const V4& fast_fit,
-                                                          VectorNd<N> const& rad,
-                                                          double B) {
+    template <typename M2xN, typename V4, int N, typename T>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, N, N> Scatter_cov_rad(const M2xN& p2D,
+                                                                     const V4& fast_fit,
+                                                                     Eigen::Matrix<T, N, 1> const& rad,
+                                                                     fit_t B) {
+      using std::abs;
+      using std::min;
       constexpr u_int n = N;
-      double p_t = std::min(20., fast_fit(2) * B);  // limit pt to avoid too small error!!!
-      double p_2 = p_t * p_t * (1. + 1. / (fast_fit(3) * fast_fit(3)));
-      double theta = atan(fast_fit(3));
-      theta = theta < 0. ? theta + M_PI : theta;
-      VectorNd<N> s_values;
-      VectorNd<N> rad_lengths;
-      const Vector2d o(fast_fit(0), fast_fit(1));
+      T p_t = min(fit_t(20.), fast_fit(2) * B);  // limit pt to avoid too small error!!!
+      T p_2 = p_t * p_t * (1. + 1. / (fast_fit(3) * fast_fit(3)));
+      T theta = atan(fast_fit(3));
+      theta = select(theta < 0., theta + M_PI, theta);
+      Eigen::Matrix<T, N, 1> s_values;
+      Eigen::Matrix<T, N, 1> rad_lengths;
+      const Eigen::Matrix<T, 2, 1> o(fast_fit(0), fast_fit(1));
 
       // associated Jacobian, used in weights and errors computation
       for (u_int i = 0; i < n; ++i) {  // x
-        Vector2d p = p2D.block(0, i, 2, 1) - o;
-        const double cross = cross2D(-o, p);
-        const double dot = (-o).dot(p);
-        const double atan2_ = atan2(cross, dot);
-        s_values(i) = std::abs(atan2_ * fast_fit(2));
+        Eigen::Matrix<T, 2, 1> p = p2D.block(0, i, 2, 1) - o;
+        const T cross = cross2D<T>(-o, p);
+        const T dot = (-o).dot(p);
+        const T atan2_ = atan2(cross, dot);
+        s_values(i) = abs(atan2_ * fast_fit(2));
       }
       computeRadLenUniformMaterial(s_values * sqrt(1. + 1. / (fast_fit(3) * fast_fit(3))), rad_lengths);
-      MatrixNd<N> scatter_cov_rad = MatrixNd<N>::Zero();
-      VectorNd<N> sig2 = (1. + 0.038 * rad_lengths.array().log()).abs2() * rad_lengths.array();
+      Eigen::Matrix<T, N, N> scatter_cov_rad = Eigen::Matrix<T, N, N>::Zero();
+      Eigen::Matrix<T, N, 1> sig2 = (1. + 0.038 * rad_lengths.array().log()).abs2() * rad_lengths.array();
       sig2 *= 0.000225 / (p_2 * sqr(sin(theta)));
       for (u_int k = 0; k < n; ++k) {
         for (u_int l = k; l < n; ++l) {
@@ -168,17 +183,17 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \return cov_cart covariance matrix in Cartesian coordinates.
 */
 
-    template <typename M2xN, int N>
-    ALPAKA_FN_HOST_ACC inline Matrix2Nd<N> cov_radtocart(const M2xN& p2D,
-                                                         const MatrixNd<N>& cov_rad,
-                                                         const VectorNd<N>& rad) {
+    template <typename M2xN, int N, typename T>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, 2 * N, 2 * N> cov_radtocart(const M2xN& p2D,
+                                                                           const Eigen::Matrix<T, N, N>& cov_rad,
+                                                                           const Eigen::Matrix<T, N, 1>& rad) {
 #ifdef RFIT_DEBUG
       printf("Address of p2D: %p\n", &p2D);
 #endif
       printIt(&p2D, "cov_radtocart - p2D:");
       constexpr u_int n = N;
-      Matrix2Nd<N> cov_cart = Matrix2Nd<N>::Zero();
-      VectorNd<N> rad_inv = rad.cwiseInverse();
+      Eigen::Matrix<T, 2 * N, 2 * N> cov_cart = Eigen::Matrix<T, 2 * N, 2 * N>::Zero();
+      Eigen::Matrix<T, N, 1> rad_inv = rad.cwiseInverse();
       printIt(&rad_inv, "cov_radtocart - rad_inv:");
       for (u_int i = 0; i < n; ++i) {
         for (u_int j = i; j < n; ++j) {
@@ -236,27 +251,26 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \return cov_rad covariance matrix in the pre-fitted circle's
     orthogonal system.
 */
-    template <typename M2xN, typename V4, int N>
-    ALPAKA_FN_HOST_ACC inline VectorNd<N> cov_carttorad_prefit(const M2xN& p2D,
-                                                               const Matrix2Nd<N>& cov_cart,
-                                                               V4& fast_fit,
-                                                               const VectorNd<N>& rad) {
+    template <typename M2xN, typename V4, int N, typename T>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, N, 1> cov_carttorad_prefit(
+        const M2xN& p2D,
+        const Eigen::Matrix<T, 2 * N, 2 * N>& cov_cart,
+        V4& fast_fit,
+        const Eigen::Matrix<T, N, 1>& rad) {
       constexpr u_int n = N;
-      VectorNd<N> cov_rad;
+      Eigen::Matrix<T, N, 1> cov_rad;
       for (u_int i = 0; i < n; ++i) {
+        Eigen::Matrix<T, 2, 1> a = p2D.col(i);
+        Eigen::Matrix<T, 2, 1> b = p2D.col(i) - fast_fit.head(2);
+        const T x2 = a.dot(b);
+        const T y2 = cross2D(a, b);
+        const T tan_c = -y2 / x2;
+        const T tan_c2 = sqr(tan_c);
         //!< in case you have (0,0) to avoid dividing by 0 radius
-        if (rad(i) < 1.e-4)
-          cov_rad(i) = cov_cart(i, i);  // TO FIX
-        else {
-          Vector2d a = p2D.col(i);
-          Vector2d b = p2D.col(i) - fast_fit.head(2);
-          const double x2 = a.dot(b);
-          const double y2 = cross2D(a, b);
-          const double tan_c = -y2 / x2;
-          const double tan_c2 = sqr(tan_c);
-          cov_rad(i) =
-              1. / (1. + tan_c2) * (cov_cart(i, i) + cov_cart(i + n, i + n) * tan_c2 + 2 * cov_cart(i, i + n) * tan_c);
-        }
+        cov_rad(i) = select(
+            rad(i) < 1.e-4,
+            cov_cart(i, i),  // TO FIX
+            1. / (1. + tan_c2) * (cov_cart(i, i) + cov_cart(i + n, i + n) * tan_c2 + 2 * cov_cart(i, i + n) * tan_c));
       }
       return cov_rad;
     }
@@ -272,8 +286,8 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     diagonal cov matrix. Further investigation needed.
 */
 
-    template <int N>
-    ALPAKA_FN_HOST_ACC inline VectorNd<N> Weight_circle(const MatrixNd<N>& cov_rad_inv) {
+    template <typename T, int N>
+    ALPAKA_FN_HOST_ACC inline Eigen::Matrix<T, N, 1> Weight_circle(const Eigen::Matrix<T, N, N>& cov_rad_inv) {
       return cov_rad_inv.colwise().sum().transpose();
     }
 
@@ -285,13 +299,11 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \param par_uvr result of the circle fit in this form: (X0,Y0,R).
     \return q int 1 or -1.
 */
-    template <typename M2xN>
-    ALPAKA_FN_HOST_ACC inline int32_t Charge(const M2xN& p2D, const Vector3d& par_uvr) {
-      return ((p2D(0, 1) - p2D(0, 0)) * (par_uvr.y() - p2D(1, 0)) -
-                  (p2D(1, 1) - p2D(1, 0)) * (par_uvr.x() - p2D(0, 0)) >
-              0)
-                 ? -1
-                 : 1;
+    template <typename M2xN, typename V3>
+    ALPAKA_FN_HOST_ACC inline typename LaneTraits<typename M2xN::Scalar>::charge_t Charge(const M2xN& p2D,
+                                                                                        const V3& par_uvr) {
+      return chargeFromCross((p2D(0, 1) - p2D(0, 0)) * (par_uvr.y() - p2D(1, 0)) -
+                             (p2D(1, 1) - p2D(1, 0)) * (par_uvr.x() - p2D(0, 0)));
     }
 
     /*!
@@ -309,7 +321,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     For this optimization the matrix type must be known at compiling time.
 */
 
-    ALPAKA_FN_HOST_ACC inline Vector3d min_eigen3D(const Matrix3d& A, double& chi2) {
+    ALPAKA_FN_HOST_ACC inline Vector3d min_eigen3D(const Matrix3d& A, fit_t& chi2) {
 #ifdef RFIT_DEBUG
       printf("min_eigen3D - enter\n");
 #endif
@@ -323,6 +335,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       return solver.eigenvectors().col(min_index);
     }
 
+    //! the same for L tracks: the closed-form solver branches on the matrix, so it runs lane by lane
+    template <int L>
+    ALPAKA_FN_HOST_ACC inline LaneMatrix<3, 1, L> min_eigen3D(const LaneMatrix<3, 3, L>& A, Lanes<L>& chi2) {
+      LaneMatrix<3, 1, L> v;
+      for (int l = 0; l < L; ++l)
+        setLane(v, l, min_eigen3D(lane(A, l), chi2[l]));
+      return v;
+    }
+
     /*!
     \brief A faster version of min_eigen3D() where double precision is not
     needed.
@@ -339,7 +360,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       solver.computeDirect(A.cast<float>());
       int min_index;
       solver.eigenvalues().minCoeff(&min_index);
-      return solver.eigenvectors().col(min_index).cast<double>();
+      return solver.eigenvectors().col(min_index).cast<fit_t>();
+    }
+
+    template <int L>
+    ALPAKA_FN_HOST_ACC inline LaneMatrix<3, 1, L> min_eigen3D_fast(const LaneMatrix<3, 3, L>& A) {
+      LaneMatrix<3, 1, L> v;
+      for (int l = 0; l < L; ++l)
+        setLane(v, l, min_eigen3D_fast(lane(A, l)));
+      return v;
     }
 
     /*!
@@ -352,7 +381,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     significantly in single precision.
 */
 
-    ALPAKA_FN_HOST_ACC inline Vector2d min_eigen2D(const Matrix2d& A, double& chi2) {
+    ALPAKA_FN_HOST_ACC inline Vector2d min_eigen2D(const Matrix2d& A, fit_t& chi2) {
       Eigen::SelfAdjointEigenSolver<Matrix2d> solver(2);
       solver.computeDirect(A);
       int min_index;
@@ -375,14 +404,16 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     template <typename M3xN, typename V4>
     ALPAKA_FN_HOST_ACC inline void Fast_fit(const M3xN& hits, V4& result) {
+      using T = typename M3xN::Scalar;
+      using std::abs;
       constexpr uint32_t N = M3xN::ColsAtCompileTime;
       constexpr auto n = N;  // get the number of hits
       printIt(&hits, "Fast_fit - hits: ");
 
       // CIRCLE FIT
       // Make segments between middle-to-first(b) and last-to-first(c) hits
-      const Vector2d b = hits.block(0, n / 2, 2, 1) - hits.block(0, 0, 2, 1);
-      const Vector2d c = hits.block(0, n - 1, 2, 1) - hits.block(0, 0, 2, 1);
+      const Eigen::Matrix<T, 2, 1> b = hits.block(0, n / 2, 2, 1) - hits.block(0, 0, 2, 1);
+      const Eigen::Matrix<T, 2, 1> c = hits.block(0, n - 1, 2, 1) - hits.block(0, 0, 2, 1);
       printIt(&b, "Fast_fit - b: ");
       printIt(&c, "Fast_fit - c: ");
       // Compute their lengths
@@ -394,24 +425,24 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // * build orthogonal lines through mid points
       // * make a system and solve for X0 and Y0.
       // * add the initial point
-      bool flip = abs(b.x()) < abs(b.y());
-      auto bx = flip ? b.y() : b.x();
-      auto by = flip ? b.x() : b.y();
-      auto cx = flip ? c.y() : c.x();
-      auto cy = flip ? c.x() : c.y();
+      auto flip = abs(b.x()) < abs(b.y());
+      auto bx = select(flip, b.y(), b.x());
+      auto by = select(flip, b.x(), b.y());
+      auto cx = select(flip, c.y(), c.x());
+      auto cy = select(flip, c.x(), c.y());
       //!< in case b.x is 0 (2 hits with same x)
       auto div = 2. * (cx * by - bx * cy);
       // if aligned TO FIX
       auto Y0 = (cx * b2 - bx * c2) / div;
       auto X0 = (0.5 * b2 - Y0 * by) / bx;
-      result(0) = hits(0, 0) + (flip ? Y0 : X0);
-      result(1) = hits(1, 0) + (flip ? X0 : Y0);
+      result(0) = hits(0, 0) + select(flip, Y0, X0);
+      result(1) = hits(1, 0) + select(flip, X0, Y0);
       result(2) = sqrt(sqr(X0) + sqr(Y0));
       printIt(&result, "Fast_fit - result: ");
 
       // LINE FIT
-      const Vector2d d = hits.block(0, 0, 2, 1) - result.head(2);
-      const Vector2d e = hits.block(0, n - 1, 2, 1) - result.head(2);
+      const Eigen::Matrix<T, 2, 1> d = hits.block(0, 0, 2, 1) - result.head(2);
+      const Eigen::Matrix<T, 2, 1> e = hits.block(0, n - 1, 2, 1) - result.head(2);
       printIt(&e, "Fast_fit - e: ");
       printIt(&d, "Fast_fit - d: ");
       // Compute the arc-length between first and last point: L = R * theta = R * atan (tan (Theta) )
@@ -453,18 +484,19 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     \bug further investigation needed for error propagation with multiple
     scattering.
 */
-    template <typename M2xN, typename V4, int N>
-    ALPAKA_FN_HOST_ACC inline circle_fit Circle_fit(const M2xN& hits2D,
-                                                    const Matrix2Nd<N>& hits_cov2D,
-                                                    const V4& fast_fit,
-                                                    const VectorNd<N>& rad,
-                                                    const double B,
-                                                    const bool error) {
+    template <typename M2xN, typename V4, int N, typename T>
+    ALPAKA_FN_HOST_ACC inline circle_fit_t<T> Circle_fit(const M2xN& hits2D,
+                                                         const Eigen::Matrix<T, 2 * N, 2 * N>& hits_cov2D,
+                                                         const V4& fast_fit,
+                                                         const Eigen::Matrix<T, N, 1>& rad,
+                                                         const fit_t B,
+                                                         const bool error) {
+      using std::abs;
 #ifdef RFIT_DEBUG
       printf("circle_fit - enter\n");
 #endif
       // INITIALIZATION
-      Matrix2Nd<N> V = hits_cov2D;
+      Eigen::Matrix<T, 2 * N, 2 * N> V = hits_cov2D;
       constexpr u_int n = N;
       printIt(&hits2D, "circle_fit - hits2D:");
       printIt(&hits_cov2D, "circle_fit - hits_cov2D:");
@@ -473,12 +505,12 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       printf("circle_fit - WEIGHT COMPUTATION\n");
 #endif
       // WEIGHT COMPUTATION
-      VectorNd<N> weight;
-      MatrixNd<N> G;
-      double renorm;
+      Eigen::Matrix<T, N, 1> weight;
+      Eigen::Matrix<T, N, N> G;
+      T renorm;
       {
-        MatrixNd<N> cov_rad = cov_carttorad_prefit(hits2D, V, fast_fit, rad).asDiagonal();
-        MatrixNd<N> scatter_cov_rad = Scatter_cov_rad(hits2D, fast_fit, rad, B);
+        Eigen::Matrix<T, N, N> cov_rad = cov_carttorad_prefit(hits2D, V, fast_fit, rad).asDiagonal();
+        Eigen::Matrix<T, N, N> scatter_cov_rad = Scatter_cov_rad(hits2D, fast_fit, rad, B);
         printIt(&scatter_cov_rad, "circle_fit - scatter_cov_rad:");
         printIt(&hits2D, "circle_fit - hits2D bis:");
 #ifdef RFIT_DEBUG
@@ -505,18 +537,18 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #ifdef RFIT_DEBUG
       printf("Address of hits2D: b) %p\n", &hits2D);
 #endif
-      const Vector2d h_ = hits2D.rowwise().mean();  // centroid
+      const Eigen::Matrix<T, 2, 1> h_ = hits2D.rowwise().mean();  // centroid
       printIt(&h_, "circle_fit - h_:");
-      Matrix3xNd<N> p3D;
+      Eigen::Matrix<T, 3, N> p3D;
       p3D.block(0, 0, 2, n) = hits2D.colwise() - h_;
       printIt(&p3D, "circle_fit - p3D: a)");
-      Vector2Nd<N> mc;  // centered hits, used in error computation
+      Eigen::Matrix<T, 2 * N, 1> mc;  // centered hits, used in error computation
       mc << p3D.row(0).transpose(), p3D.row(1).transpose();
       printIt(&mc, "circle_fit - mc(centered hits):");
 
       // scale
-      const double q = mc.squaredNorm();
-      const double s = sqrt(n * 1. / q);  // scaling factor
+      const T q = mc.squaredNorm();
+      const T s = sqrt(n * 1. / q);  // scaling factor
       p3D *= s;
 
       // project on paraboloid
@@ -529,30 +561,30 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // COST FUNCTION
 
       // compute
-      Vector3d r0;
+      Eigen::Matrix<T, 3, 1> r0;
       r0.noalias() = p3D * weight;  // center of gravity
-      const Matrix3xNd<N> X = p3D.colwise() - r0;
-      Matrix3d A = X * G * X.transpose();
+      const Eigen::Matrix<T, 3, N> X = p3D.colwise() - r0;
+      Eigen::Matrix<T, 3, 3> A = X * G * X.transpose();
       printIt(&A, "circle_fit - A:");
 
 #ifdef RFIT_DEBUG
       printf("circle_fit - MINIMIZE\n");
 #endif
       // minimize
-      double chi2;
-      Vector3d v = min_eigen3D(A, chi2);
+      T chi2;
+      Eigen::Matrix<T, 3, 1> v = min_eigen3D(A, chi2);
 #ifdef RFIT_DEBUG
       printf("circle_fit - AFTER MIN_EIGEN\n");
 #endif
       printIt(&v, "v BEFORE INVERSION");
-      v *= (v(2) > 0) ? 1 : -1;  // TO FIX dovrebbe essere N(3)>0
+      v *= select(v(2) > 0, T(1), T(-1));  // TO FIX dovrebbe essere N(3)>0
       printIt(&v, "v AFTER INVERSION");
       // This hack to be able to run on GPU where the automatic assignment to a
       // double from the vector multiplication is not working.
 #ifdef RFIT_DEBUG
       printf("circle_fit - AFTER MIN_EIGEN 1\n");
 #endif
-      Eigen::Matrix<double, 1, 1> cm;
+      Eigen::Matrix<T, 1, 1> cm;
 #ifdef RFIT_DEBUG
       printf("circle_fit - AFTER MIN_EIGEN 2\n");
 #endif
@@ -560,7 +592,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #ifdef RFIT_DEBUG
       printf("circle_fit - AFTER MIN_EIGEN 3\n");
 #endif
-      const double c = cm(0, 0);
+      const T c = cm(0, 0);
       //  const double c = -v.transpose() * r0;
 
 #ifdef RFIT_DEBUG
@@ -569,13 +601,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // COMPUTE CIRCLE PARAMETER
 
       // auxiliary quantities
-      const double h = sqrt(1. - sqr(v(2)) - 4. * c * v(2));
-      const double v2x2_inv = 1. / (2. * v(2));
-      const double s_inv = 1. / s;
-      Vector3d par_uvr_;  // used in error propagation
+      const T h = sqrt(1. - sqr(v(2)) - 4. * c * v(2));
+      const T v2x2_inv = 1. / (2. * v(2));
+      const T s_inv = 1. / s;
+      Eigen::Matrix<T, 3, 1> par_uvr_;  // used in error propagation
       par_uvr_ << -v(0) * v2x2_inv, -v(1) * v2x2_inv, h * v2x2_inv;
 
-      circle_fit circle;
+      circle_fit_t<T> circle;
       circle.par << par_uvr_(0) * s_inv + h_(0), par_uvr_(1) * s_inv + h_(1), par_uvr_(2) * s_inv;
       circle.q = Charge(hits2D, circle.par);
       circle.chi2 = abs(chi2) * renorm * 1. / sqr(2 * v(2) * par_uvr_(2) * s);
@@ -593,17 +625,17 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #ifdef RFIT_DEBUG
         printf("circle_fit - ERROR PRPAGATION ACTIVATED\n");
 #endif
-        ArrayNd<N> Vcs_[2][2];  // cov matrix of center & scaled points
-        MatrixNd<N> C[3][3];    // cov matrix of 3D transformed points
+        Eigen::Array<T, N, N> Vcs_[2][2];  // cov matrix of center & scaled points
+        Eigen::Matrix<T, N, N> C[3][3];    // cov matrix of 3D transformed points
 #ifdef RFIT_DEBUG
         printf("circle_fit - ERROR PRPAGATION ACTIVATED 2\n");
 #endif
         {
-          Eigen::Matrix<double, 1, 1> cm;
-          Eigen::Matrix<double, 1, 1> cm2;
+          Eigen::Matrix<T, 1, 1> cm;
+          Eigen::Matrix<T, 1, 1> cm2;
           cm = mc.transpose() * V * mc;
-          const double c = cm(0, 0);
-          Matrix2Nd<N> Vcs;
+          const T c = cm(0, 0);
+          Eigen::Matrix<T, 2 * N, 2 * N> Vcs;
           Vcs.template triangularView<Eigen::Upper>() =
               (sqr(s) * V + sqr(sqr(s)) * 1. / (4. * q * n) *
                                 (2. * V.squaredNorm() + 4. * c) *  // mc.transpose() * V * mc) *
@@ -618,19 +650,19 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         }
 
         {
-          const ArrayNd<N> t0 = (VectorXd::Constant(n, 1.) * p3D.row(0));
-          const ArrayNd<N> t1 = (VectorXd::Constant(n, 1.) * p3D.row(1));
-          const ArrayNd<N> t00 = p3D.row(0).transpose() * p3D.row(0);
-          const ArrayNd<N> t01 = p3D.row(0).transpose() * p3D.row(1);
-          const ArrayNd<N> t11 = p3D.row(1).transpose() * p3D.row(1);
-          const ArrayNd<N> t10 = t01.transpose();
+          const Eigen::Array<T, N, N> t0 = (Eigen::Matrix<T, N, 1>::Constant(1.) * p3D.row(0));
+          const Eigen::Array<T, N, N> t1 = (Eigen::Matrix<T, N, 1>::Constant(1.) * p3D.row(1));
+          const Eigen::Array<T, N, N> t00 = p3D.row(0).transpose() * p3D.row(0);
+          const Eigen::Array<T, N, N> t01 = p3D.row(0).transpose() * p3D.row(1);
+          const Eigen::Array<T, N, N> t11 = p3D.row(1).transpose() * p3D.row(1);
+          const Eigen::Array<T, N, N> t10 = t01.transpose();
           Vcs_[0][0] = C[0][0];
           ;
           C[0][1] = Vcs_[0][1];
           C[0][2] = 2. * (Vcs_[0][0] * t0 + Vcs_[0][1] * t1);
           Vcs_[1][1] = C[1][1];
           C[1][2] = 2. * (Vcs_[1][0] * t0 + Vcs_[1][1] * t1);
-          MatrixNd<N> tmp;
+          Eigen::Matrix<T, N, N> tmp;
           tmp.template triangularView<Eigen::Upper>() =
               (2. * (Vcs_[0][0] * Vcs_[0][0] + Vcs_[0][0] * Vcs_[0][1] + Vcs_[1][1] * Vcs_[1][0] +
                      Vcs_[1][1] * Vcs_[1][1]) +
@@ -640,26 +672,26 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         }
         printIt(&C[0][0], "circle_fit - C[0][0]:");
 
-        Matrix3d C0;  // cov matrix of center of gravity (r0.x,r0.y,r0.z)
+        Eigen::Matrix<T, 3, 3> C0;  // cov matrix of center of gravity (r0.x,r0.y,r0.z)
         for (u_int i = 0; i < 3; ++i) {
           for (u_int j = i; j < 3; ++j) {
-            Eigen::Matrix<double, 1, 1> tmp;
+            Eigen::Matrix<T, 1, 1> tmp;
             tmp = weight.transpose() * C[i][j] * weight;
-            const double c = tmp(0, 0);
+            const T c = tmp(0, 0);
             C0(i, j) = c;  //weight.transpose() * C[i][j] * weight;
             C0(j, i) = C0(i, j);
           }
         }
         printIt(&C0, "circle_fit - C0:");
 
-        const MatrixNd<N> W = weight * weight.transpose();
-        const MatrixNd<N> H = MatrixNd<N>::Identity().rowwise() - weight.transpose();
-        const MatrixNx3d<N> s_v = H * p3D.transpose();
+        const Eigen::Matrix<T, N, N> W = weight * weight.transpose();
+        const Eigen::Matrix<T, N, N> H = Eigen::Matrix<T, N, N>::Identity().rowwise() - weight.transpose();
+        const Eigen::Matrix<T, N, 3> s_v = H * p3D.transpose();
         printIt(&W, "circle_fit - W:");
         printIt(&H, "circle_fit - H:");
         printIt(&s_v, "circle_fit - s_v:");
 
-        MatrixNd<N> D_[3][3];  // cov(s_v)
+        Eigen::Matrix<T, N, N> D_[3][3];  // cov(s_v)
         {
           D_[0][0] = (H * C[0][0] * H.transpose()).cwiseProduct(W);
           D_[0][1] = (H * C[0][1] * H.transpose()).cwiseProduct(W);
@@ -675,13 +707,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
         constexpr u_int nu[6][2] = {{0, 0}, {0, 1}, {0, 2}, {1, 1}, {1, 2}, {2, 2}};
 
-        Matrix6d E;  // cov matrix of the 6 independent elements of A
+        Eigen::Matrix<T, 6, 6> E;  // cov matrix of the 6 independent elements of A
         for (u_int a = 0; a < 6; ++a) {
           const u_int i = nu[a][0], j = nu[a][1];
           for (u_int b = a; b < 6; ++b) {
             const u_int k = nu[b][0], l = nu[b][1];
-            VectorNd<N> t0(n);
-            VectorNd<N> t1(n);
+            Eigen::Matrix<T, N, 1> t0;
+            Eigen::Matrix<T, N, 1> t1;
             if (l == k) {
               t0 = 2. * D_[j][l] * s_v.col(l);
               if (i == j)
@@ -697,14 +729,14 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
             }
 
             if (i == j) {
-              Eigen::Matrix<double, 1, 1> cm;
+              Eigen::Matrix<T, 1, 1> cm;
               cm = s_v.col(i).transpose() * (t0 + t1);
-              const double c = cm(0, 0);
+              const T c = cm(0, 0);
               E(a, b) = 0. + c;
             } else {
-              Eigen::Matrix<double, 1, 1> cm;
+              Eigen::Matrix<T, 1, 1> cm;
               cm = (s_v.col(i).transpose() * t0) + (s_v.col(j).transpose() * t1);
-              const double c = cm(0, 0);
+              const T c = cm(0, 0);
               E(a, b) = 0. + c;  //(s_v.col(i).transpose() * t0) + (s_v.col(j).transpose() * t1);
             }
             if (b != a)
@@ -713,48 +745,48 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         }
         printIt(&E, "circle_fit - E:");
 
-        Eigen::Matrix<double, 3, 6> J2;  // Jacobian of min_eigen() (numerically computed)
+        Eigen::Matrix<T, 3, 6> J2;  // Jacobian of min_eigen() (numerically computed)
         for (u_int a = 0; a < 6; ++a) {
           const u_int i = nu[a][0], j = nu[a][1];
-          Matrix3d Delta = Matrix3d::Zero();
+          Eigen::Matrix<T, 3, 3> Delta = Eigen::Matrix<T, 3, 3>::Zero();
           Delta(i, j) = Delta(j, i) = abs(A(i, j) * d);
-          J2.col(a) = min_eigen3D_fast(A + Delta);
-          const int sign = (J2.col(a)(2) > 0) ? 1 : -1;
+          J2.col(a) = min_eigen3D_fast(Eigen::Matrix<T, 3, 3>(A + Delta));
+          const T sign = select(J2.col(a)(2) > 0, T(1), T(-1));
           J2.col(a) = (J2.col(a) * sign - v) / Delta(i, j);
         }
         printIt(&J2, "circle_fit - J2:");
 
-        Matrix4d Cvc;  // joint cov matrix of (v0,v1,v2,c)
+        Eigen::Matrix<T, 4, 4> Cvc;  // joint cov matrix of (v0,v1,v2,c)
         {
-          Matrix3d t0 = J2 * E * J2.transpose();
-          Vector3d t1 = -t0 * r0;
+          Eigen::Matrix<T, 3, 3> t0 = J2 * E * J2.transpose();
+          Eigen::Matrix<T, 3, 1> t1 = -t0 * r0;
           Cvc.block(0, 0, 3, 3) = t0;
           Cvc.block(0, 3, 3, 1) = t1;
           Cvc.block(3, 0, 1, 3) = t1.transpose();
-          Eigen::Matrix<double, 1, 1> cm1;
-          Eigen::Matrix<double, 1, 1> cm3;
+          Eigen::Matrix<T, 1, 1> cm1;
+          Eigen::Matrix<T, 1, 1> cm3;
           cm1 = (v.transpose() * C0 * v);
           //      cm2 = (C0.cwiseProduct(t0)).sum();
           cm3 = (r0.transpose() * t0 * r0);
-          const double c = cm1(0, 0) + (C0.cwiseProduct(t0)).sum() + cm3(0, 0);
+          const T c = cm1(0, 0) + (C0.cwiseProduct(t0)).sum() + cm3(0, 0);
           Cvc(3, 3) = c;
           // (v.transpose() * C0 * v) + (C0.cwiseProduct(t0)).sum() + (r0.transpose() * t0 * r0);
         }
         printIt(&Cvc, "circle_fit - Cvc:");
 
-        Eigen::Matrix<double, 3, 4> J3;  // Jacobian (v0,v1,v2,c)->(X0,Y0,R)
+        Eigen::Matrix<T, 3, 4> J3;  // Jacobian (v0,v1,v2,c)->(X0,Y0,R)
         {
-          const double t = 1. / h;
+          const T t = 1. / h;
           J3 << -v2x2_inv, 0, v(0) * sqr(v2x2_inv) * 2., 0, 0, -v2x2_inv, v(1) * sqr(v2x2_inv) * 2., 0,
               v(0) * v2x2_inv * t, v(1) * v2x2_inv * t, -h * sqr(v2x2_inv) * 2. - (2. * c + v(2)) * v2x2_inv * t, -t;
         }
         printIt(&J3, "circle_fit - J3:");
 
-        const RowVector2Nd<N> Jq = mc.transpose() * s * 1. / n;  // var(q)
+        const Eigen::Matrix<T, 1, 2 * N> Jq = mc.transpose() * s * 1. / n;  // var(q)
         printIt(&Jq, "circle_fit - Jq:");
 
-        Matrix3d cov_uvr = J3 * Cvc * J3.transpose() * sqr(s_inv)  // cov(X0,Y0,R)
-                           + (par_uvr_ * par_uvr_.transpose()) * (Jq * V * Jq.transpose());
+        Eigen::Matrix<T, 3, 3> cov_uvr = J3 * Cvc * J3.transpose() * sqr(s_inv)  // cov(X0,Y0,R)
+                                         + (par_uvr_ * par_uvr_.transpose()) * (Jq * V * Jq.transpose());
 
         circle.cov = cov_uvr;
       }
@@ -782,20 +814,20 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
  * what is done in the same fit in the Broken Line approach.
  */
 
-    template <typename M3xN, typename M6xN, typename V4>
-    ALPAKA_FN_HOST_ACC inline line_fit Line_fit(const M3xN& hits,
-                                                const M6xN& hits_ge,
-                                                const circle_fit& circle,
-                                                const V4& fast_fit,
-                                                const double B,
-                                                const bool error) {
+    template <typename M3xN, typename M6xN, typename V4, typename T = typename M3xN::Scalar>
+    ALPAKA_FN_HOST_ACC inline line_fit_t<T> Line_fit(const M3xN& hits,
+                                                     const M6xN& hits_ge,
+                                                     const circle_fit_t<T>& circle,
+                                                     const V4& fast_fit,
+                                                     const fit_t B,
+                                                     const bool error) {
       constexpr uint32_t N = M3xN::ColsAtCompileTime;
       constexpr auto n = N;
-      double theta = -circle.q * atan(fast_fit(3));
-      theta = theta < 0. ? theta + M_PI : theta;
+      T theta = -circle.q * atan(fast_fit(3));
+      theta = select(theta < 0., theta + M_PI, theta);
 
       // Prepare the Rotation Matrix to rotate the points
-      Eigen::Matrix<double, 2, 2> rot;
+      Eigen::Matrix<T, 2, 2> rot;
       rot << sin(theta), cos(theta), -cos(theta), sin(theta);
 
       // PROJECTION ON THE CILINDER
@@ -806,8 +838,8 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // s values will be ordinary x-values
       // z values will be ordinary y-values
 
-      Matrix2xNd<N> p2D = Matrix2xNd<N>::Zero();
-      Eigen::Matrix<double, 2, 6> Jx;
+      Eigen::Matrix<T, 2, N> p2D = Eigen::Matrix<T, 2, N>::Zero();
+      Eigen::Matrix<T, 2, 6> Jx;
 
 #ifdef RFIT_DEBUG
       printf("Line_fit - B: %g\n", B);
@@ -820,31 +852,31 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // Slide 11
       // a ==> -o i.e. the origin of the circle in XY plane, negative
       // b ==> p i.e. distances of the points wrt the origin of the circle.
-      const Vector2d o(circle.par(0), circle.par(1));
+      const Eigen::Matrix<T, 2, 1> o(circle.par(0), circle.par(1));
 
       // associated Jacobian, used in weights and errors computation
-      Matrix6d Cov = Matrix6d::Zero();
-      Matrix2d cov_sz[N];
+      Eigen::Matrix<T, 6, 6> Cov = Eigen::Matrix<T, 6, 6>::Zero();
+      Eigen::Matrix<T, 2, 2> cov_sz[N];
       for (u_int i = 0; i < n; ++i) {
-        Vector2d p = hits.block(0, i, 2, 1) - o;
-        const double cross = cross2D(-o, p);
-        const double dot = (-o).dot(p);
+        Eigen::Matrix<T, 2, 1> p = hits.block(0, i, 2, 1) - o;
+        const T cross = cross2D<T>(-o, p);
+        const T dot = (-o).dot(p);
         // atan2(cross, dot) give back the angle in the transverse plane so tha the
         // final equation reads: x_i = -q*R*theta (theta = angle returned by atan2)
-        const double atan2_ = -circle.q * atan2(cross, dot);
+        const T atan2_ = -circle.q * atan2(cross, dot);
         //    p2D.coeffRef(1, i) = atan2_ * circle.par(2);
         p2D(0, i) = atan2_ * circle.par(2);
 
         // associated Jacobian, used in weights and errors- computation
-        const double temp0 = -circle.q * circle.par(2) * 1. / (sqr(dot) + sqr(cross));
-        double d_X0 = 0., d_Y0 = 0., d_R = 0.;  // good approximation for big pt and eta
+        const T temp0 = -circle.q * circle.par(2) * 1. / (sqr(dot) + sqr(cross));
+        T d_X0 = 0., d_Y0 = 0., d_R = 0.;  // good approximation for big pt and eta
         if (error) {
           d_X0 = -temp0 * ((p(1) + o(1)) * dot - (p(0) - o(0)) * cross);
           d_Y0 = temp0 * ((p(0) + o(0)) * dot - (o(1) - p(1)) * cross);
           d_R = atan2_;
         }
-        const double d_x = temp0 * (o(1) * dot + o(0) * cross);
-        const double d_y = temp0 * (-o(0) * dot + o(1) * cross);
+        const T d_x = temp0 * (o(1) * dot + o(0) * cross);
+        const T d_y = temp0 * (-o(0) * dot + o(1) * cross);
         Jx << d_X0, d_Y0, d_R, d_x, d_y, 0., 0., 0., 0., 0., 0., 1.;
 
         Cov.block(0, 0, 3, 3) = circle.cov;
@@ -854,7 +886,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         Cov(3, 4) = Cov(4, 3) = hits_ge.col(i)[1];  // cov_xy
         Cov(3, 5) = Cov(5, 3) = hits_ge.col(i)[3];  // cov_xz
         Cov(4, 5) = Cov(5, 4) = hits_ge.col(i)[4];  // cov_yz
-        Matrix2d tmp = Jx * Cov * Jx.transpose();
+        Eigen::Matrix<T, 2, 2> tmp = Jx * Cov * Jx.transpose();
         cov_sz[i].noalias() = rot * tmp * rot.transpose();
       }
       // Math of d_{X0,Y0,R,x,y} all verified by hand
@@ -862,7 +894,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
       // The following matrix will contain errors orthogonal to the rotated S
       // component only, with the Multiple Scattering properly treated!!
-      MatrixNd<N> cov_with_ms;
+      Eigen::Matrix<T, N, N> cov_with_ms;
       Scatter_cov_line(cov_sz, fast_fit, p2D.row(0), p2D.row(1), theta, B, cov_with_ms);
 #ifdef RFIT_DEBUG
       printIt(cov_sz, "line_fit - cov_sz:");
@@ -870,7 +902,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #endif
 
       // Rotate Points with the shape [2, n]
-      Matrix2xNd<N> p2D_rot = rot * p2D;
+      Eigen::Matrix<T, 2, N> p2D_rot = rot * p2D;
 
 #ifdef RFIT_DEBUG
       printf("Fast fit Tan(theta): %g\n", fast_fit(3));
@@ -882,25 +914,25 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #endif
 
       // Build the A Matrix
-      Matrix2xNd<N> A;
-      A << MatrixXd::Ones(1, n), p2D_rot.row(0);  // rotated s values
+      Eigen::Matrix<T, 2, N> A;
+      A << Eigen::Matrix<T, 1, N>::Ones(), p2D_rot.row(0);  // rotated s values
 
 #ifdef RFIT_DEBUG
       printIt(&A, "A Matrix:");
 #endif
 
       // Build A^T V-1 A, where V-1 is the covariance of only the Y components.
-      MatrixNd<N> Vy_inv;
+      Eigen::Matrix<T, N, N> Vy_inv;
       math::cholesky::invert(cov_with_ms, Vy_inv);
       // MatrixNd<N> Vy_inv = cov_with_ms.inverse();
-      Eigen::Matrix<double, 2, 2> Cov_params = A * Vy_inv * A.transpose();
+      Eigen::Matrix<T, 2, 2> Cov_params = A * Vy_inv * A.transpose();
       // Compute the Covariance Matrix of the fit parameters
       math::cholesky::invert(Cov_params, Cov_params);
 
       // Now Compute the Parameters in the form [2,1]
       // The first component is q.
       // The second component is m.
-      Eigen::Matrix<double, 2, 1> sol = Cov_params * A * Vy_inv * p2D_rot.row(1).transpose();
+      Eigen::Matrix<T, 2, 1> sol = Cov_params * A * Vy_inv * p2D_rot.row(1).transpose();
 
 #ifdef RFIT_DEBUG
       printIt(&sol, "Rotated solutions:");
@@ -908,17 +940,17 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
       // We need now to transfer back the results in the original s-z plane
       auto common_factor = 1. / (sin(theta) - sol(1, 0) * cos(theta));
-      Eigen::Matrix<double, 2, 2> J;
+      Eigen::Matrix<T, 2, 2> J;
       J << 0., common_factor * common_factor, common_factor, sol(0, 0) * cos(theta) * common_factor * common_factor;
 
-      double m = common_factor * (sol(1, 0) * sin(theta) + cos(theta));
-      double q = common_factor * sol(0, 0);
+      T m = common_factor * (sol(1, 0) * sin(theta) + cos(theta));
+      T q = common_factor * sol(0, 0);
       auto cov_mq = J * Cov_params * J.transpose();
 
-      VectorNd<N> res = p2D_rot.row(1).transpose() - A.transpose() * sol;
-      double chi2 = res.transpose() * Vy_inv * res;
+      Eigen::Matrix<T, N, 1> res = p2D_rot.row(1).transpose() - A.transpose() * sol;
+      T chi2 = res.transpose() * Vy_inv * res;
 
-      line_fit line;
+      line_fit_t<T> line;
       line.par << m, q;
       line.cov << cov_mq;
       line.chi2 = chi2;
@@ -973,7 +1005,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     template <int N>
     inline helix_fit Helix_fit(const Matrix3xNd<N>& hits,
                                const Eigen::Matrix<float, 6, N>& hits_ge,
-                               const double B,
+                               const fit_t B,
                                const bool error) {
       constexpr u_int n = N;
       VectorNd<4> rad = (hits.block(0, 0, 2, n).colwise().norm());
@@ -1,6 +1,7 @@
 #include "RiemannFitOnGPU.h"
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
@@ -17,176 +18,175 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks / 4), Vec1::all(blockSize));
 
     //  Fit internals
-    auto hitsGPU_ = cms::alpakatools::allocDeviceBuf<double>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix3xNd<4>) /
-                                                             sizeof(double));
+    // the buffers are allocated on the queue, so they can go out of scope while the fits are still running
+    auto hitsGPU_ = allocDeviceBuf<Rfit::scratch_t>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix3x4d) / sizeof(Rfit::scratch_t), queue);
 
-    auto hits_geGPU_ =
-        cms::alpakatools::allocDeviceBuf<float>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix6x4f) / sizeof(float));
+    auto hits_geGPU_ = allocDeviceBuf<float>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Matrix6x4f) / sizeof(float), queue);
 
-    auto fast_fit_resultsGPU_ =
-        cms::alpakatools::allocDeviceBuf<double>(maxNumberOfConcurrentFits_ * sizeof(Rfit::Vector4d) / sizeof(double));
+    auto fast_fit_resultsGPU_ = allocDeviceBuf<Rfit::scratch_t>(
+        maxNumberOfConcurrentFits_ * sizeof(Rfit::Vector4s) / sizeof(Rfit::scratch_t), queue);
 
     //auto circle_fit_resultsGPU_holder =
     //cms::cuda::make_device_unique<char[]>(maxNumberOfConcurrentFits_ * sizeof(Rfit::circle_fit), stream);
     //Rfit::circle_fit *circle_fit_resultsGPU_ = (Rfit::circle_fit *)(circle_fit_resultsGPU_holder.get());
-    //auto circle_fit_resultsGPU_holder = cms::alpakatools::allocDeviceBuf<char>(maxNumberOfConcurrentFits_ * sizeof(Rfit::circle_fit));
-    auto circle_fit_resultsGPU_ = cms::alpakatools::allocDeviceBuf<Rfit::circle_fit>(maxNumberOfConcurrentFits_);
+    //auto circle_fit_resultsGPU_holder = allocDeviceBuf<char>(maxNumberOfConcurrentFits_ * sizeof(Rfit::circle_fit));
+    auto circle_fit_resultsGPU_ = allocDeviceBuf<Rfit::circle_fit>(maxNumberOfConcurrentFits_, queue);
 
     for (uint32_t offset = 0; offset < maxNumberOfTuples; offset += maxNumberOfConcurrentFits_) {
       // triplets
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivTriplets,
-                                                     kernelFastFit<3>(),
-                                                     tuples_d,
-                                                     tupleMultiplicity_d,
-                                                     3,
-                                                     hv,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivTriplets,
-                                                     kernelCircleFit<3>(),
-                                                     tupleMultiplicity_d,
-                                                     3,
-                                                     bField_,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivTriplets,
-                                                     kernelLineFit<3>(),
-                                                     tupleMultiplicity_d,
-                                                     3,
-                                                     bField_,
-                                                     outputSoa_d,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                     offset));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivTriplets,
+                                            kernelFastFit<3>(),
+                                            tuples_d,
+                                            tupleMultiplicity_d,
+                                            3,
+                                            hv,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivTriplets,
+                                            kernelCircleFit<3>(),
+                                            tupleMultiplicity_d,
+                                            3,
+                                            bField_,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivTriplets,
+                                            kernelLineFit<3>(),
+                                            tupleMultiplicity_d,
+                                            3,
+                                            bField_,
+                                            outputSoa_d,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                            offset);
 
       // quads
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                     kernelFastFit<4>(),
-                                                     tuples_d,
-                                                     tupleMultiplicity_d,
-                                                     4,
-                                                     hv,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                     kernelCircleFit<4>(),
-                                                     tupleMultiplicity_d,
-                                                     4,
-                                                     bField_,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                     offset));
-
-      alpaka::enqueue(queue,
-                      alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                     kernelLineFit<4>(),
-                                                     tupleMultiplicity_d,
-                                                     4,
-                                                     bField_,
-                                                     outputSoa_d,
-                                                     alpaka::getPtrNative(hitsGPU_),
-                                                     alpaka::getPtrNative(hits_geGPU_),
-                                                     alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                     alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                     offset));
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivQuadsPenta,
+                                            kernelFastFit<4>(),
+                                            tuples_d,
+                                            tupleMultiplicity_d,
+                                            4,
+                                            hv,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivQuadsPenta,
+                                            kernelCircleFit<4>(),
+                                            tupleMultiplicity_d,
+                                            4,
+                                            bField_,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                            offset);
+
+      cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                            workDivQuadsPenta,
+                                            kernelLineFit<4>(),
+                                            tupleMultiplicity_d,
+                                            4,
+                                            bField_,
+                                            outputSoa_d,
+                                            alpaka::getPtrNative(hitsGPU_),
+                                            alpaka::getPtrNative(hits_geGPU_),
+                                            alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                            alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                            offset);
 
       if (fit5as4_) {
         // penta
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelFastFit<4>(),
-                                                       tuples_d,
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       hv,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelCircleFit<4>(),
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       bField_,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelLineFit<4>(),
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       bField_,
-                                                       outputSoa_d,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                       offset));
-        alpaka::wait(queue);
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelFastFit<4>(),
+                                              tuples_d,
+                                              tupleMultiplicity_d,
+                                              5,
+                                              hv,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelCircleFit<4>(),
+                                              tupleMultiplicity_d,
+                                              5,
+                                              bField_,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelLineFit<4>(),
+                                              tupleMultiplicity_d,
+                                              5,
+                                              bField_,
+                                              outputSoa_d,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                              offset);
       } else {
         // penta all 5
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelFastFit<5>(),
-                                                       tuples_d,
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       hv,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelCircleFit<5>(),
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       bField_,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                       offset));
-
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivQuadsPenta,
-                                                       kernelLineFit<5>(),
-                                                       tupleMultiplicity_d,
-                                                       5,
-                                                       bField_,
-                                                       outputSoa_d,
-                                                       alpaka::getPtrNative(hitsGPU_),
-                                                       alpaka::getPtrNative(hits_geGPU_),
-                                                       alpaka::getPtrNative(fast_fit_resultsGPU_),
-                                                       alpaka::getPtrNative(circle_fit_resultsGPU_),
-                                                       offset));
-        alpaka::wait(queue);
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelFastFit<5>(),
+                                              tuples_d,
+                                              tupleMultiplicity_d,
+                                              5,
+                                              hv,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelCircleFit<5>(),
+                                              tupleMultiplicity_d,
+                                              5,
+                                              bField_,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                              offset);
+
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivQuadsPenta,
+                                              kernelLineFit<5>(),
+                                              tupleMultiplicity_d,
+                                              5,
+                                              bField_,
+                                              outputSoa_d,
+                                              alpaka::getPtrNative(hitsGPU_),
+                                              alpaka::getPtrNative(hits_geGPU_),
+                                              alpaka::getPtrNative(fast_fit_resultsGPU_),
+                                              alpaka::getPtrNative(circle_fit_resultsGPU_),
+                                              offset);
       }
     }
   }
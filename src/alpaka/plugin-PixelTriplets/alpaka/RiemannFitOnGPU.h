@@ -26,9 +26,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   CAConstants::TupleMultiplicity const *__restrict__ tupleMultiplicity,
                                   uint32_t nHits,
                                   HitsOnGPU const *__restrict__ hhp,
-                                  double *__restrict__ phits,
+                                  Rfit::scratch_t *__restrict__ phits,
                                   float *__restrict__ phits_ge,
-                                  double *__restrict__ pfast_fit,
+                                  Rfit::scratch_t *__restrict__ pfast_fit,
                                   uint32_t offset) const {
       constexpr uint32_t hitsInFit = N;
 
@@ -59,7 +59,6 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         assert(foundNtuplets->size(tkid) == nHits);
 
         Rfit::Map3xNd<N> hits(phits + local_idx);
-        Rfit::Map4d fast_fit(pfast_fit + local_idx);
         Rfit::Map6xNf<N> hits_ge(phits_ge + local_idx);
 
         // Prepare data structure
@@ -76,14 +75,40 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           hits.col(i) << hhp->xGlobal(hit), hhp->yGlobal(hit), hhp->zGlobal(hit);
           hits_ge.col(i) << ge[0], ge[1], ge[2], ge[3], ge[4], ge[5];
         }
-        Rfit::Fast_fit(hits, fast_fit);
+        // on the CPU backends the fast fit is done below, on the tracks loaded by this thread
+#if !defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED && !defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        Rfit::Vector4d fast_fit;
+        Rfit::Fast_fit(hits.template cast<Rfit::fit_t>(), fast_fit);
 
         // no NaN here....
         assert(fast_fit(0) == fast_fit(0));
         assert(fast_fit(1) == fast_fit(1));
         assert(fast_fit(2) == fast_fit(2));
         assert(fast_fit(3) == fast_fit(3));
+
+        Rfit::Map4d fast_fit_s(pfast_fit + local_idx);
+        fast_fit_s = fast_fit.template cast<Rfit::scratch_t>();
+#endif
+      });
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      const auto nFits = Rfit::batched::numberOfFits(tupleMultiplicity, nHits, offset);
+      cms::alpakatools::for_each_batch_in_grid_strided<Rfit::fitLanes>(acc, nFits, [&](uint32_t first, uint32_t n) {
+        Rfit::LaneMatrix<3, N, Rfit::fitLanes> hits;
+        Rfit::batched::loadLanes(phits + first, n, hits);
+
+        Rfit::LaneMatrix<4, 1, Rfit::fitLanes> fast_fit;
+        Rfit::Fast_fit(hits, fast_fit);
+
+        for (uint32_t k = 0; k < 4; ++k) {
+          for (uint32_t l = 0; l < n; ++l) {
+            // no NaN here....
+            assert(fast_fit(k)[l] == fast_fit(k)[l]);
+            pfast_fit[first + l + k * Rfit::stride()] = fast_fit(k)[l];
+          }
+        }
       });
+#endif
 
     }  // kernel operator()
   };   // struct
@@ -95,9 +120,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   CAConstants::TupleMultiplicity const *__restrict__ tupleMultiplicity,
                                   uint32_t nHits,
                                   double B,
-                                  double *__restrict__ phits,
+                                  Rfit::scratch_t *__restrict__ phits,
                                   float *__restrict__ phits_ge,
-                                  double *__restrict__ pfast_fit_input,
+                                  Rfit::scratch_t *__restrict__ pfast_fit_input,
                                   Rfit::circle_fit *circle_fit,
                                   uint32_t offset) const {
       assert(circle_fit);
@@ -106,14 +131,44 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // same as above...
 
       // look in bin for this hit multiplicity
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      const auto nFits = Rfit::batched::numberOfFits(tupleMultiplicity, nHits, offset);
+      cms::alpakatools::for_each_batch_in_grid_strided<Rfit::fitLanes>(acc, nFits, [&](uint32_t first, uint32_t n) {
+        Rfit::LaneMatrix<3, N, Rfit::fitLanes> hits;
+        Rfit::LaneMatrix<6, N, Rfit::fitLanes> hits_ge;
+        Rfit::LaneMatrix<4, 1, Rfit::fitLanes> fast_fit;
+        Rfit::batched::loadLanes(phits + first, n, hits);
+        Rfit::batched::loadLanes(phits_ge + first, n, hits_ge);
+        Rfit::batched::loadLanes(pfast_fit_input + first, n, fast_fit);
+
+        Rfit::LaneMatrix<N, 1, Rfit::fitLanes> rad = (hits.block(0, 0, 2, N).colwise().norm());
+
+        Rfit::LaneMatrix<2 * N, 2 * N, Rfit::fitLanes> hits_cov =
+            Rfit::LaneMatrix<2 * N, 2 * N, Rfit::fitLanes>::Zero();
+        Rfit::loadCovariance2D(hits_ge, hits_cov);
+
+        auto const circle = Rfit::Circle_fit(hits.block(0, 0, 2, N), hits_cov, fast_fit, rad, B, true);
+
+        for (uint32_t l = 0; l < n; ++l) {
+          auto &fit = circle_fit[first + l];
+          fit.par = Rfit::lane(circle.par, l);
+          fit.cov = Rfit::lane(circle.cov, l);
+          fit.q = int32_t(circle.q[l]);
+          fit.chi2 = circle.chi2[l];
+        }
+      });
+#else
       const auto nt = Rfit::maxNumberOfConcurrentFits();
       cms::alpakatools::for_each_element_in_grid_strided(acc, nt, [&](uint32_t local_idx) {
         auto tuple_idx = local_idx + offset;
         if (tuple_idx >= tupleMultiplicity->size(nHits))
           return;
 
-        Rfit::Map3xNd<N> hits(phits + local_idx);
-        Rfit::Map4d fast_fit(pfast_fit_input + local_idx);
+        // the fits read the scratch buffers converted to the precision of the arithmetic
+        Rfit::Map3xNd<N> hits_s(phits + local_idx);
+        Rfit::Map4d fast_fit_s(pfast_fit_input + local_idx);
+        auto hits = hits_s.template cast<Rfit::fit_t>();
+        auto fast_fit = fast_fit_s.template cast<Rfit::fit_t>();
         Rfit::Map6xNf<N> hits_ge(phits_ge + local_idx);
 
         Rfit::VectorNd<N> rad = (hits.block(0, 0, 2, N).colwise().norm());
@@ -129,6 +184,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 //         circle_fit[local_idx].par(0), circle_fit[local_idx].par(1), circle_fit[local_idx].par(2));
 #endif
       });
+#endif
 
     }  // kernel operator()
   };   // struct
@@ -141,9 +197,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                   uint32_t nHits,
                                   double B,
                                   OutputSoA *results,
-                                  double *__restrict__ phits,
+                                  Rfit::scratch_t *__restrict__ phits,
                                   float *__restrict__ phits_ge,
-                                  double *__restrict__ pfast_fit_input,
+                                  Rfit::scratch_t *__restrict__ pfast_fit_input,
                                   Rfit::circle_fit *__restrict__ circle_fit,
                                   uint32_t offset) const {
       assert(results);
@@ -153,6 +209,45 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // same as above...
 
       // look in bin for this hit multiplicity
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      const auto nFits = Rfit::batched::numberOfFits(tupleMultiplicity, nHits, offset);
+      cms::alpakatools::for_each_batch_in_grid_strided<Rfit::fitLanes>(acc, nFits, [&](uint32_t first, uint32_t n) {
+        Rfit::LaneMatrix<3, N, Rfit::fitLanes> hits;
+        Rfit::LaneMatrix<6, N, Rfit::fitLanes> hits_ge;
+        Rfit::LaneMatrix<4, 1, Rfit::fitLanes> fast_fit;
+        Rfit::batched::loadLanes(phits + first, n, hits);
+        Rfit::batched::loadLanes(phits_ge + first, n, hits_ge);
+        Rfit::batched::loadLanes(pfast_fit_input + first, n, fast_fit);
+
+        // as in loadLanes, the unused lanes repeat the first track
+        Rfit::circle_fit_t<Rfit::Lanes<Rfit::fitLanes>> circle;
+        for (uint32_t l = 0; l < Rfit::fitLanes; ++l) {
+          auto const &fit = circle_fit[first + (l < n ? l : 0)];
+          Rfit::setLane(circle.par, l, fit.par);
+          Rfit::setLane(circle.cov, l, fit.cov);
+          circle.q[l] = fit.q;
+          circle.chi2[l] = fit.chi2;
+        }
+
+        auto const line = Rfit::Line_fit(hits, hits_ge, circle, fast_fit, B, true);
+
+        for (uint32_t l = 0; l < n; ++l) {
+          // get it for the ntuple container (one to one to helix)
+          auto tkid = *(tupleMultiplicity->begin(nHits) + first + l + offset);
+
+          auto &fit = circle_fit[first + l];
+          Rfit::fromCircleToPerigee(fit);
+
+          Rfit::Vector2d const linePar = Rfit::lane(line.par, l);
+          Rfit::Matrix2d const lineCov = Rfit::lane(line.cov, l);
+
+          results->stateAtBS.copyFromCircle(fit.par, fit.cov, linePar, lineCov, 1.f / float(B), tkid);
+          results->pt(tkid) = B / std::abs(fit.par(2));
+          results->eta(tkid) = asinhf(linePar(0));
+          results->chi2(tkid) = (fit.chi2 + line.chi2[l]) / (2 * N - 5);
+        }
+      });
+#else
       const auto nt = Rfit::maxNumberOfConcurrentFits();
       cms::alpakatools::for_each_element_in_grid_strided(acc, nt, [&](uint32_t local_idx) {
         auto tuple_idx = local_idx + offset;
@@ -162,8 +257,11 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         // get it for the ntuple container (one to one to helix)
         auto tkid = *(tupleMultiplicity->begin(nHits) + tuple_idx);
 
-        Rfit::Map3xNd<N> hits(phits + local_idx);
-        Rfit::Map4d fast_fit(pfast_fit_input + local_idx);
+        // the fits read the scratch buffers converted to the precision of the arithmetic
+        Rfit::Map3xNd<N> hits_s(phits + local_idx);
+        Rfit::Map4d fast_fit_s(pfast_fit_input + local_idx);
+        auto hits = hits_s.template cast<Rfit::fit_t>();
+        auto fast_fit = fast_fit_s.template cast<Rfit::fit_t>();
         Rfit::Map6xNf<N> hits_ge(phits_ge + local_idx);
 
         auto const &line_fit = Rfit::Line_fit(hits, hits_ge, circle_fit[local_idx], fast_fit, B, true);
@@ -195,6 +293,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                line_fit.cov(1, 1));
 #endif
       });
+#endif
 
     }  // kernel operator()
   };   // struct
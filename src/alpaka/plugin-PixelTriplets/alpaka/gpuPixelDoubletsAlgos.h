@@ -15,6 +15,7 @@
 
 #include "CAConstants.h"
 #include "GPUCACell.h"
+#include "gpuPixelDoubletsCuts.h"
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
@@ -49,10 +50,6 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // these are used if doClusterCut is true
       constexpr int minYsizeB1 = 36;
       constexpr int minYsizeB2 = 28;
-      constexpr int maxDYsize12 = 28;
-      constexpr int maxDYsize = 20;
-      constexpr int maxDYPred = 20;
-      constexpr float dzdrFact = 8 * 0.0285 / 0.015;  // from dz/dr to "DY"
 
       bool isOuterLadder = ideal_cond;
 
@@ -161,42 +158,11 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         auto mep = hh.iphi(i);
         auto mer = hh.rGlobal(i);
 
-        // all cuts: true if fails
-        constexpr float z0cut = 12.f;      // cm
-        constexpr float hardPtCut = 0.5f;  // GeV
-        constexpr float minRadius =
-            hardPtCut * 87.78f;  // cm (1 GeV track has 1 GeV/c / (e * 3.8T) ~ 87 cm radius in a 3.8T field)
-        constexpr float minRadius2T4 = 4.f * minRadius * minRadius;
-        auto ptcut = [&](int j, int16_t idphi) {
-          auto r2t4 = minRadius2T4;
-          auto ri = mer;
-          auto ro = hh.rGlobal(j);
-          auto dphi = short2phi(idphi);
-          return dphi * dphi * (r2t4 - ri * ro) > (ro - ri) * (ro - ri);
-        };
-        auto z0cutoff = [&](int j) {
-          auto zo = hh.zGlobal(j);
-          auto ro = hh.rGlobal(j);
-          auto dr = ro - mer;
-          return dr > maxr[pairLayerId] || dr < 0 || std::abs((mez * ro - mer * zo)) > z0cut * dr;
-        };
-
-        auto zsizeCut = [&](int j) {
-          auto onlyBarrel = outer < 4;
-          auto so = hh.clusterSizeY(j);
-          auto dy = inner == 0 ? maxDYsize12 : maxDYsize;
-          // in the barrel cut on difference in size
-          // in the endcap on the prediction on the first layer (actually in the barrel only: happen to be safe for endcap as well)
-          // FIXME move pred cut to z0cutoff to optmize loading of and computaiton ...
-          auto zo = hh.zGlobal(j);
-          auto ro = hh.rGlobal(j);
-          return onlyBarrel ? mes > 0 && so > 0 && std::abs(so - mes) > dy
-                            : (inner < 4) && mes > 0 &&
-                                  std::abs(mes - int(std::abs((mez - zo) / (mer - ro)) * dzdrFact + 0.5f)) > maxDYPred;
-        };
-
         auto iphicut = phicuts[pairLayerId];
 
+        // all cuts: true if fails
+        DoubletCuts const cuts{inner, outer, mez, mer, mep, mes, iphicut, maxr[pairLayerId]};
+
         auto kl = Hist::bin(int16_t(mep - iphicut));
         auto kh = Hist::bin(int16_t(mep + iphicut));
         auto incr = [](auto& k) { return k = (k + 1) % Hist::nbins(); };
@@ -210,6 +176,53 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
         auto khh = kh;
         incr(khh);
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        // On the CPU the single thread of the block processes the whole phi window. The candidate outer hits
+        // are gathered in chunks, with their detector index, z, r, iphi and cluster y size in SoA arrays; the
+        // cuts are evaluated with explicit SIMD over each chunk, and the accepted hits are compacted keeping
+        // their order: the doublets are the same, and are made in the same order, as with the loop over the
+        // bins below.
+        using namespace cpu;
+        Chunk chunk;
+
+        auto processChunk = [&]() {
+          alignas(64) uint32_t accepted[chunkSize + chunkAlignment];
+          auto const nAccepted = select(chunk, cuts, doClusterCut, doZ0Cut, doPtCut, accepted);
+
+          for (uint32_t k = 0; k < nAccepted; ++k) {
+            auto oi = accepted[k];
+            assert(oi >= offsets[outer]);
+            assert(oi < offsets[outer + 1]);
+            auto ind = alpaka::atomicAdd(acc, nCells, 1u, alpaka::hierarchy::Blocks{});
+            if (ind >= maxNumOfDoublets) {
+              alpaka::atomicSub(acc, nCells, 1u, alpaka::hierarchy::Blocks{});
+              break;
+            }
+            cells[ind].init(*cellNeighbors, *cellTracks, hh, pairLayerId, ind, i, oi);
+            isOuterHitOfCell[oi].push_back(acc, ind);
+#ifdef GPU_DEBUG
+            if (isOuterHitOfCell[oi].full())
+              ++tooMany;
+            ++tot;
+#endif
+          }
+          chunk.size = 0;
+        };
+
+        for (auto kk = kl; kk != khh; incr(kk)) {
+#ifdef GPU_DEBUG
+          if (kk != kl && kk != kh)
+            nmin += hist.size(kk + hoff);
+#endif
+          for (auto const* __restrict__ p = hist.begin(kk + hoff); p != hist.end(kk + hoff); ++p) {
+            auto oi = *p;
+            if (chunk.push_back(
+                    oi, hh.detectorIndex(oi), hh.zGlobal(oi), hh.rGlobal(oi), hh.iphi(oi), hh.clusterSizeY(oi)))
+              processChunk();
+          }
+        }
+        processChunk();
+#else
         for (auto kk = kl; kk != khh; incr(kk)) {
 #ifdef GPU_DEBUG
           if (kk != kl && kk != kh)
@@ -235,17 +248,16 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
             if (mo > 2000)
               continue;  //    invalid
 
-            if (doZ0Cut && z0cutoff(oi))
+            if (doZ0Cut && cuts.z0cutoff(hh.zGlobal(oi), hh.rGlobal(oi)))
               continue;
 
-            auto mop = hh.iphi(oi);
-            uint16_t idphi = std::min(std::abs(int16_t(mop - mep)), std::abs(int16_t(mep - mop)));
+            uint16_t idphi = cuts.idphi(hh.iphi(oi));
             if (idphi > iphicut)
               continue;
 
-            if (doClusterCut && zsizeCut(oi))
+            if (doClusterCut && cuts.zsizeCut(hh.clusterSizeY(oi), hh.zGlobal(oi), hh.rGlobal(oi)))
               continue;
-            if (doPtCut && ptcut(oi, idphi))
+            if (doPtCut && cuts.ptcut(hh.rGlobal(oi), idphi))
               continue;
 
             auto ind = alpaka::atomicAdd(acc, nCells, 1u, alpaka::hierarchy::Blocks{});
@@ -263,6 +275,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 #endif
           }
         }
+#endif
 #ifdef GPU_DEBUG
         if (tooMany > 0)
           printf("OuterHitOfCell full for %d in layer %d/%d, %d,%d %d\n", i, inner, outer, nmin, tot, tooMany);
@@ -0,0 +1,235 @@
+#ifndef RecoLocalTracker_SiPixelRecHits_plugins_gpuPixelDoubletsCuts_h
+#define RecoLocalTracker_SiPixelRecHits_plugins_gpuPixelDoubletsCuts_h
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+#include <array>
+#include <experimental/simd>
+#if defined __AVX2__ || defined __AVX512F__
+#include <immintrin.h>
+#endif
+#endif
+
+#include "AlpakaCore/alpakaConfig.h"
+#include "DataFormats/approx_atan2.h"
+
+namespace ALPAKA_ACCELERATOR_NAMESPACE {
+
+  namespace gpuPixelDoublets {
+
+    // The cuts on the outer hits of the doublets of an inner hit: all true if the doublet fails
+    struct DoubletCuts {
+      // ysize cuts (z in the barrel)  times 8
+      // these are used if doClusterCut is true
+      static constexpr int maxDYsize12 = 28;
+      static constexpr int maxDYsize = 20;
+      static constexpr int maxDYPred = 20;
+      static constexpr float dzdrFact = 8 * 0.0285 / 0.015;  // from dz/dr to "DY"
+
+      static constexpr float z0cut = 12.f;      // cm
+      static constexpr float hardPtCut = 0.5f;  // GeV
+      static constexpr float minRadius =
+          hardPtCut * 87.78f;  // cm (1 GeV track has 1 GeV/c / (e * 3.8T) ~ 87 cm radius in a 3.8T field)
+      static constexpr float minRadius2T4 = 4.f * minRadius * minRadius;
+
+      uint8_t inner;
+      uint8_t outer;
+      float mez;
+      float mer;
+      int16_t mep;
+      int16_t mes;
+      int16_t iphicut;
+      float maxr;
+
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE uint16_t idphi(int16_t mop) const {
+        return std::min(std::abs(int16_t(mop - mep)), std::abs(int16_t(mep - mop)));
+      }
+
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE bool ptcut(float ro, int16_t idphi) const {
+        auto r2t4 = minRadius2T4;
+        auto ri = mer;
+        auto dphi = short2phi(idphi);
+        return dphi * dphi * (r2t4 - ri * ro) > (ro - ri) * (ro - ri);
+      }
+
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE bool z0cutoff(float zo, float ro) const {
+        auto dr = ro - mer;
+        return dr > maxr || dr < 0 || std::abs((mez * ro - mer * zo)) > z0cut * dr;
+      }
+
+      ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE bool zsizeCut(int16_t so, float zo, float ro) const {
+        auto onlyBarrel = outer < 4;
+        auto dy = inner == 0 ? maxDYsize12 : maxDYsize;
+        // in the barrel cut on difference in size
+        // in the endcap on the prediction on the first layer (actually in the barrel only: happen to be safe for endcap as well)
+        // FIXME move pred cut to z0cutoff to optmize loading of and computaiton ...
+        return onlyBarrel ? mes > 0 && so > 0 && std::abs(so - mes) > dy
+                          : (inner < 4) && mes > 0 &&
+                                std::abs(mes - int(std::abs((mez - zo) / (mer - ro)) * dzdrFact + 0.5f)) > maxDYPred;
+      }
+    };
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+    namespace cpu {
+      namespace stdx = std::experimental;
+      using floatv = stdx::native_simd<float>;
+
+      // the candidate outer hits are processed in chunks, padded to a multiple of the widest vector
+      constexpr uint32_t chunkSize = 64;
+      constexpr uint32_t chunkAlignment = 16;
+      static_assert(chunkSize % chunkAlignment == 0 and chunkAlignment % floatv::size() == 0);
+
+#if defined __AVX2__ && !defined __AVX512F__
+      // for each 8-bit mask, the positions of its set bits packed in 3-bit fields
+      constexpr std::array<uint32_t, 256> makeCompactPermutations() {
+        std::array<uint32_t, 256> permutations{};
+        for (uint32_t mask = 0; mask < 256; ++mask) {
+          uint32_t n = 0;
+          for (uint32_t i = 0; i < 8; ++i) {
+            if (mask & (1u << i)) {
+              permutations[mask] |= i << (3 * n++);
+            }
+          }
+        }
+        return permutations;
+      }
+      constexpr auto compactPermutations = makeCompactPermutations();
+#endif
+
+      // Copies to out, keeping their order, the indices whose flag is not zero, and returns their number.
+      // n must be a multiple of chunkAlignment, and out must have room for chunkAlignment more elements.
+      inline uint32_t compact(uint32_t const* __restrict__ index,
+                              float const* __restrict__ flag,
+                              uint32_t n,
+                              uint32_t* __restrict__ out) {
+        uint32_t nOut = 0;
+#if defined __AVX512F__
+        for (uint32_t k = 0; k < n; k += 16) {
+          __mmask16 mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(flag + k), _mm512_setzero_ps(), _CMP_NEQ_OQ);
+          _mm512_mask_compressstoreu_epi32(out + nOut, mask, _mm512_loadu_si512(index + k));
+          nOut += __builtin_popcount(mask);
+        }
+#elif defined __AVX2__
+        __m256i const shifts = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+        __m256i const fields = _mm256_set1_epi32(7);
+        for (uint32_t k = 0; k < n; k += 8) {
+          int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(flag + k), _mm256_setzero_ps(), _CMP_NEQ_OQ));
+          __m256i permutation =
+              _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(compactPermutations[mask]), shifts), fields);
+          __m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + k));
+          _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + nOut), _mm256_permutevar8x32_epi32(values, permutation));
+          nOut += __builtin_popcount(mask);
+        }
+#else
+        // without AVX2 there is no variable shuffle of 32-bit lanes: compact without branches
+        for (uint32_t k = 0; k < n; ++k) {
+          out[nOut] = index[k];
+          nOut += flag[k] != 0.f;
+        }
+#endif
+        return nOut;
+      }
+
+      // A chunk of candidate outer hits, with their detector index, z, r, iphi and cluster y size in SoA arrays
+      struct Chunk {
+        alignas(64) uint32_t index[chunkSize];
+        alignas(64) float mo[chunkSize];
+        alignas(64) float zo[chunkSize];
+        alignas(64) float ro[chunkSize];
+        alignas(64) float po[chunkSize];
+        alignas(64) float so[chunkSize];
+        uint32_t size = 0;
+
+        // returns true if the chunk is full
+        bool push_back(uint32_t oi, uint16_t mo_, float zo_, float ro_, int16_t po_, int16_t so_) {
+          index[size] = oi;
+          mo[size] = mo_;
+          zo[size] = zo_;
+          ro[size] = ro_;
+          po[size] = po_;
+          so[size] = so_;
+          return ++size == chunkSize;
+        }
+      };
+
+      // Evaluates the cuts with explicit SIMD over the hits of the chunk, and copies to accepted, keeping their
+      // order, the indices of the hits that pass them: they are the same as with the per-hit cuts of the GPU path.
+      // accepted must have room for chunkSize + chunkAlignment elements. Returns the number of accepted hits.
+      inline uint32_t select(Chunk& chunk,
+                             DoubletCuts const& cuts,
+                             bool doClusterCut,
+                             bool doZ0Cut,
+                             bool doPtCut,
+                             uint32_t* __restrict__ accepted) {
+        // pad the chunk with candidates that fail the cut on the detector index
+        uint32_t const nPadded = (chunk.size + chunkAlignment - 1) / chunkAlignment * chunkAlignment;
+        for (uint32_t k = chunk.size; k < nPadded; ++k) {
+          chunk.index[k] = 0;
+          chunk.mo[k] = std::numeric_limits<uint16_t>::max();
+          chunk.zo[k] = chunk.ro[k] = chunk.po[k] = chunk.so[k] = 0.f;
+        }
+
+        auto const mez = cuts.mez;
+        auto const mer = cuts.mer;
+        auto const mes = cuts.mes;
+        auto const onlyBarrel = cuts.outer < 4;
+        auto const dy = cuts.inner == 0 ? DoubletCuts::maxDYsize12 : DoubletCuts::maxDYsize;
+
+        alignas(64) float accept[chunkSize];
+        for (uint32_t k = 0; k < nPadded; k += floatv::size()) {
+          floatv const vmo(chunk.mo + k, stdx::element_aligned);
+          floatv const vzo(chunk.zo + k, stdx::element_aligned);
+          floatv const vro(chunk.ro + k, stdx::element_aligned);
+          floatv const vpo(chunk.po + k, stdx::element_aligned);
+
+          // same as idphi(), the smaller of the int16_t differences of the iphi
+          floatv dp = vpo - float(cuts.mep);
+          where(dp > 32767.f, dp) -= 65536.f;
+          where(dp < -32768.f, dp) += 65536.f;
+          floatv const idphi = abs(dp);
+
+          auto pass = (vmo <= 2000.f) && (idphi <= float(cuts.iphicut));
+          if (doZ0Cut) {
+            // same as z0cutoff()
+            floatv const dr = vro - mer;
+            pass = pass && !((dr > cuts.maxr) || (dr < 0.f) || (abs(mez * vro - mer * vzo) > DoubletCuts::z0cut * dr));
+          }
+          if (doClusterCut) {
+            // same as zsizeCut(); the conversion of inf and NaN to int, undefined, is avoided
+            if (onlyBarrel) {
+              if (mes > 0) {
+                floatv const vso(chunk.so + k, stdx::element_aligned);
+                pass = pass && !((vso > 0.f) && (abs(vso - float(mes)) > float(dy)));
+              }
+            } else if (cuts.inner < 4 && mes > 0) {
+              floatv pred = abs((mez - vzo) / (mer - vro)) * DoubletCuts::dzdrFact + 0.5f;
+              where(!(pred < 1.e6f), pred) = 1.e6f;
+              // abs(mes - int(pred)) > maxDYPred, with pred >= 0.5
+              pass = pass && !((pred >= float(mes + DoubletCuts::maxDYPred + 1)) ||
+                               (pred < float(mes - DoubletCuts::maxDYPred)));
+            }
+          }
+          if (doPtCut) {
+            // same as ptcut()
+            floatv const dphi = idphi * short2phi(1);
+            pass = pass && !(dphi * dphi * (DoubletCuts::minRadius2T4 - mer * vro) > (vro - mer) * (vro - mer));
+          }
+
+          floatv flag(0.f);
+          where(pass, flag) = 1.f;
+          flag.copy_to(accept + k, stdx::element_aligned);
+        }
+
+        return compact(chunk.index, accept, nPadded, accepted);
+      }
+    }  // namespace cpu
+#endif
+
+  }  // namespace gpuPixelDoublets
+}  // namespace ALPAKA_ACCELERATOR_NAMESPACE
+
+#endif  // RecoLocalTracker_SiPixelRecHits_plugins_gpuPixelDoubletsCuts_h
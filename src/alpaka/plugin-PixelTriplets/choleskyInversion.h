@@ -343,6 +343,14 @@ namespace math {
       Inverter<M1, M2, M2::ColsAtCompileTime>::eval(src, dst);
     }
 
+    // interface for any other matrix type with an operator()(i, j), e.g. a matrix of SIMD lanes
+    // that inverts several independent matrices at once
+    template <int N, typename M1, typename M2>
+    inline constexpr void invert(M1 const& src, M2& dst) {
+      static_assert(N <= 6, "only matrices up to 6x6 can be inverted without Eigen");
+      Inverter<M1, M2, N>::eval(src, dst);
+    }
+
   }  // namespace cholesky
 }  // namespace math
 
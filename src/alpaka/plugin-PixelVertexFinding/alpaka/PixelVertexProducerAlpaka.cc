@@ -1,4 +1,5 @@
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 #include "AlpakaDataFormats/PixelTrackAlpaka.h"
 #include "AlpakaDataFormats/ZVertexAlpaka.h"
@@ -11,14 +12,19 @@
 
 #include "gpuVertexFinder.h"
 
+#include <optional>
+
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class PixelVertexProducerAlpaka : public edm::EDProducer {
+  class PixelVertexProducerAlpaka : public edm::EDProducerExternalWork {
   public:
     explicit PixelVertexProducerAlpaka(edm::ProductRegistry& reg);
     ~PixelVertexProducerAlpaka() override = default;
 
   private:
+    void acquire(const edm::Event& iEvent,
+                 const edm::EventSetup& iSetup,
+                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
     edm::EDGetTokenT<PixelTrackAlpaka> tokenTrack_;
@@ -28,6 +34,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     // Tracking cuts before sending tracks to vertex algo
     const float m_ptMin;
+
+    Queue queue_;
+    std::optional<ZVertexAlpaka> vertices_;
   };
 
   PixelVertexProducerAlpaka::PixelVertexProducerAlpaka(edm::ProductRegistry& reg)
@@ -42,15 +51,23 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                   0.01,   // errmax
                   9       // chi2max
                   ),
-        m_ptMin(0.5)  // 0.5 GeV
-  {}
+        m_ptMin(0.5),  // 0.5 GeV
+        queue_(device) {}
 
-  void PixelVertexProducerAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  void PixelVertexProducerAlpaka::acquire(const edm::Event& iEvent,
+                                          const edm::EventSetup& iSetup,
+                                          edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
     auto const& tracksBuf = iEvent.get(tokenTrack_);
     auto const tracks = alpaka::getPtrNative(tracksBuf);
 
-    Queue queue(device);
-    iEvent.emplace(tokenVertex_, m_gpuAlgo.makeAsync(tracks, m_ptMin, queue));
+    vertices_.emplace(m_gpuAlgo.makeAsync(tracks, m_ptMin, queue_));
+
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
+  }
+
+  void PixelVertexProducerAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+    iEvent.emplace(tokenVertex_, std::move(*vertices_));
+    vertices_.reset();
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
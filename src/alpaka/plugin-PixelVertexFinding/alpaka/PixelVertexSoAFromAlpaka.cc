@@ -1,4 +1,5 @@
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaDataFormats/ZVertexAlpaka.h"
 #include "Framework/EventSetup.h"
 #include "Framework/Event.h"
@@ -6,28 +7,27 @@
 #include "Framework/EDProducer.h"
 #include "Framework/RunningAverage.h"
 
+#include <optional>
+
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class PixelVertexSoAFromAlpaka : public edm::EDProducer {
+  class PixelVertexSoAFromAlpaka : public edm::EDProducerExternalWork {
   public:
     explicit PixelVertexSoAFromAlpaka(edm::ProductRegistry& reg);
     ~PixelVertexSoAFromAlpaka() override = default;
 
   private:
-#ifdef TODO
     void acquire(edm::Event const& iEvent,
                  edm::EventSetup const& iSetup,
                  edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
-#endif
     void produce(edm::Event& iEvent, edm::EventSetup const& iSetup) override;
 
     edm::EDGetTokenT<ZVertexAlpaka> tokenAlpaka_;
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
     edm::EDPutTokenT<ZVertexHost> tokenSOA_;
-#endif
 
-#ifdef TODO
-    cms::cuda::host::unique_ptr<ZVertexSoA> m_soa;
+    Queue queue_;
+    std::optional<ZVertexHost> m_soa;
 #endif
   };
 
@@ -35,33 +35,29 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       : tokenAlpaka_(reg.consumes<ZVertexAlpaka>())
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
         ,
-        tokenSOA_(reg.produces<ZVertexHost>())
+        tokenSOA_(reg.produces<ZVertexHost>()),
+        queue_(device)
 #endif
   {
   }
 
-#ifdef TODO
   void PixelVertexSoAFromAlpaka::acquire(edm::Event const& iEvent,
                                          edm::EventSetup const& iSetup,
                                          edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
-    auto const& inputDataWrapped = iEvent.get(tokenAlpaka_);
-    cms::cuda::ScopedContextAcquire ctx{inputDataWrapped, std::move(waitingTaskHolder)};
-    auto const& inputData = ctx.get(inputDataWrapped);
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+    auto const& inputData = iEvent.get(tokenAlpaka_);
+    m_soa.emplace(allocHostBuf<ZVertexSoA>(1u));
+    alpaka::memcpy(queue_, *m_soa, inputData, 1u);
 
-    m_soa = inputData.toHostAsync(ctx.stream());
-  }
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
 #endif
+  }
 
   void PixelVertexSoAFromAlpaka::produce(edm::Event& iEvent, edm::EventSetup const& iSetup) {
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-    auto const& inputData = iEvent.get(tokenAlpaka_);
-    auto outputData = cms::alpakatools::allocHostBuf<ZVertexSoA>(1u);
-    Queue queue(device);
-    alpaka::memcpy(queue, outputData, inputData, 1u);
-    alpaka::wait(queue);
-
     // No copies....
-    iEvent.emplace(tokenSOA_, std::move(outputData));
+    iEvent.emplace(tokenSOA_, std::move(*m_soa));
+    m_soa.reset();
 #endif
   }
 
@@ -1,4 +1,5 @@
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 #include "gpuVertexFinder.h"
 #include "gpuClusterTracksByDensity.h"
@@ -106,11 +107,12 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // std::cout << "producing Vertices on GPU" << std::endl;
       assert(tksoa);
 
-      ZVertexAlpaka vertices{cms::alpakatools::allocDeviceBuf<ZVertexSoA>(1u)};
+      ZVertexAlpaka vertices{allocDeviceBuf<ZVertexSoA>(1u)};
       auto* soa = alpaka::getPtrNative(vertices);
       assert(soa);
 
-      auto ws_dBuf{cms::alpakatools::allocDeviceBuf<WorkSpace>(1u)};
+      // the workspace is associated with the queue, so it can go out of scope before the kernels have run
+      auto ws_dBuf{allocDeviceBuf<WorkSpace>(1u, queue)};
       auto ws_d = alpaka::getPtrNative(ws_dBuf);
 
       auto nvFinalVerticesView = cms::alpakatools::createDeviceView<uint32_t>(&soa->nvFinal, 1u);
@@ -124,7 +126,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       const uint32_t numberOfBlocks = (TkSoA::stride() + blockSize - 1) / blockSize;
       const WorkDiv1 loadTracksWorkDiv =
           cms::alpakatools::make_workdiv(Vec1::all(numberOfBlocks), Vec1::all(blockSize));
-      alpaka::enqueue(queue, alpaka::createTaskKernel<Acc1>(loadTracksWorkDiv, loadTracks(), tksoa, soa, ws_d, ptMin));
+      cms::alpakatools::enqueueKernel<Acc1>(queue, loadTracksWorkDiv, loadTracks(), tksoa, soa, ws_d, ptMin);
 
       const WorkDiv1 finderSorterWorkDiv = cms::alpakatools::make_workdiv(Vec1::all(1), Vec1::all(1024 - 256));
       const WorkDiv1 splitterFitterWorkDiv = cms::alpakatools::make_workdiv(Vec1::all(1024), Vec1::all(128));
@@ -132,51 +134,40 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       if (oneKernel_) {
         // implemented only for density clustesrs
 #ifndef THREE_KERNELS
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(
-                            finderSorterWorkDiv, vertexFinderOneKernel(), soa, ws_d, minT, eps, errmax, chi2max));
+        cms::alpakatools::enqueueKernel<Acc1>(
+            queue, finderSorterWorkDiv, vertexFinderOneKernel(), soa, ws_d, minT, eps, errmax, chi2max);
 
 #else
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(
-                            finderSorterWorkDiv, vertexFinderKernel1(), soa, ws_d, minT, eps, errmax, chi2max));
+        cms::alpakatools::enqueueKernel<Acc1>(
+            queue, finderSorterWorkDiv, vertexFinderKernel1(), soa, ws_d, minT, eps, errmax, chi2max);
         // one block per vertex...
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(splitterFitterWorkDiv, splitVerticesKernel(), soa, ws_d, 9.f));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, splitterFitterWorkDiv, splitVerticesKernel(), soa, ws_d, 9.f);
 
-        alpaka::enqueue(queue, alpaka::createTaskKernel<Acc1>(finderSorterWorkDiv, vertexFinderKernel2(), soa, ws_d));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, finderSorterWorkDiv, vertexFinderKernel2(), soa, ws_d);
 #endif
 
       } else {  // five kernels
 
         if (useDensity_) {
-          alpaka::enqueue(
-              queue,
-              alpaka::createTaskKernel<Acc1>(
-                  finderSorterWorkDiv, clusterTracksByDensityKernel(), soa, ws_d, minT, eps, errmax, chi2max));
+          cms::alpakatools::enqueueKernel<Acc1>(
+              queue, finderSorterWorkDiv, clusterTracksByDensityKernel(), soa, ws_d, minT, eps, errmax, chi2max);
         } else if (useDBSCAN_) {
-          alpaka::enqueue(queue,
-                          alpaka::createTaskKernel<Acc1>(
-                              finderSorterWorkDiv, clusterTracksDBSCAN(), soa, ws_d, minT, eps, errmax, chi2max));
+          cms::alpakatools::enqueueKernel<Acc1>(
+              queue, finderSorterWorkDiv, clusterTracksDBSCAN(), soa, ws_d, minT, eps, errmax, chi2max);
         } else if (useIterative_) {
-          alpaka::enqueue(queue,
-                          alpaka::createTaskKernel<Acc1>(
-                              finderSorterWorkDiv, clusterTracksIterative(), soa, ws_d, minT, eps, errmax, chi2max));
+          cms::alpakatools::enqueueKernel<Acc1>(
+              queue, finderSorterWorkDiv, clusterTracksIterative(), soa, ws_d, minT, eps, errmax, chi2max);
         }
 
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(finderSorterWorkDiv, fitVerticesKernel(), soa, ws_d, 50.));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, finderSorterWorkDiv, fitVerticesKernel(), soa, ws_d, 50.);
         // one block per vertex...
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(splitterFitterWorkDiv, splitVerticesKernel(), soa, ws_d, 9.f));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, splitterFitterWorkDiv, splitVerticesKernel(), soa, ws_d, 9.f);
 
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(finderSorterWorkDiv, fitVerticesKernel(), soa, ws_d, 5000.));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, finderSorterWorkDiv, fitVerticesKernel(), soa, ws_d, 5000.);
 
-        alpaka::enqueue(queue, alpaka::createTaskKernel<Acc1>(finderSorterWorkDiv, sortByPt2Kernel(), soa, ws_d));
+        cms::alpakatools::enqueueKernel<Acc1>(queue, finderSorterWorkDiv, sortByPt2Kernel(), soa, ws_d);
       }
 
-      alpaka::wait(queue);
       return vertices;
     }
 
@@ -4,6 +4,7 @@
 #include "DataFormats/FEDTrailer.h"
 
 #include <bitset>
+#include <cstring>
 #include <sstream>
 #include <iostream>
 
@@ -31,25 +32,32 @@ namespace {
   constexpr ErrorChecker::Word32 LINK_mask = ~(~ErrorChecker::Word32(0) << LINK_bits);
   constexpr ErrorChecker::Word32 ROC_mask = ~(~ErrorChecker::Word32(0) << ROC_bits);
   constexpr ErrorChecker::Word32 OMIT_ERR_mask = ~(~ErrorChecker::Word32(0) << OMIT_ERR_bits);
+
+  // read a 64-bit word that may not be aligned to 8 bytes
+  ErrorChecker::Word64 readWord64(const unsigned char* word) {
+    ErrorChecker::Word64 value;
+    std::memcpy(&value, word, sizeof(value));
+    return value;
+  }
 }  // namespace
 
 ErrorChecker::ErrorChecker() { includeErrors = false; }
 
-bool ErrorChecker::checkCRC(bool& errorsInEvent, int fedId, const Word64* trailer, Errors& errors) {
-  int CRC_BIT = (*trailer >> CRC_shift) & CRC_mask;
+bool ErrorChecker::checkCRC(bool& errorsInEvent, int fedId, const unsigned char* trailer, Errors& errors) {
+  int CRC_BIT = (readWord64(trailer) >> CRC_shift) & CRC_mask;
   if (CRC_BIT == 0)
     return true;
   errorsInEvent = true;
   if (includeErrors) {
     int errorType = 39;
-    SiPixelRawDataError error(*trailer, errorType, fedId);
+    SiPixelRawDataError error(readWord64(trailer), errorType, fedId);
     errors[dummyDetId].push_back(error);
   }
   return false;
 }
 
-bool ErrorChecker::checkHeader(bool& errorsInEvent, int fedId, const Word64* header, Errors& errors) {
-  FEDHeader fedHeader(reinterpret_cast<const unsigned char*>(header));
+bool ErrorChecker::checkHeader(bool& errorsInEvent, int fedId, const unsigned char* header, Errors& errors) {
+  FEDHeader fedHeader(header);
   if (!fedHeader.check())
     return false;  // throw exception?
   if (fedHeader.sourceID() != fedId) {
@@ -58,7 +66,7 @@ bool ErrorChecker::checkHeader(bool& errorsInEvent, int fedId, const Word64* hea
     errorsInEvent = true;
     if (includeErrors) {
       int errorType = 32;
-      SiPixelRawDataError error(*header, errorType, fedId);
+      SiPixelRawDataError error(readWord64(header), errorType, fedId);
       errors[dummyDetId].push_back(error);
     }
   }
@@ -66,12 +74,12 @@ bool ErrorChecker::checkHeader(bool& errorsInEvent, int fedId, const Word64* hea
 }
 
 bool ErrorChecker::checkTrailer(
-    bool& errorsInEvent, int fedId, unsigned int nWords, const Word64* trailer, Errors& errors) {
-  FEDTrailer fedTrailer(reinterpret_cast<const unsigned char*>(trailer));
+    bool& errorsInEvent, int fedId, unsigned int nWords, const unsigned char* trailer, Errors& errors) {
+  FEDTrailer fedTrailer(trailer);
   if (!fedTrailer.check()) {
     if (includeErrors) {
       int errorType = 33;
-      SiPixelRawDataError error(*trailer, errorType, fedId);
+      SiPixelRawDataError error(readWord64(trailer), errorType, fedId);
       errors[dummyDetId].push_back(error);
     }
     errorsInEvent = true;
@@ -83,7 +91,7 @@ bool ErrorChecker::checkTrailer(
     errorsInEvent = true;
     if (includeErrors) {
       int errorType = 34;
-      SiPixelRawDataError error(*trailer, errorType, fedId);
+      SiPixelRawDataError error(readWord64(trailer), errorType, fedId);
       errors[dummyDetId].push_back(error);
     }
   }
@@ -20,11 +20,13 @@ public:
 
   ErrorChecker();
 
-  bool checkCRC(bool& errorsInEvent, int fedId, const Word64* trailer, Errors& errors);
+  // The header and trailer words are passed as bytes, as the FED data are only required to be 4-byte aligned
+  // (e.g. in a memory-mapped raw data file).
+  bool checkCRC(bool& errorsInEvent, int fedId, const unsigned char* trailer, Errors& errors);
 
-  bool checkHeader(bool& errorsInEvent, int fedId, const Word64* header, Errors& errors);
+  bool checkHeader(bool& errorsInEvent, int fedId, const unsigned char* header, Errors& errors);
 
-  bool checkTrailer(bool& errorsInEvent, int fedId, unsigned int nWords, const Word64* trailer, Errors& errors);
+  bool checkTrailer(bool& errorsInEvent, int fedId, unsigned int nWords, const unsigned char* trailer, Errors& errors);
 
 private:
   bool includeErrors;
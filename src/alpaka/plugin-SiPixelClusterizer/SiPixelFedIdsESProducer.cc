@@ -18,13 +18,15 @@ private:
 };
 
 void SiPixelFedIdsESProducer::produce(edm::EventSetup& eventSetup) {
-  std::ifstream in(data_ / "fedIds.bin", std::ios::binary);
-  in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
-  unsigned int nfeds;
-  in.read(reinterpret_cast<char*>(&nfeds), sizeof(unsigned));
-  std::vector<unsigned int> fedIds(nfeds);
-  in.read(reinterpret_cast<char*>(fedIds.data()), sizeof(unsigned int) * nfeds);
-  eventSetup.put(std::make_unique<SiPixelFedIds>(std::move(fedIds)));
+  eventSetup.putLazy<SiPixelFedIds>([filename = data_ / "fedIds.bin"]() {
+    std::ifstream in(filename, std::ios::binary);
+    in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
+    unsigned int nfeds;
+    in.read(reinterpret_cast<char*>(&nfeds), sizeof(unsigned));
+    std::vector<unsigned int> fedIds(nfeds);
+    in.read(reinterpret_cast<char*>(fedIds.data()), sizeof(unsigned int) * nfeds);
+    return std::make_unique<SiPixelFedIds>(std::move(fedIds));
+  });
 }
 
 DEFINE_FWK_EVENTSETUP_MODULE(SiPixelFedIdsESProducer);
@@ -3,10 +3,10 @@
 #include "Framework/ESProducer.h"
 #include "Framework/EventSetup.h"
 #include "Framework/ESPluginFactory.h"
+#include "Framework/MappedFile.h"
 
 #include "AlpakaCore/alpakaCommon.h"
 
-#include <fstream>
 #include <memory>
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -20,29 +20,43 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   };
 
   void SiPixelFedCablingMapESProducer::produce(edm::EventSetup& eventSetup) {
-    std::ifstream in((data_ + "/cablingMap.bin").c_str(), std::ios::binary);
-    in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
-    SiPixelFedCablingMapGPU obj;
-    in.read(reinterpret_cast<char*>(&obj), sizeof(SiPixelFedCablingMapGPU));
-    unsigned int modToUnpDefSize;
-    in.read(reinterpret_cast<char*>(&modToUnpDefSize), sizeof(unsigned int));
-    std::vector<unsigned char> modToUnpDefault(modToUnpDefSize);
-    in.read(reinterpret_cast<char*>(modToUnpDefault.data()), modToUnpDefSize);
+    // The two products are made independently, each copying its part of the mapped file to the device.
+    // The host views point to the mapped memory, that is only read.
+    eventSetup.putLazy<SiPixelFedCablingMapGPUWrapper>([filename = data_ + "/cablingMap.bin"]() {
+      edm::MappedFile file(filename);
+      edm::MappedFileReader reader(file);
+      auto const* obj = reader.view<SiPixelFedCablingMapGPU>(1u);
 
-    Queue queue(device);
+      Queue queue(device);
 
-    auto cablingMap_h{cms::alpakatools::createHostView<SiPixelFedCablingMapGPU>(&obj, 1u)};
-    auto cablingMap_d{cms::alpakatools::allocDeviceBuf<SiPixelFedCablingMapGPU>(1u)};
-    alpaka::memcpy(queue, cablingMap_d, cablingMap_h, 1u);
-    eventSetup.put(std::make_unique<SiPixelFedCablingMapGPUWrapper>(std::move(cablingMap_d), true));
+      auto cablingMap_h{
+          cms::alpakatools::createHostView<SiPixelFedCablingMapGPU>(const_cast<SiPixelFedCablingMapGPU*>(obj), 1u)};
+      auto cablingMap_d{allocDeviceBuf<SiPixelFedCablingMapGPU>(1u)};
+      alpaka::memcpy(queue, cablingMap_d, cablingMap_h, 1u);
 
-    auto modToUnp_h{cms::alpakatools::createHostView<unsigned char>(modToUnpDefault.data(), modToUnpDefSize)};
-    auto modToUnp_d{cms::alpakatools::allocDeviceBuf<unsigned char>(modToUnpDefSize)};
-    alpaka::memcpy(queue, modToUnp_d, modToUnp_h, modToUnpDefSize);
+      alpaka::wait(queue);
 
-    alpaka::wait(queue);
+      return std::make_unique<SiPixelFedCablingMapGPUWrapper>(std::move(cablingMap_d), true);
+    });
 
-    eventSetup.put(std::make_unique<AlpakaDeviceBuf<unsigned char>>(std::move(modToUnp_d)));
+    eventSetup.putLazy<AlpakaDeviceBuf<unsigned char>>([filename = data_ + "/cablingMap.bin"]() {
+      edm::MappedFile file(filename);
+      edm::MappedFileReader reader(file);
+      reader.view<SiPixelFedCablingMapGPU>(1u);  // skip the cabling map
+      auto const modToUnpDefSize = reader.read<unsigned int>();
+      auto const* modToUnpDefault = reader.view<unsigned char>(modToUnpDefSize);
+
+      Queue queue(device);
+
+      auto modToUnp_h{cms::alpakatools::createHostView<unsigned char>(const_cast<unsigned char*>(modToUnpDefault),
+                                                                        modToUnpDefSize)};
+      auto modToUnp_d{allocDeviceBuf<unsigned char>(modToUnpDefSize)};
+      alpaka::memcpy(queue, modToUnp_d, modToUnp_h, modToUnpDefSize);
+
+      alpaka::wait(queue);
+
+      return std::make_unique<AlpakaDeviceBuf<unsigned char>>(std::move(modToUnp_d));
+    });
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
@@ -2,10 +2,10 @@
 #include "Framework/ESProducer.h"
 #include "Framework/EventSetup.h"
 #include "Framework/ESPluginFactory.h"
+#include "Framework/MappedFile.h"
 
 #include "AlpakaCore/alpakaCommon.h"
 
-#include <fstream>
 #include <memory>
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
@@ -33,36 +33,38 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
   };
 
   void SiPixelGainCalibrationForHLTESProducer::produce(edm::EventSetup& eventSetup) {
-    std::ifstream in((data_ + "/gain.bin").c_str(), std::ios::binary);
-    in.exceptions(std::ifstream::badbit | std::ifstream::failbit | std::ifstream::eofbit);
-    SiPixelGainForHLTonGPUBinary gain;
-    in.read(reinterpret_cast<char*>(&gain), sizeof(SiPixelGainForHLTonGPUBinary));
-    unsigned int nbytes;
-    in.read(reinterpret_cast<char*>(&nbytes), sizeof(unsigned int));
-    std::vector<char> gainData(nbytes);
-    in.read(gainData.data(), nbytes);
-
-    Queue queue(device);
-
-    const uint32_t numDecodingStructures = gainData.size() / sizeof(SiPixelGainForHLTonGPU_DecodingStructure);
-    auto ped_h{cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::DecodingStructure>(
-        reinterpret_cast<SiPixelGainForHLTonGPU::DecodingStructure*>(gainData.data()), numDecodingStructures)};
-    auto ped_d{cms::alpakatools::allocDeviceBuf<SiPixelGainForHLTonGPU::DecodingStructure>(numDecodingStructures)};
-    alpaka::memcpy(queue, ped_d, ped_h, numDecodingStructures);
-
-    auto rangeAndCols_h{
-        cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::RangeAndCols>(gain.rangeAndCols, 2000u)};
-    auto rangeAndCols_d{cms::alpakatools::allocDeviceBuf<SiPixelGainForHLTonGPU::RangeAndCols>(2000u)};
-    alpaka::memcpy(queue, rangeAndCols_d, rangeAndCols_h, 2000u);
-
-    auto fields_h{cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::Fields>(&gain.fields_, 1u)};
-    auto fields_d{cms::alpakatools::allocDeviceBuf<SiPixelGainForHLTonGPU::Fields>(1u)};
-    alpaka::memcpy(queue, fields_d, fields_h, 1u);
-
-    alpaka::wait(queue);
-
-    eventSetup.put(
-        std::make_unique<SiPixelGainForHLTonGPU>(std::move(ped_d), std::move(rangeAndCols_d), std::move(fields_d)));
+    eventSetup.putLazy<SiPixelGainForHLTonGPU>([filename = data_ + "/gain.bin"]() {
+      // The host views point to the mapped memory, that is only read.
+      // The pointer to the pedestals stored in the file is not used.
+      edm::MappedFile file(filename);
+      edm::MappedFileReader reader(file);
+      auto const* gain = reader.view<SiPixelGainForHLTonGPUBinary>(1u);
+      auto const nbytes = reader.read<unsigned int>();
+      auto const* gainData = reader.view<SiPixelGainForHLTonGPU::DecodingStructure>(
+          nbytes / sizeof(SiPixelGainForHLTonGPU::DecodingStructure));
+
+      Queue queue(device);
+
+      const uint32_t numDecodingStructures = nbytes / sizeof(SiPixelGainForHLTonGPU_DecodingStructure);
+      auto ped_h{cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::DecodingStructure>(
+          const_cast<SiPixelGainForHLTonGPU::DecodingStructure*>(gainData), numDecodingStructures)};
+      auto ped_d{allocDeviceBuf<SiPixelGainForHLTonGPU::DecodingStructure>(numDecodingStructures)};
+      alpaka::memcpy(queue, ped_d, ped_h, numDecodingStructures);
+
+      auto rangeAndCols_h{cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::RangeAndCols>(
+          const_cast<SiPixelGainForHLTonGPU::RangeAndCols*>(gain->rangeAndCols), 2000u)};
+      auto rangeAndCols_d{allocDeviceBuf<SiPixelGainForHLTonGPU::RangeAndCols>(2000u)};
+      alpaka::memcpy(queue, rangeAndCols_d, rangeAndCols_h, 2000u);
+
+      auto fields_h{cms::alpakatools::createHostView<SiPixelGainForHLTonGPU::Fields>(
+          const_cast<SiPixelGainForHLTonGPU::Fields*>(&gain->fields_), 1u)};
+      auto fields_d{allocDeviceBuf<SiPixelGainForHLTonGPU::Fields>(1u)};
+      alpaka::memcpy(queue, fields_d, fields_h, 1u);
+
+      alpaka::wait(queue);
+
+      return std::make_unique<SiPixelGainForHLTonGPU>(std::move(ped_d), std::move(rangeAndCols_d), std::move(fields_d));
+    });
   }
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
 
@@ -17,6 +17,7 @@
 #include "SiPixelRawToClusterGPUKernel.h"
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 
 #include <memory>
 #include <string>
@@ -24,12 +25,15 @@
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class SiPixelRawToCluster : public edm::EDProducer {
+  class SiPixelRawToCluster : public edm::EDProducerExternalWork {
   public:
     explicit SiPixelRawToCluster(edm::ProductRegistry& reg);
     ~SiPixelRawToCluster() override = default;
 
   private:
+    void acquire(const edm::Event& iEvent,
+                 const edm::EventSetup& iSetup,
+                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
     edm::EDGetTokenT<FEDRawDataCollection> rawGetToken_;
@@ -40,6 +44,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     pixelgpudetails::SiPixelRawToClusterGPUKernel gpuAlgo_;
     std::unique_ptr<pixelgpudetails::SiPixelRawToClusterGPUKernel::WordFedAppender> wordFedAppender_;
     PixelFormatterErrors errors_;
+    Queue queue_;
 
     const bool isRun2_;
     const bool includeErrors_;
@@ -50,6 +55,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       : rawGetToken_(reg.consumes<FEDRawDataCollection>()),
         digiPutToken_(reg.produces<SiPixelDigisAlpaka>()),
         clusterPutToken_(reg.produces<SiPixelClustersAlpaka>()),
+        queue_(device),
         isRun2_(true),
         includeErrors_(true),
         useQuality_(true) {
@@ -60,7 +66,9 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     wordFedAppender_ = std::make_unique<pixelgpudetails::SiPixelRawToClusterGPUKernel::WordFedAppender>();
   }
 
-  void SiPixelRawToCluster::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
+  void SiPixelRawToCluster::acquire(const edm::Event& iEvent,
+                                    const edm::EventSetup& iSetup,
+                                    edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
     auto const& hgpuMap = iSetup.get<SiPixelFedCablingMapGPUWrapper>();
     if (hgpuMap.hasQuality() != useQuality_) {
       throw std::runtime_error("UseQuality of the module (" + std::to_string(useQuality_) +
@@ -76,6 +84,7 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     const auto& buffers = iEvent.get(rawGetToken_);
 
     errors_.clear();
+    wordFedAppender_->clear();
 
     // GPU specific: Data extraction for RawToDigi GPU
     unsigned int wordCounterGPU = 0;
@@ -104,32 +113,32 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       }
 
       // check CRC bit
-      const uint64_t* trailer = reinterpret_cast<const uint64_t*>(rawData.data()) + (nWords - 1);
+      // the FED data may be only 4-byte aligned, so the 64-bit header and trailer words are addressed as bytes
+      constexpr size_t wordSize = sizeof(uint64_t);
+      const unsigned char* trailer = rawData.data() + (nWords - 1) * wordSize;
       if (not errorcheck.checkCRC(errorsInEvent, fedId, trailer, errors_)) {
         continue;
       }
 
       // check headers
-      const uint64_t* header = reinterpret_cast<const uint64_t*>(rawData.data());
-      header--;
-      bool moreHeaders = true;
+      const unsigned char* header = rawData.data();
+      bool moreHeaders = errorcheck.checkHeader(errorsInEvent, fedId, header, errors_);
       while (moreHeaders) {
-        header++;
-        bool headerStatus = errorcheck.checkHeader(errorsInEvent, fedId, header, errors_);
-        moreHeaders = headerStatus;
+        header += wordSize;
+        moreHeaders = errorcheck.checkHeader(errorsInEvent, fedId, header, errors_);
       }
 
       // check trailers
       bool moreTrailers = true;
-      trailer++;
+      trailer += wordSize;
       while (moreTrailers) {
-        trailer--;
+        trailer -= wordSize;
         bool trailerStatus = errorcheck.checkTrailer(errorsInEvent, fedId, nWords, trailer, errors_);
         moreTrailers = trailerStatus;
       }
 
-      const uint32_t* bw = (const uint32_t*)(header + 1);
-      const uint32_t* ew = (const uint32_t*)(trailer);
+      const uint32_t* bw = reinterpret_cast<const uint32_t*>(header + wordSize);
+      const uint32_t* ew = reinterpret_cast<const uint32_t*>(trailer);
 
       assert(0 == (ew - bw) % 2);
       wordFedAppender_->initializeWordFed(fedId, wordCounterGPU, bw, (ew - bw));
@@ -137,7 +146,6 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     }  // end of for loop
 
-    Queue queue(device);
     gpuAlgo_.makeClustersAsync(isRun2_,
                                gpuMap,
                                gpuModulesToUnpack,
@@ -149,11 +157,13 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
                                useQuality_,
                                includeErrors_,
                                false,  // debug
-                               queue);
+                               queue_);
 
-    // TODO: synchronize explicitly for now
-    alpaka::wait(queue);
+    // produce() is scheduled once the kernels and the copies have completed
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
+  }
 
+  void SiPixelRawToCluster::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
     auto tmp = gpuAlgo_.getResults();
     iEvent.emplace(digiPutToken_, std::move(tmp.first));
     iEvent.emplace(clusterPutToken_, std::move(tmp.second));
@@ -7,6 +7,7 @@
 **/
 
 // C++ includes
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
@@ -18,6 +19,7 @@
 #include <string>
 
 // Alpaka includes
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaCore/prefixScan.h"
 
 // CMSSW includes
@@ -31,9 +33,9 @@
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
   namespace pixelgpudetails {
 
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
     SiPixelRawToClusterGPUKernel::WordFedAppender::WordFedAppender()
-        : word_{cms::alpakatools::allocHostBuf<unsigned int>(MAX_FED_WORDS)},
-          fedId_{cms::alpakatools::allocHostBuf<unsigned char>(MAX_FED_WORDS)} {}
+        : word_{allocHostBuf<unsigned int>(MAX_FED_WORDS)}, fedId_{allocHostBuf<unsigned char>(MAX_FED_WORDS)} {}
 
     void SiPixelRawToClusterGPUKernel::WordFedAppender::initializeWordFed(int fedId,
                                                                           unsigned int wordCounterGPU,
@@ -42,6 +44,29 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       std::memcpy(alpaka::getPtrNative(word_) + wordCounterGPU, src, sizeof(uint32_t) * length);
       std::memset(alpaka::getPtrNative(fedId_) + wordCounterGPU / 2, fedId - 1200, length / 2);
     }
+#else
+    SiPixelRawToClusterGPUKernel::WordFedAppender::WordFedAppender() {
+      words_.reserve(::pixelgpudetails::MAX_FED);
+      start_.reserve(::pixelgpudetails::MAX_FED);
+      fedId_.reserve(::pixelgpudetails::MAX_FED);
+    }
+
+    void SiPixelRawToClusterGPUKernel::WordFedAppender::clear() {
+      words_.clear();
+      start_.clear();
+      fedId_.clear();
+    }
+
+    void SiPixelRawToClusterGPUKernel::WordFedAppender::initializeWordFed(int fedId,
+                                                                          unsigned int wordCounterGPU,
+                                                                          const uint32_t *src,
+                                                                          unsigned int length) {
+      assert(start_.empty() or start_.back() <= wordCounterGPU);
+      words_.push_back(src);
+      start_.push_back(wordCounterGPU);
+      fedId_.push_back(fedId - 1200);
+    }
+#endif
 
     ////////////////////
 
@@ -347,14 +372,41 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     }
 
     // Kernel to perform Raw to Digi conversion
+    // Raw data words, and the id of the FED each of them comes from, copied to contiguous buffers
+    struct ContiguousFedWords {
+      const uint32_t *word;
+      const uint8_t *fedIds;  // one per pair of words
+
+      ALPAKA_FN_ACC void get(uint32_t i, uint32_t &ww, uint8_t &fedId) const {
+        ww = word[i];
+        fedId = fedIds[i / 2];
+      }
+    };
+
+#ifndef ALPAKA_ACC_GPU_CUDA_ENABLED
+    // Raw data words read in place from the buffer of each FED
+    struct PerFedWords {
+      const uint32_t *const *words;  // first word of each FED
+      const unsigned int *start;     // index of the first word of each FED
+      const uint8_t *fedIds;
+      unsigned int nFeds;
+
+      ALPAKA_FN_ACC void get(uint32_t i, uint32_t &ww, uint8_t &fedId) const {
+        // the last FED starting at or before i (FEDs without words are skipped)
+        const auto ifed = std::upper_bound(start, start + nFeds, i) - start - 1;
+        ww = words[ifed][i - start[ifed]];
+        fedId = fedIds[ifed];
+      }
+    };
+#endif
+
     struct RawToDigi_kernel {
-      template <typename T_Acc>
+      template <typename T_Acc, typename T_Words>
       ALPAKA_FN_ACC void operator()(const T_Acc &acc,
                                     const SiPixelFedCablingMapGPU *cablingMap,
                                     const unsigned char *modToUnp,
                                     const uint32_t wordCounter,
-                                    const uint32_t *word,
-                                    const uint8_t *fedIds,
+                                    const T_Words words,
                                     uint16_t *xx,
                                     uint16_t *yy,
                                     uint16_t *adc,
@@ -372,14 +424,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           adc[gIndex] = 0;
           bool skipROC = false;
 
-          uint8_t fedId = fedIds[gIndex / 2];  // +1200;
+          uint32_t ww;    // 32 bit raw data
+          uint8_t fedId;  // +1200;
+          words.get(gIndex, ww, fedId);
 
           // initialize (too many coninue below)
           pdigi[gIndex] = 0;
           rawIdArr[gIndex] = 0;
           moduleId[gIndex] = 9999;
 
-          uint32_t ww = word[gIndex];  // Array containing 32 bit raw data
           if (ww == 0) {
             // 0 is an indicator of a noise/dead channel, skip these pixels during clusterization
             return;
@@ -473,6 +526,85 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       }  // end of Raw to Digi kernel operator()
     };   // end of Raw to Digi struct
 
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+    // On the CPU backends, run the calibration of each digi right after unpacking it, in the same block:
+    // both kernels are strided over the same grid, so each block calibrates the digis it has just
+    // unpacked, while they are still in cache.
+    struct RawToDigiAndCalib_kernel {
+      template <typename T_Acc, typename T_Words>
+      ALPAKA_FN_ACC void operator()(const T_Acc &acc,
+                                    const SiPixelFedCablingMapGPU *cablingMap,
+                                    const unsigned char *modToUnp,
+                                    const uint32_t wordCounter,
+                                    const T_Words words,
+                                    uint16_t *xx,
+                                    uint16_t *yy,
+                                    uint16_t *adc,
+                                    uint32_t *pdigi,
+                                    uint32_t *rawIdArr,
+                                    uint16_t *moduleId,
+                                    cms::alpakatools::SimpleVector<PixelErrorCompact> *err,
+                                    bool useQualityInfo,
+                                    bool includeErrors,
+                                    bool debug,
+                                    bool isRun2,
+                                    const SiPixelGainForHLTonGPU *gains,
+                                    uint32_t *moduleStart,
+                                    uint32_t *nClustersInModule,
+                                    uint32_t *clusModuleStart) const {
+        RawToDigi_kernel()(acc,
+                           cablingMap,
+                           modToUnp,
+                           wordCounter,
+                           words,
+                           xx,
+                           yy,
+                           adc,
+                           pdigi,
+                           rawIdArr,
+                           moduleId,
+                           err,
+                           useQualityInfo,
+                           includeErrors,
+                           debug);
+        gpuCalibPixel::calibDigis()(acc,
+                                    isRun2,
+                                    moduleId,
+                                    xx,
+                                    yy,
+                                    adc,
+                                    gains->getVpedestals(),
+                                    gains->getRangeAndCols(),
+                                    gains->getFields(),
+                                    wordCounter,
+                                    moduleStart,
+                                    nClustersInModule,
+                                    clusModuleStart);
+      }
+    };
+
+    // On the CPU backends, find the clusters of each module and apply the charge cut to them in the same
+    // block, i.e. in the same TBB task for the TBB backend.
+    struct findClusAndChargeCut_kernel {
+      template <typename T_Acc>
+      ALPAKA_FN_ACC void operator()(const T_Acc &acc,
+                                    uint16_t *__restrict__ id,
+                                    uint16_t const *__restrict__ x,
+                                    uint16_t const *__restrict__ y,
+                                    uint16_t const *__restrict__ adc,
+                                    uint32_t const *__restrict__ moduleStart,
+                                    uint32_t *__restrict__ nClustersInModule,
+                                    uint32_t *__restrict__ moduleId,
+                                    int32_t *__restrict__ clusterId,
+                                    const uint32_t numElements) const {
+        ::gpuClustering::findClus()(acc, id, x, y, moduleStart, nClustersInModule, moduleId, clusterId, numElements);
+        alpaka::syncBlockThreads(acc);
+        ::gpuClustering::clusterChargeCut()(
+            acc, id, adc, moduleStart, nClustersInModule, moduleId, clusterId, numElements);
+      }
+    };
+#endif
+
   }  // namespace pixelgpudetails
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
 
@@ -559,7 +691,8 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       std::cout << "decoding " << wordCounter << " digis. Max is " << pixelgpudetails::MAX_FED_WORDS << std::endl;
 #endif
 
-      digis_d = SiPixelDigisAlpaka(pixelgpudetails::MAX_FED_WORDS);
+      // all the kernels are bounded by the number of words, so the digis are sized for this event only
+      digis_d = SiPixelDigisAlpaka(wordCounter);
       if (includeErrors) {
         digiErrors_d = SiPixelDigiErrorsAlpaka(pixelgpudetails::MAX_FED_WORDS, std::move(errors));
       }
@@ -567,47 +700,87 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
       if (wordCounter)  // protect in case of empty event....
       {
+        // the default can be replaced by a calibrated value, see AlpakaCore/workDivTuning.h
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-        const int threadsPerBlockOrElementsPerThread = 512;
+        const auto rawToDigiTuning = cms::alpakatools::tuneWorkDiv<Acc1>("RawToDigi", wordCounter, 512);
 #else
-        // NB: MPORTANT: This could be tuned to benefit from innermost loop.
-        const int threadsPerBlockOrElementsPerThread = 32;
+        const auto rawToDigiTuning = cms::alpakatools::tuneWorkDiv<Acc1>("RawToDigi", wordCounter, 32);
 #endif
-        const uint32_t blocks =
-            (wordCounter + threadsPerBlockOrElementsPerThread - 1) / threadsPerBlockOrElementsPerThread;  // fill it all
-        const WorkDiv1 &workDiv =
-            cms::alpakatools::make_workdiv(Vec1::all(blocks), Vec1::all(threadsPerBlockOrElementsPerThread));
-
+        const int threadsPerBlockOrElementsPerThread = rawToDigiTuning.value;
         assert(0 == wordCounter % 2);
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
         // wordCounter is the total no of words in each event to be trasfered on device
-        auto word_d = cms::alpakatools::allocDeviceBuf<uint32_t>(wordCounter);
+        // The buffers are associated with the queue, so they can go out of scope before the kernel has run.
+        auto word_d = allocDeviceBuf<uint32_t>(wordCounter, queue);
         // NB: IMPORTANT: fedId_d: In legacy, wordCounter elements are allocated.
         // However, only the first half of elements end up eventually used:
         // hence, here, only wordCounter/2 elements are allocated.
-        auto fedId_d = cms::alpakatools::allocDeviceBuf<uint8_t>(wordCounter / 2);
+        auto fedId_d = allocDeviceBuf<uint8_t>(wordCounter / 2, queue);
 
         alpaka::memcpy(queue, word_d, wordFed.word(), wordCounter);
         alpaka::memcpy(queue, fedId_d, wordFed.fedId(), wordCounter / 2);
+        const ContiguousFedWords words{alpaka::getPtrNative(word_d), alpaka::getPtrNative(fedId_d)};
+#else
+        // the kernel reads the words directly from the FEDRawData buffers
+        assert(wordFed.nFeds() > 0 and wordFed.start()[0] == 0);
+        const PerFedWords words{wordFed.words(), wordFed.start(), wordFed.fedId(), wordFed.nFeds()};
+#endif
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        // Launch the fused rawToDigi and calibration kernel, over the grid used by the calibration
+        const uint32_t calibBlocks =
+            (std::max(wordCounter, uint32_t(gpuClustering::MaxNumModules)) + threadsPerBlockOrElementsPerThread - 1) /
+            threadsPerBlockOrElementsPerThread;
+        cms::alpakatools::enqueueTunedKernel<Acc1>(
+            queue,
+            rawToDigiTuning,
+            cms::alpakatools::make_workdiv(Vec1::all(calibBlocks), Vec1::all(threadsPerBlockOrElementsPerThread)),
+            RawToDigiAndCalib_kernel(),
+            cablingMap,
+            modToUnp,
+            wordCounter,
+            words,
+            digis_d.xx(),
+            digis_d.yy(),
+            digis_d.adc(),
+            digis_d.pdigi(),
+            digis_d.rawIdArr(),
+            digis_d.moduleInd(),
+            digiErrors_d.error(),
+            useQualityInfo,
+            includeErrors,
+            debug,
+            isRun2,
+            gains,
+            clusters_d.moduleStart(),
+            clusters_d.clusInModule(),
+            clusters_d.clusModuleStart());
+#else
+        const uint32_t blocks =
+            (wordCounter + threadsPerBlockOrElementsPerThread - 1) / threadsPerBlockOrElementsPerThread;  // fill it all
+        const WorkDiv1 &workDiv =
+            cms::alpakatools::make_workdiv(Vec1::all(blocks), Vec1::all(threadsPerBlockOrElementsPerThread));
 
         // Launch rawToDigi kernel
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDiv,
-                                                       RawToDigi_kernel(),
-                                                       cablingMap,
-                                                       modToUnp,
-                                                       wordCounter,
-                                                       alpaka::getPtrNative(word_d),
-                                                       alpaka::getPtrNative(fedId_d),
-                                                       digis_d.xx(),
-                                                       digis_d.yy(),
-                                                       digis_d.adc(),
-                                                       digis_d.pdigi(),
-                                                       digis_d.rawIdArr(),
-                                                       digis_d.moduleInd(),
-                                                       digiErrors_d.error(),
-                                                       useQualityInfo,
-                                                       includeErrors,
-                                                       debug));
+        cms::alpakatools::enqueueTunedKernel<Acc1>(queue,
+                                                   rawToDigiTuning,
+                                                   workDiv,
+                                                   RawToDigi_kernel(),
+                                                   cablingMap,
+                                                   modToUnp,
+                                                   wordCounter,
+                                                   words,
+                                                   digis_d.xx(),
+                                                   digis_d.yy(),
+                                                   digis_d.adc(),
+                                                   digis_d.pdigi(),
+                                                   digis_d.rawIdArr(),
+                                                   digis_d.moduleInd(),
+                                                   digiErrors_d.error(),
+                                                   useQualityInfo,
+                                                   includeErrors,
+                                                   debug);
+#endif
 
 #ifdef GPU_DEBUG
         alpaka::wait(queue);
@@ -618,7 +791,6 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
           digiErrors_d.copyErrorToHostAsync(stream);
         }
 #endif
-        alpaka::wait(queue);  // Wait for work to be completed before end of scope.
       }
       // End of Raw2Digi and passing data for clustering
 
@@ -637,74 +809,105 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         const WorkDiv1 &workDiv =
             cms::alpakatools::make_workdiv(Vec1::all(blocks), Vec1::all(threadsPerBlockOrElementsPerThread));
 
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDiv,
-                                                       gpuCalibPixel::calibDigis(),
-                                                       isRun2,
-                                                       digis_d.moduleInd(),
-                                                       digis_d.c_xx(),
-                                                       digis_d.c_yy(),
-                                                       digis_d.adc(),
-                                                       //gains,
-                                                       gains->getVpedestals(),
-                                                       gains->getRangeAndCols(),
-                                                       gains->getFields(),
-                                                       wordCounter,
-                                                       clusters_d.moduleStart(),
-                                                       clusters_d.clusInModule(),
-                                                       clusters_d.clusModuleStart()));
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        // if there are any digis, the calibration has already run together with the unpacking
+        const bool runCalib = (0 == wordCounter);
+#else
+        const bool runCalib = true;
+#endif
+        if (runCalib) {
+          cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                                workDiv,
+                                                gpuCalibPixel::calibDigis(),
+                                                isRun2,
+                                                digis_d.moduleInd(),
+                                                digis_d.c_xx(),
+                                                digis_d.c_yy(),
+                                                digis_d.adc(),
+                                                //gains,
+                                                gains->getVpedestals(),
+                                                gains->getRangeAndCols(),
+                                                gains->getFields(),
+                                                wordCounter,
+                                                clusters_d.moduleStart(),
+                                                clusters_d.clusInModule(),
+                                                clusters_d.clusModuleStart());
+        }
 #ifdef GPU_DEBUG
         alpaka::wait(queue);
         std::cout << "CUDA countModules kernel launch with " << blocks << " blocks of "
                   << threadsPerBlockOrElementsPerThread << " threadsPerBlockOrElementsPerThread\n";
 #endif
 
-        alpaka::enqueue(
-            queue,
-            alpaka::createTaskKernel<Acc1>(
-                workDiv, countModules(), digis_d.c_moduleInd(), clusters_d.moduleStart(), digis_d.clus(), wordCounter));
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDiv,
+                                              countModules(),
+                                              digis_d.c_moduleInd(),
+                                              clusters_d.moduleStart(),
+                                              digis_d.clus(),
+                                              wordCounter);
 
         auto moduleStartFirstElement = cms::alpakatools::createDeviceView<uint32_t>(clusters_d.moduleStart(), 1u);
 
         alpaka::memcpy(queue, nModules_Clusters_h, moduleStartFirstElement, 1u);
 
-        const WorkDiv1 &workDivMaxNumModules = cms::alpakatools::make_workdiv(Vec1::all(MaxNumModules), Vec1::all(256));
         // NB: With present findClus() / chargeCut() algorithm,
         // threadPerBlock (GPU) or elementsPerThread (CPU) = 256 show optimal performance.
-        // Though, it does not have to be the same number for CPU/GPU cases.
+        // Though, it does not have to be the same number for CPU/GPU cases, and it can be replaced by a
+        // calibrated value, see AlpakaCore/workDivTuning.h. Outside of the serial and TBB backends findClus needs
+        // at least 256, see maxiter in gpuClustering.h.
+        const auto findClusTuning = cms::alpakatools::tuneWorkDiv<Acc1>("findClus", wordCounter, 256);
+        const WorkDiv1 &workDivMaxNumModules =
+            cms::alpakatools::make_workdiv(Vec1::all(MaxNumModules), Vec1::all(findClusTuning.value));
 
 #ifdef GPU_DEBUG
-        std::cout << "CUDA findClus kernel launch with " << MaxNumModules << " blocks of " << 256
+        std::cout << "CUDA findClus kernel launch with " << MaxNumModules << " blocks of " << findClusTuning.value
                   << " threadsPerBlockOrElementsPerThread\n";
 #endif
 
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivMaxNumModules,
-                                                       findClus(),
-                                                       digis_d.c_moduleInd(),
-                                                       digis_d.c_xx(),
-                                                       digis_d.c_yy(),
-                                                       clusters_d.c_moduleStart(),
-                                                       clusters_d.clusInModule(),
-                                                       clusters_d.moduleId(),
-                                                       digis_d.clus(),
-                                                       wordCounter));
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+        cms::alpakatools::enqueueTunedKernel<Acc1>(queue,
+                                                   findClusTuning,
+                                                   workDivMaxNumModules,
+                                                   findClusAndChargeCut_kernel(),
+                                                   digis_d.moduleInd(),
+                                                   digis_d.c_xx(),
+                                                   digis_d.c_yy(),
+                                                   digis_d.c_adc(),
+                                                   clusters_d.c_moduleStart(),
+                                                   clusters_d.clusInModule(),
+                                                   clusters_d.moduleId(),
+                                                   digis_d.clus(),
+                                                   wordCounter);
+#else
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivMaxNumModules,
+                                              findClus(),
+                                              digis_d.c_moduleInd(),
+                                              digis_d.c_xx(),
+                                              digis_d.c_yy(),
+                                              clusters_d.c_moduleStart(),
+                                              clusters_d.clusInModule(),
+                                              clusters_d.moduleId(),
+                                              digis_d.clus(),
+                                              wordCounter);
 
 #ifdef GPU_DEBUG
         alpaka::wait(queue);
 #endif
 
         // apply charge cut
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivMaxNumModules,
-                                                       clusterChargeCut(),
-                                                       digis_d.moduleInd(),
-                                                       digis_d.c_adc(),
-                                                       clusters_d.c_moduleStart(),
-                                                       clusters_d.clusInModule(),
-                                                       clusters_d.c_moduleId(),
-                                                       digis_d.clus(),
-                                                       wordCounter));
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivMaxNumModules,
+                                              clusterChargeCut(),
+                                              digis_d.moduleInd(),
+                                              digis_d.c_adc(),
+                                              clusters_d.c_moduleStart(),
+                                              clusters_d.clusInModule(),
+                                              clusters_d.c_moduleId(),
+                                              digis_d.clus(),
+                                              wordCounter);
+#endif
 
         // count the module start indices already here (instead of
         // rechits) so that the number of clusters/hits can be made
@@ -714,26 +917,23 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         const WorkDiv1 &workDivOneBlock = cms::alpakatools::make_workdiv(Vec1::all(1u), Vec1::all(1024u));
 
         // MUST be ONE block
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(workDivOneBlock,
-                                                       ::pixelgpudetails::fillHitsModuleStart(),
-                                                       clusters_d.c_clusInModule(),
-                                                       clusters_d.clusModuleStart()));
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              workDivOneBlock,
+                                              ::pixelgpudetails::fillHitsModuleStart(),
+                                              clusters_d.c_clusInModule(),
+                                              clusters_d.clusModuleStart());
 
         // last element holds the number of all clusters
         auto clusModuleStartView = cms::alpakatools::createDeviceView<uint32_t>(clusters_d.clusModuleStart(),
                                                                                 gpuClustering::MaxNumModules + 1);
         const auto clusModuleStartLastElement =
             AlpakaDeviceSubView<uint32_t>(clusModuleStartView, 1u, gpuClustering::MaxNumModules);
-        // slice on host
-        auto nModules_Clusters_1_h{cms::alpakatools::allocHostBuf<uint32_t>(1u)};
-        auto p_nModules_Clusters_1_h = alpaka::getPtrNative(nModules_Clusters_1_h);
+        // slice on host: the second element of nModules_Clusters_h holds the number of clusters
+        auto nModules_Clusters_1_h =
+            cms::alpakatools::createHostView<uint32_t>(alpaka::getPtrNative(nModules_Clusters_h) + 1, 1u);
 
+        // The host data are read in getResults(), once the work in the queue has completed
         alpaka::memcpy(queue, nModules_Clusters_1_h, clusModuleStartLastElement, 1u);
-        // Wait for memory transfer to host to complete before looking at host data!
-        alpaka::wait(queue);
-        auto p_nModules_Clusters_h = alpaka::getPtrNative(nModules_Clusters_h);
-        p_nModules_Clusters_h[1] = p_nModules_Clusters_1_h[0];
       }  // end clusterizer scope
     }
   }  // namespace pixelgpudetails
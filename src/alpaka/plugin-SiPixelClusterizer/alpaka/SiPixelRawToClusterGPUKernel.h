@@ -2,6 +2,7 @@
 #define RecoLocalTracker_SiPixelClusterizer_plugins_SiPixelRawToClusterGPUKernel_h
 
 #include <algorithm>
+#include <vector>
 
 #include "AlpakaCore/alpakaCommon.h"
 
@@ -154,11 +155,15 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
     class SiPixelRawToClusterGPUKernel {
     public:
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+      // Stages the words of all FEDs in a contiguous host buffer, to be copied to the device
       class WordFedAppender {
       public:
         WordFedAppender();
         ~WordFedAppender() = default;
 
+        // nothing to do, the words of each event overwrite the previous ones
+        void clear() {}
         void initializeWordFed(int fedId, unsigned int wordCounterGPU, const uint32_t* src, unsigned int length);
 
         auto word() const { return word_; }
@@ -168,9 +173,31 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         AlpakaHostBuf<unsigned int> word_;
         AlpakaHostBuf<unsigned char> fedId_;
       };
+#else
+      // On the CPU backends the RawToDigi kernel reads the words directly from the FEDRawData buffers, that
+      // outlive the kernels. Only the position of each FED in the sequence of words is recorded.
+      class WordFedAppender {
+      public:
+        WordFedAppender();
+        ~WordFedAppender() = default;
+
+        void clear();
+        void initializeWordFed(int fedId, unsigned int wordCounterGPU, const uint32_t* src, unsigned int length);
+
+        unsigned int nFeds() const { return start_.size(); }
+        uint32_t const* const* words() const { return words_.data(); }
+        unsigned int const* start() const { return start_.data(); }
+        unsigned char const* fedId() const { return fedId_.data(); }
+
+      private:
+        std::vector<uint32_t const*> words_;  // first word of each FED
+        std::vector<unsigned int> start_;     // index of the first word of each FED
+        std::vector<unsigned char> fedId_;    // fedId - 1200 of each FED
+      };
+#endif
 
       SiPixelRawToClusterGPUKernel()
-          : nModules_Clusters_h{cms::alpakatools::allocHostBuf<uint32_t>(2u)},
+          : nModules_Clusters_h{allocHostBuf<uint32_t>(2u)},
             digis_d{SiPixelDigisAlpaka(0u)},
             clusters_d{SiPixelClustersAlpaka(0u)},
             digiErrors_d{SiPixelDigiErrorsAlpaka(0u, PixelFormatterErrors())} {};
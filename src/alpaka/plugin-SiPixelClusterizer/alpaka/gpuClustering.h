@@ -155,6 +155,74 @@ namespace gpuClustering {
         }
       });
 
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+      // On the CPU backends each block is run by a single thread: instead of storing the nearest neighbours
+      // and iterating the atomicMin until convergence, merge the neighbours as soon as they are found with a
+      // sequential union-find. The parent of each pixel is stored in clusterId (initialised to the pixel
+      // index by countModules), and the root of each cluster is always its lowest pixel index, so that
+      // the cluster ids below are the same as the ones found by the parallel algorithm.
+      alpaka::syncBlockThreads(acc);  // for hit filling!
+
+      auto findRoot = [&](uint32_t i) {
+        while (clusterId[i] != static_cast<int>(i)) {
+          // path halving
+          clusterId[i] = clusterId[clusterId[i]];
+          i = clusterId[i];
+        }
+        return i;
+      };
+
+      for (uint32_t j = 0; j < hist.size(); ++j) {
+        auto p = hist.begin() + j;
+        auto i = *p + firstPixel;
+        assert(id[i] != InvId);
+        assert(id[i] == thisModuleId);  // same module
+        int be = Hist::bin(y[i] + 1);
+        auto e = hist.end(be);
+        ++p;
+        for (; p < e; ++p) {
+          auto m = (*p) + firstPixel;
+          assert(m != i);
+          assert(int(y[m]) - int(y[i]) >= 0);
+          assert(int(y[m]) - int(y[i]) <= 1);
+          if (std::abs(int(x[m]) - int(x[i])) <= 1) {
+            auto ri = findRoot(i);
+            auto rm = findRoot(m);
+            if (ri < rm) {
+              clusterId[rm] = ri;
+            } else if (rm < ri) {
+              clusterId[ri] = rm;
+            }
+          }
+        }
+      }
+
+      // The parent of each pixel has a lower (or the same) index, so a single pass in increasing order
+      // flattens all the trees. The roots are numbered in the same order, and the other pixels pick up
+      // the (negative) id of their root, that has already been assigned.
+      auto& foundClusters = alpaka::declareSharedVar<unsigned int, __COUNTER__>(acc);
+      foundClusters = 0;
+      for (uint32_t i = firstPixel; i < msize; ++i) {
+        if (id[i] == InvId)  // skip invalid pixels
+          continue;
+        auto root = clusterId[i];
+        if (root == static_cast<int>(i)) {
+          clusterId[i] = -static_cast<int>(++foundClusters);
+        } else {
+          assert(root < static_cast<int>(i));
+          clusterId[i] = clusterId[root];
+        }
+      }
+
+      // adjust the cluster id to be a positive value starting from 0
+      for (uint32_t i = firstPixel; i < msize; ++i) {
+        if (id[i] == InvId) {  // skip invalid pixels
+          clusterId[i] = -9999;
+        } else {
+          clusterId[i] = -clusterId[i] - 1;
+        }
+      }
+#else
       // Assume that we can cover the whole module with up to 16 blockDimension-wide iterations
       // This maxiter value was tuned for GPU, with 256 or 512 threads per block.
       // Hence, also works for CPU case, with 256 or 512 elements per thread.
@@ -331,6 +399,8 @@ namespace gpuClustering {
       });
       alpaka::syncBlockThreads(acc);
 
+#endif
+
       if (threadIdxLocal == 0) {
         nClustersInModule[thisModuleId] = foundClusters;
         moduleId[blockIdx] = thisModuleId;
@@ -1,3 +1,4 @@
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "CondFormats/pixelCPEforGPU.h"
 
 #include "PixelRecHits.h"
@@ -29,7 +30,8 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     TrackingRecHit2DAlpaka PixelRecHitGPUKernel::makeHitsAsync(SiPixelDigisAlpaka const& digis_d,
                                                                SiPixelClustersAlpaka const& clusters_d,
                                                                BeamSpotAlpaka const& bs_d,
-                                                               pixelCPEforGPU::ParamsOnGPU const* cpeParams) const {
+                                                               pixelCPEforGPU::ParamsOnGPU const* cpeParams,
+                                                               Queue& queue) const {
       auto nHits = clusters_d.nClusters();
       TrackingRecHit2DAlpaka hits_d(nHits, cpeParams, clusters_d.clusModuleStart());
 
@@ -42,18 +44,16 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       std::cout << "launching getHits kernel for " << blocks << " blocks" << std::endl;
 #endif
 
-      Queue queue(device);
-
       if (blocks) {  // protect from empty events
-        alpaka::enqueue(queue,
-                        alpaka::createTaskKernel<Acc1>(getHitsWorkDiv,
-                                                       gpuPixelRecHits::getHits(),
-                                                       cpeParams,
-                                                       bs_d.data(),
-                                                       digis_d.view(),
-                                                       digis_d.nDigis(),
-                                                       clusters_d.view(),
-                                                       hits_d.view()));
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              getHitsWorkDiv,
+                                              gpuPixelRecHits::getHits(),
+                                              cpeParams,
+                                              bs_d.data(),
+                                              digis_d.view(),
+                                              digis_d.nDigis(),
+                                              clusters_d.view(),
+                                              hits_d.view());
       }
 
 #ifdef GPU_DEBUG
@@ -63,10 +63,12 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       // assuming full warp of threads is better than a smaller number...
       if (nHits) {
         const WorkDiv1& oneBlockWorkDiv = cms::alpakatools::make_workdiv(Vec1::all(1u), Vec1::all(32u));
-        alpaka::enqueue(
-            queue,
-            alpaka::createTaskKernel<Acc1>(
-                oneBlockWorkDiv, setHitsLayerStart(), clusters_d.clusModuleStart(), cpeParams, hits_d.hitsLayerStart()));
+        cms::alpakatools::enqueueKernel<Acc1>(queue,
+                                              oneBlockWorkDiv,
+                                              setHitsLayerStart(),
+                                              clusters_d.clusModuleStart(),
+                                              cpeParams,
+                                              hits_d.hitsLayerStart());
       }
 
       if (nHits) {
@@ -74,11 +76,10 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
             hits_d.phiBinner(), 10, hits_d.c_iphi(), hits_d.c_hitsLayerStart(), nHits, 256, queue);
       }
 
-      //#ifdef GPU_DEBUG
-      //alpaka::wait(queue);
-      //#endif
-
+#ifdef GPU_DEBUG
       alpaka::wait(queue);
+#endif
+
       return hits_d;
     }
 
@@ -11,15 +11,21 @@
 #include "PixelRecHits.h"  // TODO : spit product from kernel
 
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
+
+#include <optional>
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class SiPixelRecHitAlpaka : public edm::EDProducer {
+  class SiPixelRecHitAlpaka : public edm::EDProducerExternalWork {
   public:
     explicit SiPixelRecHitAlpaka(edm::ProductRegistry& reg);
     ~SiPixelRecHitAlpaka() override = default;
 
   private:
+    void acquire(const edm::Event& iEvent,
+                 const edm::EventSetup& iSetup,
+                 edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
 
     // The mess with inputs will be cleaned up when migrating to the new framework
@@ -30,15 +36,20 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     edm::EDPutTokenT<TrackingRecHit2DAlpaka> tokenHit_;
 
     pixelgpudetails::PixelRecHitGPUKernel gpuAlgo_;
+    Queue queue_;
+    std::optional<TrackingRecHit2DAlpaka> hits_;
   };
 
   SiPixelRecHitAlpaka::SiPixelRecHitAlpaka(edm::ProductRegistry& reg)
       : tBeamSpot(reg.consumes<BeamSpotAlpaka>()),
         token_(reg.consumes<SiPixelClustersAlpaka>()),
         tokenDigi_(reg.consumes<SiPixelDigisAlpaka>()),
-        tokenHit_(reg.produces<TrackingRecHit2DAlpaka>()) {}
+        tokenHit_(reg.produces<TrackingRecHit2DAlpaka>()),
+        queue_(device) {}
 
-  void SiPixelRecHitAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& es) {
+  void SiPixelRecHitAlpaka::acquire(const edm::Event& iEvent,
+                                    const edm::EventSetup& es,
+                                    edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
     auto const& fcpe = es.get<PixelCPEFast>();
 
     auto const& bs = iEvent.get(tBeamSpot);
@@ -50,8 +61,14 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
       std::cout << "Clusters/Hits Overflow " << nHits << " >= " << TrackingRecHit2DSOAView::maxHits() << std::endl;
     }
 
-    // TO DO: Async: Would need to add a queue as a parameter, not async for now!
-    iEvent.emplace(tokenHit_, gpuAlgo_.makeHitsAsync(digis, clusters, bs, fcpe.params()));
+    hits_.emplace(gpuAlgo_.makeHitsAsync(digis, clusters, bs, fcpe.params(), queue_));
+
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
+  }
+
+  void SiPixelRecHitAlpaka::produce(edm::Event& iEvent, const edm::EventSetup& es) {
+    iEvent.emplace(tokenHit_, std::move(*hits_));
+    hits_.reset();
   }
 
 }  // namespace ALPAKA_ACCELERATOR_NAMESPACE
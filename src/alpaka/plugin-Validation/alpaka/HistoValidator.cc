@@ -1,4 +1,5 @@
 #include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaQueueHelper.h"
 #include "AlpakaDataFormats/gpuClusteringConstants.h"
 #include "AlpakaDataFormats/PixelTrackAlpaka.h"
 #include "AlpakaDataFormats/SiPixelClustersAlpaka.h"
@@ -14,19 +15,18 @@
 
 #include <map>
 #include <fstream>
+#include <optional>
 
 namespace ALPAKA_ACCELERATOR_NAMESPACE {
 
-  class HistoValidator : public edm::EDProducer {
+  class HistoValidator : public edm::EDProducerExternalWork {
   public:
     explicit HistoValidator(edm::ProductRegistry& reg);
 
   private:
-#ifdef TODO
     void acquire(const edm::Event& iEvent,
                  const edm::EventSetup& iSetup,
                  edm::WaitingTaskWithArenaHolder waitingTaskHolder) override;
-#endif
     void produce(edm::Event& iEvent, const edm::EventSetup& iSetup) override;
     void endJob() override;
 
@@ -36,6 +36,24 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     edm::EDGetTokenT<PixelTrackHost> trackToken_;
     edm::EDGetTokenT<ZVertexHost> vertexToken_;
 
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+    // host copies of the device products, filled in acquire()
+    Queue queue_;
+    std::optional<AlpakaHostBuf<uint16_t>> h_adc_;
+    std::optional<AlpakaHostBuf<uint32_t>> h_clusInModule_;
+    std::optional<AlpakaHostBuf<float>> h_lx_;
+    std::optional<AlpakaHostBuf<float>> h_ly_;
+    std::optional<AlpakaHostBuf<float>> h_lex_;
+    std::optional<AlpakaHostBuf<float>> h_ley_;
+    std::optional<AlpakaHostBuf<float>> h_gx_;
+    std::optional<AlpakaHostBuf<float>> h_gy_;
+    std::optional<AlpakaHostBuf<float>> h_gz_;
+    std::optional<AlpakaHostBuf<float>> h_gr_;
+    std::optional<AlpakaHostBuf<int32_t>> h_charge_;
+    std::optional<AlpakaHostBuf<int16_t>> h_sizex_;
+    std::optional<AlpakaHostBuf<int16_t>> h_sizey_;
+#endif
+
     static std::map<std::string, SimpleAtomicHisto> histos;
   };
 
@@ -79,34 +97,44 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
         clusterToken_(reg.consumes<SiPixelClustersAlpaka>()),
         hitToken_(reg.consumes<TrackingRecHit2DAlpaka>()),
         trackToken_(reg.consumes<PixelTrackHost>()),
-        vertexToken_(reg.consumes<ZVertexHost>()) {}
+        vertexToken_(reg.consumes<ZVertexHost>())
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+        ,
+        queue_(device)
+#endif
+  {
+  }
 
-#ifdef TODO
   void HistoValidator::acquire(const edm::Event& iEvent,
                                const edm::EventSetup& iSetup,
                                edm::WaitingTaskWithArenaHolder waitingTaskHolder) {
-    auto const& pdigis = iEvent.get(digiToken_);
-    cms::cuda::ScopedContextAcquire ctx{pdigis, std::move(waitingTaskHolder)};
-    auto const& digis = ctx.get(iEvent, digiToken_);
-    auto const& clusters = ctx.get(iEvent, clusterToken_);
-    auto const& hits = ctx.get(iEvent, hitToken_);
-
-    nDigis = digis.nDigis();
-    nModules = digis.nModules();
-    h_adc = digis.adcToHostAsync(ctx.stream());
-
-    nClusters = clusters.nClusters();
-    h_clusInModule = cms::cuda::make_host_unique<uint32_t[]>(nModules, ctx.stream());
-    cudaCheck(cudaMemcpyAsync(
-        h_clusInModule.get(), clusters.clusInModule(), sizeof(uint32_t) * nModules, cudaMemcpyDefault, ctx.stream()));
-
-    nHits = hits.nHits();
-    h_localCoord = hits.localCoordToHostAsync(ctx.stream());
-    h_globalCoord = hits.globalCoordToHostAsync(ctx.stream());
-    h_charge = hits.chargeToHostAsync(ctx.stream());
-    h_size = hits.sizeToHostAsync(ctx.stream());
-  }
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+    auto const& digis = iEvent.get(digiToken_);
+    auto const& clusters = iEvent.get(clusterToken_);
+    auto const& hits = iEvent.get(hitToken_);
+
+    h_adc_.emplace(digis.adcToHostAsync(queue_));
+
+    auto const d_clusInModuleView =
+        cms::alpakatools::createDeviceView<uint32_t>(clusters.clusInModule(), gpuClustering::MaxNumModules);
+    h_clusInModule_.emplace(allocHostBuf<uint32_t>(gpuClustering::MaxNumModules));
+    alpaka::memcpy(queue_, *h_clusInModule_, d_clusInModuleView, gpuClustering::MaxNumModules);
+
+    h_lx_.emplace(hits.xlToHostAsync(queue_));
+    h_ly_.emplace(hits.ylToHostAsync(queue_));
+    h_lex_.emplace(hits.xerrToHostAsync(queue_));
+    h_ley_.emplace(hits.yerrToHostAsync(queue_));
+    h_gx_.emplace(hits.xgToHostAsync(queue_));
+    h_gy_.emplace(hits.ygToHostAsync(queue_));
+    h_gz_.emplace(hits.zgToHostAsync(queue_));
+    h_gr_.emplace(hits.rgToHostAsync(queue_));
+    h_charge_.emplace(hits.chargeToHostAsync(queue_));
+    h_sizex_.emplace(hits.xsizeToHostAsync(queue_));
+    h_sizey_.emplace(hits.ysizeToHostAsync(queue_));
+
+    cms::alpakatools::notifyWhenDone(queue_, std::move(waitingTaskHolder));
 #endif
+  }
 
   void HistoValidator::produce(edm::Event& iEvent, const edm::EventSetup& iSetup) {
     auto const& digis = iEvent.get(digiToken_);
@@ -120,40 +148,21 @@ namespace ALPAKA_ACCELERATOR_NAMESPACE {
     auto const nHits = hits.nHits();
 
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
-    Queue queue(device);
-    auto const h_adcBuf = digis.adcToHostAsync(queue);
-    auto const h_adc = alpaka::getPtrNative(h_adcBuf);
-
-    auto const d_clusInModuleView =
-        cms::alpakatools::createDeviceView<uint32_t>(clusters.clusInModule(), gpuClustering::MaxNumModules);
-    auto h_clusInModuleBuf{cms::alpakatools::allocHostBuf<uint32_t>(gpuClustering::MaxNumModules)};
-    alpaka::memcpy(queue, h_clusInModuleBuf, d_clusInModuleView, gpuClustering::MaxNumModules);
-    auto h_clusInModule = alpaka::getPtrNative(h_clusInModuleBuf);
-
-    auto const h_lxBuf = hits.xlToHostAsync(queue);
-    auto const h_lx = alpaka::getPtrNative(h_lxBuf);
-    auto const h_lyBuf = hits.ylToHostAsync(queue);
-    auto const h_ly = alpaka::getPtrNative(h_lyBuf);
-    auto const h_lexBuf = hits.xerrToHostAsync(queue);
-    auto const h_lex = alpaka::getPtrNative(h_lexBuf);
-    auto const h_leyBuf = hits.yerrToHostAsync(queue);
-    auto const h_ley = alpaka::getPtrNative(h_leyBuf);
-    auto const h_gxBuf = hits.xgToHostAsync(queue);
-    auto const h_gx = alpaka::getPtrNative(h_gxBuf);
-    auto const h_gyBuf = hits.ygToHostAsync(queue);
-    auto const h_gy = alpaka::getPtrNative(h_gyBuf);
-    auto const h_gzBuf = hits.zgToHostAsync(queue);
-    auto const h_gz = alpaka::getPtrNative(h_gzBuf);
-    auto const h_grBuf = hits.rgToHostAsync(queue);
-    auto const h_gr = alpaka::getPtrNative(h_grBuf);
-    auto const h_chargeBuf = hits.chargeToHostAsync(queue);
-    auto const h_charge = alpaka::getPtrNative(h_chargeBuf);
-    auto const h_sizexBuf = hits.xsizeToHostAsync(queue);
-    auto const h_sizex = alpaka::getPtrNative(h_sizexBuf);
-    auto const h_sizeyBuf = hits.ysizeToHostAsync(queue);
-    auto const h_sizey = alpaka::getPtrNative(h_sizeyBuf);
-
-    alpaka::wait(queue);
+    auto const h_adc = alpaka::getPtrNative(*h_adc_);
+
+    auto const h_clusInModule = alpaka::getPtrNative(*h_clusInModule_);
+
+    auto const h_lx = alpaka::getPtrNative(*h_lx_);
+    auto const h_ly = alpaka::getPtrNative(*h_ly_);
+    auto const h_lex = alpaka::getPtrNative(*h_lex_);
+    auto const h_ley = alpaka::getPtrNative(*h_ley_);
+    auto const h_gx = alpaka::getPtrNative(*h_gx_);
+    auto const h_gy = alpaka::getPtrNative(*h_gy_);
+    auto const h_gz = alpaka::getPtrNative(*h_gz_);
+    auto const h_gr = alpaka::getPtrNative(*h_gr_);
+    auto const h_charge = alpaka::getPtrNative(*h_charge_);
+    auto const h_sizex = alpaka::getPtrNative(*h_sizex_);
+    auto const h_sizey = alpaka::getPtrNative(*h_sizey_);
 #else
     auto const h_adc = digis.adc();
 
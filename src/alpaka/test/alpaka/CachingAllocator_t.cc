@@ -0,0 +1,87 @@
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaCore/alpakaWorkDivHelper.h"
+#include "AlpakaCore/allocatorStatus.h"
+
+using namespace ALPAKA_ACCELERATOR_NAMESPACE;
+
+struct fill {
+  template <typename T_Acc>
+  ALPAKA_FN_ACC void operator()(const T_Acc &acc, uint32_t *data, uint32_t n) const {
+    cms::alpakatools::for_each_element_in_grid_strided(acc, n, [&](uint32_t i) { data[i] = i; });
+  }
+};
+
+int main() {
+  Queue queue(device);
+
+  auto &allocator = ALPAKA_ACCELERATOR_NAMESPACE::detail::deviceAllocator();
+  auto initial = allocator.status();
+
+  constexpr uint32_t N = 10000;
+
+  // a released block is reused for a request in the same bin
+  void *first;
+  {
+    auto buf = allocDeviceBuf<uint32_t>(N);
+    first = alpaka::getPtrNative(buf);
+    assert(reinterpret_cast<uintptr_t>(first) % allocator.alignment == 0);
+  }
+  {
+    auto buf = allocDeviceBuf<float>(N - 100);
+    assert(alpaka::getPtrNative(buf) == first);
+  }
+  auto status = allocator.status();
+  assert(status.requests == initial.requests + 2);
+  assert(status.cacheHits == initial.cacheHits + 1);
+  assert(status.bytes.live == initial.bytes.live);
+
+  // copies share the same memory, that is returned only when the last copy is destroyed
+  {
+    auto buf = allocDeviceBuf<uint32_t>(N);
+    {
+      auto copy = buf;
+      assert(alpaka::getPtrNative(copy) == alpaka::getPtrNative(buf));
+    }
+    assert(allocator.status().bytes.live > initial.bytes.live);
+  }
+  assert(allocator.status().bytes.live == initial.bytes.live);
+
+  // cached buffers work with the alpaka memory operations and kernels
+  {
+    auto data_d = allocDeviceBuf<uint32_t>(N, queue);
+    auto data_h = allocHostBuf<uint32_t>(N, queue);
+    alpaka::memset(queue, data_d, 0, N);
+
+    const Vec1 blocksPerGrid(Vec1::all((N + 255) / 256));
+    const Vec1 threadsPerBlockOrElementsPerThread(Vec1::all(256));
+    const WorkDiv1 workDiv = cms::alpakatools::make_workdiv(blocksPerGrid, threadsPerBlockOrElementsPerThread);
+    alpaka::enqueue(queue, alpaka::createTaskKernel<Acc1>(workDiv, fill(), alpaka::getPtrNative(data_d), N));
+
+    alpaka::memcpy(queue, data_h, data_d, N);
+    alpaka::wait(queue);
+    for (uint32_t i = 0; i < N; ++i) {
+      assert(alpaka::getPtrNative(data_h)[i] == i);
+    }
+  }
+
+  // a block associated with a queue is reused by the same queue
+  {
+    void *ptr;
+    {
+      auto buf = allocDeviceBuf<uint32_t>(3 * N, queue);
+      ptr = alpaka::getPtrNative(buf);
+    }
+    auto buf = allocDeviceBuf<uint32_t>(3 * N, queue);
+    assert(alpaka::getPtrNative(buf) == ptr);
+  }
+  alpaka::wait(queue);
+
+  cms::alpakatools::allocator::printAllocatorStatus(std::cout);
+  std::cout << "TEST PASSED" << std::endl;
+
+  return 0;
+}
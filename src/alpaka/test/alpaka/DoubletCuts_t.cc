@@ -0,0 +1,155 @@
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "AlpakaCore/alpakaConfig.h"
+#include "plugin-PixelTriplets/alpaka/gpuPixelDoubletsCuts.h"
+
+using namespace ALPAKA_ACCELERATOR_NAMESPACE;
+
+#if defined ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED || defined ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+namespace {
+  using gpuPixelDoublets::DoubletCuts;
+  namespace cpu = gpuPixelDoublets::cpu;
+
+  struct Hit {
+    uint16_t mo;
+    float zo;
+    float ro;
+    int16_t po;
+    int16_t so;
+  };
+
+  struct Flags {
+    bool doClusterCut;
+    bool doZ0Cut;
+    bool doPtCut;
+  };
+
+  // the per-hit cuts, in the order of the GPU path
+  std::vector<uint32_t> selectScalar(std::vector<Hit> const& window, DoubletCuts const& cuts, Flags flags) {
+    std::vector<uint32_t> accepted;
+    for (uint32_t oi = 0; oi < window.size(); ++oi) {
+      auto const& hit = window[oi];
+      if (hit.mo > 2000)
+        continue;
+      if (flags.doZ0Cut && cuts.z0cutoff(hit.zo, hit.ro))
+        continue;
+      uint16_t idphi = cuts.idphi(hit.po);
+      if (idphi > cuts.iphicut)
+        continue;
+      if (flags.doClusterCut && cuts.zsizeCut(hit.so, hit.zo, hit.ro))
+        continue;
+      if (flags.doPtCut && cuts.ptcut(hit.ro, idphi))
+        continue;
+      accepted.push_back(oi);
+    }
+    return accepted;
+  }
+
+  // the chunks of the CPU path
+  std::vector<uint32_t> selectChunked(std::vector<Hit> const& window, DoubletCuts const& cuts, Flags flags) {
+    std::vector<uint32_t> accepted;
+    cpu::Chunk chunk;
+    auto processChunk = [&]() {
+      uint32_t out[cpu::chunkSize + cpu::chunkAlignment];
+      auto n = cpu::select(chunk, cuts, flags.doClusterCut, flags.doZ0Cut, flags.doPtCut, out);
+      accepted.insert(accepted.end(), out, out + n);
+      chunk.size = 0;
+    };
+    for (uint32_t oi = 0; oi < window.size(); ++oi) {
+      auto const& hit = window[oi];
+      if (chunk.push_back(oi, hit.mo, hit.zo, hit.ro, hit.po, hit.so))
+        processChunk();
+    }
+    processChunk();
+    return accepted;
+  }
+
+  // a window of outer hits around an inner hit, with a fraction of them passing each cut
+  template <typename Engine>
+  std::vector<Hit> makeWindow(Engine& eng, DoubletCuts const& cuts) {
+    std::uniform_int_distribution<int> size(0, 3 * cpu::chunkSize);
+    std::uniform_int_distribution<int> module(0, 2100);
+    std::uniform_real_distribution<float> dr(-2.f, 20.f);
+    std::uniform_real_distribution<float> dz(-10.f, 10.f);
+    std::uniform_int_distribution<int> dphi(-2 * cuts.iphicut, 2 * cuts.iphicut);
+    std::uniform_int_distribution<int> clusterSize(-1, 80);
+
+    std::vector<Hit> window(size(eng));
+    for (auto& hit : window) {
+      hit.mo = module(eng);
+      hit.ro = cuts.mer + dr(eng);
+      // around the line from the origin through the inner hit
+      hit.zo = cuts.mez * hit.ro / cuts.mer + dz(eng);
+      hit.po = int16_t(cuts.mep + dphi(eng));
+      hit.so = clusterSize(eng);
+    }
+    return window;
+  }
+
+  template <typename Engine>
+  DoubletCuts makeCuts(Engine& eng) {
+    std::uniform_int_distribution<int> layer(0, 9);
+    std::uniform_real_distribution<float> r(3.f, 16.f);
+    std::uniform_real_distribution<float> z(-30.f, 30.f);
+    std::uniform_int_distribution<int> iphi(std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max());
+    std::uniform_int_distribution<int> clusterSize(-1, 60);
+    std::uniform_int_distribution<int> phicut(300, 1000);
+    std::uniform_real_distribution<float> maxr(5.f, 20.f);
+
+    DoubletCuts cuts;
+    cuts.inner = layer(eng);
+    cuts.outer = cuts.inner + 1 + layer(eng) % 4;
+    cuts.mez = z(eng);
+    cuts.mer = r(eng);
+    cuts.mep = iphi(eng);
+    cuts.mes = clusterSize(eng);
+    cuts.iphicut = phicut(eng);
+    cuts.maxr = maxr(eng);
+    return cuts;
+  }
+}  // namespace
+
+int main() {
+  std::mt19937 eng;
+  std::uniform_int_distribution<int> flag(0, 1);
+
+  int nFailed = 0;
+  uint64_t nCandidates = 0;
+  uint64_t nAccepted = 0;
+  for (int iter = 0; iter < 100000; ++iter) {
+    auto const cuts = makeCuts(eng);
+    auto const window = makeWindow(eng, cuts);
+    Flags const flags{flag(eng) == 1, flag(eng) == 1, flag(eng) == 1};
+
+    auto const expected = selectScalar(window, cuts, flags);
+    auto const accepted = selectChunked(window, cuts, flags);
+    if (accepted != expected) {
+      if (++nFailed <= 10)
+        std::cout << "window " << iter << " of " << window.size() << " hits: " << accepted.size()
+                  << " accepted hits instead of " << expected.size() << " (inner layer " << int(cuts.inner)
+                  << ", outer layer " << int(cuts.outer) << ", cuts " << flags.doClusterCut << flags.doZ0Cut
+                  << flags.doPtCut << ")" << std::endl;
+    }
+    nCandidates += window.size();
+    nAccepted += expected.size();
+  }
+  std::cout << "DoubletCuts_t: " << nAccepted << " accepted out of " << nCandidates << " candidates, with "
+            << cpu::floatv::size() << " lanes" << std::endl;
+
+  if (nFailed > 0) {
+    std::cout << "DoubletCuts_t: " << nFailed << " windows with different accepted hits" << std::endl;
+    return 1;
+  }
+  std::cout << "DoubletCuts_t passed" << std::endl;
+  return 0;
+}
+#else
+int main() {
+  std::cout << "DoubletCuts_t: the chunked cuts are used only by the CPU backends, skipped" << std::endl;
+  return 0;
+}
+#endif
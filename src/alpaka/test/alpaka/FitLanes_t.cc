@@ -0,0 +1,195 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+#include <Eigen/Core>
+
+#include "AlpakaCore/alpakaConfig.h"
+#include "plugin-PixelTriplets/alpaka/BrokenLine.h"
+#include "plugin-PixelTriplets/alpaka/FitLanes.h"
+#include "plugin-PixelTriplets/alpaka/RiemannFit.h"
+
+using namespace ALPAKA_ACCELERATOR_NAMESPACE;
+
+namespace {
+  constexpr double B = 0.0113921;
+
+  // from a track with 5 hits in the barrel
+  constexpr double refHits[3][5] = {{2.934787, 6.314229, 8.936963, 10.360559, 12.856387},
+                                    {0.773211, 1.816356, 2.765734, 3.330824, 4.422212},
+                                    {-10.980247, -23.162731, -32.759060, -38.061260, -47.518867}};
+  constexpr float refErrors[5][6] = {
+      {1.424715e-07, -4.996975e-07, 1.752614e-06, 3.660689e-11, 1.644638e-09, 7.346080e-05},
+      {6.899177e-08, -1.873414e-07, 5.087101e-07, -2.078806e-10, -2.210498e-11, 4.346079e-06},
+      {1.406273e-06, 4.042467e-07, 6.391180e-07, -3.141497e-07, 6.513821e-08, 1.163863e-07},
+      {1.176358e-06, 2.154100e-07, 5.072816e-07, -8.161219e-08, 1.437878e-07, 5.951832e-08},
+      {2.852843e-05, 7.956492e-06, 3.117701e-06, -1.060541e-06, 8.777413e-09, 1.426417e-07}};
+
+  int nFailed = 0;
+
+  // the batched and per-track fits round differently; in single precision (see Rfit::fit_t) the fits of tracks
+  // far from a helix are too ill-conditioned to compare, so the hits are smeared by realistic amounts only
+  constexpr bool singlePrecision = std::is_same_v<Rfit::fit_t, float>;
+  constexpr double smearSigma = singlePrecision ? 0.001 : 0.05;
+  constexpr double parTolerance = singlePrecision ? 1.e-3 : 1.e-9;
+  // the chi2 suffer from the cancellations in the residuals, but they are stored as float
+  constexpr double chi2Tolerance = singlePrecision ? 1.e-1 : 1.e-6;
+  // the Riemann circle covariance derives the eigenvector numerically, and the line fit uses it: both amplify the
+  // rounding differences in the worst conditioned fits
+  constexpr double riemannTolerance = singlePrecision ? 1.e-2 : 1.e-5;
+  // in single precision the numerical derivative of the eigenvector keeps about one significant digit, so the
+  // circle covariance and the chi2 are only checked for their order of magnitude
+  constexpr double riemannCovTolerance = singlePrecision ? 1. : 1.e-5;
+  constexpr double riemannChi2Tolerance = singlePrecision ? 1. : 1.e-4;
+
+  void check(double batched, double reference, const char* what, double tolerance = parTolerance) {
+    if (std::abs(batched - reference) > tolerance * std::max(1., std::abs(reference))) {
+      std::cout << "mismatch in " << what << ": " << batched << " vs " << reference << std::endl;
+      ++nFailed;
+    }
+  }
+
+  // L tracks, one per lane, and the same tracks one by one
+  template <int N, int L>
+  void makeTracks(std::mt19937& eng,
+                  Rfit::Matrix3xNd<N>* hits,
+                  Eigen::Matrix<float, 6, N>* hits_ge,
+                  Rfit::LaneMatrix<3, N, L>& hitsLanes,
+                  Rfit::LaneMatrix<6, N, L>& hits_geLanes) {
+    std::normal_distribution<double> smear(0., smearSigma);
+    std::uniform_real_distribution<double> scale(0.5, 2.);
+
+    for (int l = 0; l < L; ++l) {
+      // rotate the reference track in phi and smear its hits, so that the lanes differ
+      const double phi = 2. * M_PI * l / L;
+      const double charge = (l % 2) ? 1. : -1.;
+      for (int i = 0; i < N; ++i) {
+        const double x = refHits[0][i] + smear(eng);
+        const double y = charge * refHits[1][i] + smear(eng);
+        hits[l](0, i) = x * std::cos(phi) - y * std::sin(phi);
+        hits[l](1, i) = x * std::sin(phi) + y * std::cos(phi);
+        hits[l](2, i) = refHits[2][i] + smear(eng);
+        const double s = scale(eng);
+        for (int k = 0; k < 6; ++k)
+          hits_ge[l](k, i) = refErrors[i][k] * s;
+        for (int k = 0; k < 3; ++k)
+          hitsLanes(k, i)[l] = hits[l](k, i);
+        for (int k = 0; k < 6; ++k)
+          hits_geLanes(k, i)[l] = hits_ge[l](k, i);
+      }
+    }
+  }
+
+  template <int N, int L>
+  void testBatch(std::mt19937& eng) {
+    Rfit::Matrix3xNd<N> hits[L];
+    Eigen::Matrix<float, 6, N> hits_ge[L];
+    Rfit::LaneMatrix<3, N, L> hitsLanes;
+    Rfit::LaneMatrix<6, N, L> hits_geLanes;
+    makeTracks(eng, hits, hits_ge, hitsLanes, hits_geLanes);
+
+    Rfit::LaneMatrix<4, 1, L> fast_fit;
+    BrokenLine::BL_Fast_fit(hitsLanes, fast_fit);
+    BrokenLine::PreparedBrokenLineData<N, Rfit::Lanes<L>> data;
+    BrokenLine::karimaki_circle_fit_t<Rfit::Lanes<L>> circle;
+    BrokenLine::line_fit_t<Rfit::Lanes<L>> line;
+    BrokenLine::prepareBrokenLineData(hitsLanes, fast_fit, B, data);
+    BrokenLine::BL_Line_fit(hits_geLanes, fast_fit, B, data, line);
+    BrokenLine::BL_Circle_fit(hitsLanes, hits_geLanes, fast_fit, B, data, circle);
+
+    for (int l = 0; l < L; ++l) {
+      Rfit::Vector4d ref_fast_fit;
+      BrokenLine::BL_Fast_fit(hits[l], ref_fast_fit);
+      BrokenLine::PreparedBrokenLineData<N> ref_data;
+      BrokenLine::karimaki_circle_fit ref_circle;
+      Rfit::line_fit ref_line;
+      BrokenLine::prepareBrokenLineData(hits[l], ref_fast_fit, B, ref_data);
+      BrokenLine::BL_Line_fit(hits_ge[l], ref_fast_fit, B, ref_data, ref_line);
+      BrokenLine::BL_Circle_fit(hits[l], hits_ge[l], ref_fast_fit, B, ref_data, ref_circle);
+
+      for (int k = 0; k < 4; ++k)
+        check(fast_fit(k)[l], ref_fast_fit(k), "fast fit");
+      check(circle.q[l], ref_circle.q, "charge");
+      for (int i = 0; i < 3; ++i) {
+        check(circle.par(i)[l], ref_circle.par(i), "circle parameters");
+        for (int j = 0; j < 3; ++j)
+          check(circle.cov(i, j)[l], ref_circle.cov(i, j), "circle covariance");
+      }
+      check(circle.chi2[l], ref_circle.chi2, "circle chi2", chi2Tolerance);
+      for (int i = 0; i < 2; ++i) {
+        check(line.par(i)[l], ref_line.par(i), "line parameters");
+        for (int j = 0; j < 2; ++j)
+          check(line.cov(i, j)[l], ref_line.cov(i, j), "line covariance");
+      }
+      check(line.chi2[l], ref_line.chi2, "line chi2", chi2Tolerance);
+    }
+  }
+
+  // the same for the Riemann fits, as in kernelFastFit, kernelCircleFit and kernelLineFit
+  template <int N, int L>
+  void testRiemannBatch(std::mt19937& eng) {
+    Rfit::Matrix3xNd<N> hits[L];
+    Eigen::Matrix<float, 6, N> hits_ge[L];
+    Rfit::LaneMatrix<3, N, L> hitsLanes;
+    Rfit::LaneMatrix<6, N, L> hits_geLanes;
+    makeTracks(eng, hits, hits_ge, hitsLanes, hits_geLanes);
+
+    Rfit::LaneMatrix<4, 1, L> fast_fit;
+    Rfit::Fast_fit(hitsLanes, fast_fit);
+    Rfit::LaneMatrix<N, 1, L> rad = hitsLanes.block(0, 0, 2, N).colwise().norm();
+    Rfit::LaneMatrix<2 * N, 2 * N, L> hits_cov = Rfit::LaneMatrix<2 * N, 2 * N, L>::Zero();
+    Rfit::loadCovariance2D(hits_geLanes, hits_cov);
+    auto const circle = Rfit::Circle_fit(hitsLanes.block(0, 0, 2, N), hits_cov, fast_fit, rad, B, true);
+    auto const line = Rfit::Line_fit(hitsLanes, hits_geLanes, circle, fast_fit, B, true);
+
+    for (int l = 0; l < L; ++l) {
+      Rfit::Vector4d ref_fast_fit;
+      Rfit::Fast_fit(hits[l], ref_fast_fit);
+      Rfit::VectorNd<N> ref_rad = hits[l].block(0, 0, 2, N).colwise().norm();
+      Rfit::Matrix2Nd<N> ref_hits_cov = Rfit::Matrix2Nd<N>::Zero();
+      Rfit::loadCovariance2D(hits_ge[l], ref_hits_cov);
+      auto const ref_circle = Rfit::Circle_fit(hits[l].block(0, 0, 2, N), ref_hits_cov, ref_fast_fit, ref_rad, B, true);
+      auto const ref_line = Rfit::Line_fit(hits[l], hits_ge[l], ref_circle, ref_fast_fit, B, true);
+
+      for (int k = 0; k < 4; ++k)
+        check(fast_fit(k)[l], ref_fast_fit(k), "Riemann fast fit");
+      check(circle.q[l], ref_circle.q, "Riemann charge");
+      for (int i = 0; i < 3; ++i) {
+        check(circle.par(i)[l], ref_circle.par(i), "Riemann circle parameters", riemannTolerance);
+        for (int j = 0; j < 3; ++j)
+          check(circle.cov(i, j)[l], ref_circle.cov(i, j), "Riemann circle covariance", riemannCovTolerance);
+      }
+      check(circle.chi2[l], ref_circle.chi2, "Riemann circle chi2", riemannChi2Tolerance);
+      for (int i = 0; i < 2; ++i) {
+        check(line.par(i)[l], ref_line.par(i), "Riemann line parameters", riemannTolerance);
+        for (int j = 0; j < 2; ++j)
+          check(line.cov(i, j)[l], ref_line.cov(i, j), "Riemann line covariance", riemannTolerance);
+      }
+      check(line.chi2[l], ref_line.chi2, "Riemann line chi2", riemannChi2Tolerance);
+    }
+  }
+}  // namespace
+
+int main() {
+  std::mt19937 eng;
+  for (int iter = 0; iter < 100; ++iter) {
+    testBatch<3, 2>(eng);
+    testBatch<4, 2>(eng);
+    testBatch<5, 2>(eng);
+    testBatch<4, 4>(eng);
+    testBatch<4, 8>(eng);
+    testRiemannBatch<3, 2>(eng);
+    testRiemannBatch<4, 2>(eng);
+    testRiemannBatch<5, 2>(eng);
+    testRiemannBatch<4, 4>(eng);
+  }
+
+  if (nFailed > 0) {
+    std::cout << "FitLanes_t: " << nFailed << " mismatches" << std::endl;
+    return 1;
+  }
+  std::cout << "FitLanes_t passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Framework/LatencyHistogram.h"
+
+using edm::LatencyHistogram;
+
+namespace {
+  // the value at rank ceil(q * n) of the sorted values, as LatencyHistogram::quantile() defines it
+  uint64_t exactQuantile(std::vector<uint64_t> const& sorted, double q) {
+    auto rank = static_cast<uint64_t>(std::ceil(q * sorted.size()));
+    rank = std::clamp<uint64_t>(rank, 1, sorted.size());
+    return sorted[rank - 1];
+  }
+}  // namespace
+
+int main() {
+  // the bins are exact below 64 ns
+  for (uint64_t value = 0; value < LatencyHistogram::kSubBins; ++value) {
+    assert(LatencyHistogram::bin(value) == static_cast<int>(value));
+    assert(LatencyHistogram::lastValue(value) == value);
+  }
+
+  // and up to 127 ns, where the bins of the first power of two have a width of 1 ns
+  assert(LatencyHistogram::bin(63) == 63);
+  assert(LatencyHistogram::bin(64) == 64);
+  for (uint64_t value = 64; value < 128; ++value) {
+    assert(LatencyHistogram::lastValue(LatencyHistogram::bin(value)) == value);
+  }
+
+  // each power of two starts a new group of bins, and the previous value ends the last bin of the group before
+  for (int power = 7; power < 64; ++power) {
+    uint64_t const value = uint64_t(1) << power;
+    int const bin = LatencyHistogram::bin(value);
+    assert(bin == (power - LatencyHistogram::kSubBits + 1) * static_cast<int>(LatencyHistogram::kSubBins));
+    assert(LatencyHistogram::bin(value - 1) == bin - 1);
+    assert(LatencyHistogram::lastValue(bin - 1) == value - 1);
+    assert(LatencyHistogram::lastValue(bin) == value + (uint64_t(1) << (power - LatencyHistogram::kSubBits)) - 1);
+  }
+
+  // the largest value goes to the last bin
+  constexpr uint64_t maxValue = std::numeric_limits<uint64_t>::max();
+  assert(LatencyHistogram::bin(maxValue) == LatencyHistogram::kBins - 1);
+  assert(LatencyHistogram::lastValue(LatencyHistogram::kBins - 1) == maxValue);
+
+  // every value lies in its bin, and the last value of the bin is within 1/64 of it
+  std::mt19937_64 engine;
+  std::uniform_int_distribution<int> powers(0, 63);
+  for (int i = 0; i < 1000000; ++i) {
+    uint64_t const value = engine() >> powers(engine);
+    int const bin = LatencyHistogram::bin(value);
+    assert(bin >= 0 and bin < LatencyHistogram::kBins);
+    assert(value <= LatencyHistogram::lastValue(bin));
+    assert(bin == 0 or LatencyHistogram::lastValue(bin - 1) < value);
+    assert(LatencyHistogram::lastValue(bin) - value <= value / LatencyHistogram::kSubBins);
+  }
+
+  // an empty histogram
+  {
+    LatencyHistogram histo;
+    assert(histo.count() == 0);
+    assert(histo.quantile(0.5).count() == 0);
+    assert(histo.mean().count() == 0);
+  }
+
+  // the quantiles are never below the exact ones, and within 1/64 of them
+  for (double const scale : {1., 100., 1e6, 1e9}) {
+    std::exponential_distribution<double> latency(1. / scale);
+    std::vector<uint64_t> values;
+    LatencyHistogram histo;
+    for (int i = 0; i < 100000; ++i) {
+      auto const value = static_cast<uint64_t>(latency(engine));
+      values.push_back(value);
+      histo.fill(LatencyHistogram::Duration(value));
+    }
+    std::sort(values.begin(), values.end());
+    assert(histo.count() == values.size());
+    assert(static_cast<uint64_t>(histo.max().count()) == values.back());
+    for (double const q : {0., 0.1, 0.5, 0.9, 0.99, 0.999, 1.}) {
+      uint64_t const exact = exactQuantile(values, q);
+      uint64_t const quantile = histo.quantile(q).count();
+      assert(quantile >= exact);
+      assert(quantile - exact <= exact / LatencyHistogram::kSubBins);
+    }
+    assert(static_cast<uint64_t>(histo.quantile(1.).count()) == values.back());
+  }
+
+  // negative durations are counted as 0
+  {
+    LatencyHistogram histo;
+    histo.fill(LatencyHistogram::Duration(-5));
+    assert(histo.count() == 1);
+    assert(histo.max().count() == 0);
+    assert(histo.quantile(0.5).count() == 0);
+  }
+
+  std::cout << "TEST PASSED" << std::endl;
+  return 0;
+}
@@ -5,6 +5,7 @@
 #include <limits>
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "AlpakaCore/HistoContainer.h"
 
@@ -50,6 +51,63 @@ struct countMulti {
   }
 };
 
+// the bin of a track in the partial histograms below
+ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE uint32_t multiplicityBin(TK const& tk) { return 3 + tk[0] % 5; }
+
+struct countMultiDirect {
+  template <typename T_Acc>
+  ALPAKA_FN_ACC void operator()(const T_Acc& acc,
+                                TK const* __restrict__ tk,
+                                Multiplicity* __restrict__ assoc,
+                                uint32_t n) const {
+    cms::alpakatools::for_each_element_in_grid_strided(
+        acc, n, [&](uint32_t k) { assoc->countDirect(acc, multiplicityBin(tk[k])); });
+  }
+};
+
+struct fillMultiDirect {
+  template <typename T_Acc>
+  ALPAKA_FN_ACC void operator()(const T_Acc& acc,
+                                TK const* __restrict__ tk,
+                                Multiplicity* __restrict__ assoc,
+                                uint32_t n) const {
+    cms::alpakatools::for_each_element_in_grid_strided(
+        acc, n, [&](uint32_t k) { assoc->fillDirect(acc, multiplicityBin(tk[k]), k); });
+  }
+};
+
+// count the tracks of each thread in a partial histogram of its own, and merge it
+struct countMultiPartial {
+  template <typename T_Acc>
+  ALPAKA_FN_ACC void operator()(const T_Acc& acc,
+                                TK const* __restrict__ tk,
+                                Multiplicity* __restrict__ assoc,
+                                uint32_t n) const {
+    Multiplicity::CountersOnly local;
+    local.zero();
+    cms::alpakatools::for_each_element_in_grid_strided(
+        acc, n, [&](uint32_t k) { local.countDirectLocal(multiplicityBin(tk[k])); });
+    assoc->add(acc, local);
+  }
+};
+
+// count again the tracks of each thread, reserve their slots and fill them
+struct fillMultiPartial {
+  template <typename T_Acc>
+  ALPAKA_FN_ACC void operator()(const T_Acc& acc,
+                                TK const* __restrict__ tk,
+                                Multiplicity* __restrict__ assoc,
+                                uint32_t n) const {
+    Multiplicity::CountersOnly local;
+    local.zero();
+    cms::alpakatools::for_each_element_in_grid_strided(
+        acc, n, [&](uint32_t k) { local.countDirectLocal(multiplicityBin(tk[k])); });
+    assoc->reserve(acc, local);
+    cms::alpakatools::for_each_element_in_grid_strided(
+        acc, n, [&](uint32_t k) { assoc->fillDirectReserved(local, multiplicityBin(tk[k]), k); });
+  }
+};
+
 struct verifyMulti {
   template <typename T_Acc>
   ALPAKA_FN_ACC void operator()(const T_Acc& acc, Multiplicity* __restrict__ m1, Multiplicity* __restrict__ m2) const {
@@ -342,5 +400,60 @@ int main() {
 
   alpaka::wait(queue);
 
+  // here verify the fill through partial histograms private to each thread, from several blocks
+  auto m3_dbuf = alpaka::allocBuf<Multiplicity, Idx>(device, 1u);
+  alpaka::memset(queue, m3_dbuf, 0, 1u);
+  auto m4_dbuf = alpaka::allocBuf<Multiplicity, Idx>(device, 1u);
+  alpaka::memset(queue, m4_dbuf, 0, 1u);
+
+  launchZero(alpaka::getPtrNative(m3_dbuf), queue);
+  launchZero(alpaka::getPtrNative(m4_dbuf), queue);
+
+  alpaka::enqueue(queue,
+                  alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+                      workDiv, countMultiDirect(), alpaka::getPtrNative(v_dbuf), alpaka::getPtrNative(m3_dbuf), N));
+  alpaka::enqueue(queue,
+                  alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+                      workDiv, countMultiPartial(), alpaka::getPtrNative(v_dbuf), alpaka::getPtrNative(m4_dbuf), N));
+
+  cms::alpakatools::launchFinalize(alpaka::getPtrNative(m3_dbuf), queue);
+  cms::alpakatools::launchFinalize(alpaka::getPtrNative(m4_dbuf), queue);
+
+  alpaka::enqueue(queue,
+                  alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+                      workDiv, fillMultiDirect(), alpaka::getPtrNative(v_dbuf), alpaka::getPtrNative(m3_dbuf), N));
+  alpaka::enqueue(queue,
+                  alpaka::createTaskKernel<ALPAKA_ACCELERATOR_NAMESPACE::Acc1>(
+                      workDiv, fillMultiPartial(), alpaka::getPtrNative(v_dbuf), alpaka::getPtrNative(m4_dbuf), N));
+
+  auto m3_hbuf = alpaka::allocBuf<Multiplicity, Idx>(host, 1u);
+  alpaka::memcpy(queue, m3_hbuf, m3_dbuf, 1u);
+  auto m4_hbuf = alpaka::allocBuf<Multiplicity, Idx>(host, 1u);
+  alpaka::memcpy(queue, m4_hbuf, m4_dbuf, 1u);
+  alpaka::wait(queue);
+  auto m3 = alpaka::getPtrNative(m3_hbuf);
+  auto m4 = alpaka::getPtrNative(m4_hbuf);
+
+  assert(m3->size() == N);
+  assert(m4->size() == N);
+  for (uint32_t i = 0; i < Multiplicity::totbins(); ++i) {
+    assert(m3->off[i] == m4->off[i]);
+  }
+  for (uint32_t b = 0; b < Multiplicity::nbins(); ++b) {
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_SEQ_ENABLED
+    // a single thread fills the bins in the same order
+    assert(std::equal(m3->begin(b), m3->end(b), m4->begin(b)));
+#else
+    // the order of the tracks in each bin depends on the order in which the threads run
+    std::vector<uint16_t> direct(m3->begin(b), m3->end(b));
+    std::vector<uint16_t> partial(m4->begin(b), m4->end(b));
+    std::sort(direct.begin(), direct.end());
+    std::sort(partial.begin(), partial.end());
+    assert(direct == partial);
+#endif
+  }
+  std::cout << "partial histograms filled " << m4->size() << " tracks in " << Multiplicity::nbins() << " bins"
+            << std::endl;
+
   return 0;
 }
@@ -0,0 +1,107 @@
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+#include "AlpakaCore/SoALayout.h"
+#include "AlpakaCore/alpakaCommon.h"
+#include "AlpakaDataFormats/SiPixelDigisAlpaka.h"
+
+using namespace ALPAKA_ACCELERATOR_NAMESPACE;
+
+namespace {
+  using DigisLayout = cms::alpakatools::SoALayout<uint16_t, uint16_t, uint16_t, uint16_t, int32_t, uint32_t, uint32_t>;
+  using ClustersLayout = cms::alpakatools::SoALayout<uint32_t, uint32_t, uint32_t, uint32_t>;
+
+  constexpr size_t alignment = DigisLayout::alignment;
+
+  // the columns follow each other, each at the first multiple of the alignment after the previous one
+  template <typename TLayout>
+  void checkLayout(TLayout const& layout, std::array<size_t, TLayout::numberOfColumns> const& columnBytes) {
+    size_t expected = 0;
+    for (size_t i = 0; i < TLayout::numberOfColumns; ++i) {
+      assert(layout.offset(i) == expected);
+      assert(layout.offset(i) % alignment == 0);
+      expected += (columnBytes[i] + alignment - 1) / alignment * alignment;
+    }
+    assert(layout.bytes() == expected);
+    assert(layout.bytes() % alignment == 0);
+  }
+
+  // the columns of a buffer of the layout are aligned, and do not overlap
+  template <typename TLayout, size_t... Is>
+  void checkColumns(TLayout const& layout, std::byte* buffer, std::index_sequence<Is...>) {
+    ((assert(reinterpret_cast<uintptr_t>(layout.template column<Is>(buffer)) % alignment == 0)), ...);
+    (
+        [&]() {
+          auto* column = layout.template column<Is>(buffer);
+          for (size_t j = 0; j < layout.elements(Is); ++j) {
+            column[j] = static_cast<typename TLayout::template ColumnType<Is>>(Is + 1);
+          }
+        }(),
+        ...);
+    (
+        [&]() {
+          auto const* column = layout.template column<Is>(static_cast<std::byte const*>(buffer));
+          for (size_t j = 0; j < layout.elements(Is); ++j) {
+            assert(column[j] == static_cast<typename TLayout::template ColumnType<Is>>(Is + 1));
+          }
+        }(),
+        ...);
+  }
+}  // namespace
+
+int main() {
+  // the layout can be computed at compile time
+  static_assert(DigisLayout(1000).bytes() == 4 * 2048 + 3 * 4096);
+  static_assert(DigisLayout(1000).offset(4) == 4 * 2048);
+
+  // the same number of elements in all the columns
+  for (size_t n : {1, 63, 64, 65, 1000, 150000}) {
+    DigisLayout layout(n);
+    checkLayout(layout, {{2 * n, 2 * n, 2 * n, 2 * n, 4 * n, 4 * n, 4 * n}});
+
+    auto buffer = allocHostBuf<std::byte>(layout.bytes());
+    assert(reinterpret_cast<uintptr_t>(alpaka::getPtrNative(buffer)) % alignment == 0);
+    checkColumns(layout, alpaka::getPtrNative(buffer), std::make_index_sequence<DigisLayout::numberOfColumns>{});
+  }
+
+  // a different number of elements in each column
+  {
+    size_t const n = 1000;
+    ClustersLayout layout({n + 1, n, n, n + 1});
+    checkLayout(layout, {{4 * (n + 1), 4 * n, 4 * n, 4 * (n + 1)}});
+    assert(layout.elements(0) == n + 1);
+    assert(layout.elements(1) == n);
+
+    auto buffer = allocHostBuf<std::byte>(layout.bytes());
+    checkColumns(layout, alpaka::getPtrNative(buffer), std::make_index_sequence<ClustersLayout::numberOfColumns>{});
+  }
+
+  // the zero-element columns of an empty event take no memory, and all start at the beginning of the buffer
+  {
+    DigisLayout layout(0);
+    checkLayout(layout, {});
+    assert(layout.bytes() == 0);
+    for (size_t i = 0; i < DigisLayout::numberOfColumns; ++i) {
+      assert(layout.offset(i) == 0);
+    }
+
+    // the buffer of an empty layout is still a valid, aligned block of the caching allocator
+    SiPixelDigisAlpaka digis(0);
+    assert(reinterpret_cast<uintptr_t>(digis.xx()) % alignment == 0);
+    assert(static_cast<void*>(digis.xx()) == static_cast<void*>(digis.rawIdArr()));
+  }
+
+  // the device buffers are aligned as well
+  {
+    DigisLayout layout(1000);
+    auto buffer = allocDeviceBuf<std::byte>(layout.bytes());
+    assert(reinterpret_cast<uintptr_t>(alpaka::getPtrNative(buffer)) % alignment == 0);
+  }
+
+  std::cout << "TEST PASSED" << std::endl;
+  return 0;
+}
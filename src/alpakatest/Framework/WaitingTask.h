@@ -22,9 +22,12 @@
 #include <atomic>
 #include <exception>
 #include <memory>
-#include "tbb/task.h"
+#include <utility>
+
+#include <tbb/task_group.h>
 
 // user include files
+#include "Framework/TaskBase.h"
 
 // forward declarations
 
@@ -33,7 +36,7 @@ namespace edm {
   class WaitingTaskHolder;
   class WaitingTaskWithArenaHolder;
 
-  class WaitingTask : public tbb::task {
+  class WaitingTask : public TaskBase {
   public:
     friend class WaitingTaskList;
     friend class WaitingTaskHolder;
@@ -69,23 +72,51 @@ namespace edm {
     std::atomic<std::exception_ptr*> m_ptr;
   };
 
+  /** The last task of a job, owned by the caller instead of being deleted once it has run.
+      wait() returns when it has run, and rethrows the exception of its dependent tasks if any.
+  */
+  class FinalWaitingTask : public WaitingTask {
+  public:
+    // The group counts this task as pending from its construction until it has run, also while the
+    // work it waits for is outside of the group, e.g. enqueued in an arena or in a GPU callback.
+    explicit FinalWaitingTask(tbb::task_group& iGroup)
+        : m_group{&iGroup}, m_handle{iGroup.defer([this]() { m_done = true; })}, m_done{false} {}
+
+    void execute() final { m_group->run(std::move(m_handle)); }
+
+    bool done() const { return m_done.load(); }
+
+    // The calling thread takes part in the work of the group, and sleeps when there is none.
+    // The group waits also for the task that runs execute(), so this task can be destroyed afterwards.
+    void wait() {
+      m_group->wait();
+      if (exceptionPtr()) {
+        std::rethrow_exception(*exceptionPtr());
+      }
+    }
+
+  private:
+    void recycle() final {}
+
+    tbb::task_group* m_group;
+    tbb::task_handle m_handle;
+    std::atomic<bool> m_done;
+  };
+
   template <typename F>
   class FunctorWaitingTask : public WaitingTask {
   public:
     explicit FunctorWaitingTask(F f) : func_(std::move(f)) {}
 
-    task* execute() override {
-      func_(exceptionPtr());
-      return nullptr;
-    };
+    void execute() final { func_(exceptionPtr()); };
 
   private:
     F func_;
   };
 
-  template <typename ALLOC, typename F>
-  FunctorWaitingTask<F>* make_waiting_task(ALLOC&& iAlloc, F f) {
-    return new (iAlloc) FunctorWaitingTask<F>(std::move(f));
+  template <typename F>
+  FunctorWaitingTask<F>* make_waiting_task(F f) {
+    return new FunctorWaitingTask<F>(std::move(f));
   }
 
 }  // namespace edm
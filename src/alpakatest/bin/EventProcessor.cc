@@ -1,4 +1,5 @@
-#include "Framework/EmptyWaitingTask.h"
+#include <tbb/task_group.h>
+
 #include "Framework/ESPluginFactory.h"
 #include "Framework/WaitingTask.h"
 #include "Framework/WaitingTaskHolder.h"
@@ -27,15 +28,12 @@ namespace edm {
 
   void EventProcessor::runToCompletion() {
     // The task that waits for all other work
-    auto globalWaitTask = make_empty_waiting_task();
-    globalWaitTask->increment_ref_count();
+    tbb::task_group group;
+    FinalWaitingTask globalWaitTask{group};
     for (auto& s : schedules_) {
-      s.runToCompletionAsync(WaitingTaskHolder(globalWaitTask.get()));
-    }
-    globalWaitTask->wait_for_all();
-    if (globalWaitTask->exceptionPtr()) {
-      std::rethrow_exception(*(globalWaitTask->exceptionPtr()));
+      s.runToCompletionAsync(WaitingTaskHolder(group, &globalWaitTask));
     }
+    globalWaitTask.wait();
   }
 
   void EventProcessor::endJob() {
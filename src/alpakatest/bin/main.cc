@@ -8,7 +8,7 @@
 #include <vector>
 
 #include "AlpakaCore/alpakaConfigCommon.h"
-#include <tbb/task_scheduler_init.h>
+#include <tbb/info.h>
 
 #include "EventProcessor.h"
 
@@ -88,13 +88,13 @@ int main(int argc, char** argv) {
   if (auto found = std::find(backends.begin(), backends.end(), Backend::TBB); found != backends.end()) {
     numberOfStreams = 1;  // Study intra-event parallelization.
     // TO DO: Warning: does not seem to be able to control the number of threads in TBB pool
-    // from here with a tbb::task_scheduler_init init(numThreads).
+    // from here with a tbb::global_control(tbb::global_control::max_allowed_parallelism, numThreads).
     // Successfully managed to control the number of threads in TBB pool for now, by adding & updating
-    // tbb::task_scheduler_init init(2) directly inside:
+    // a tbb::task_arena arena(2) directly inside:
     // external/alpaka/include/alpaka/kernel/TaskKernelCpuTbbBlocks.hpp (and make clean_alpaka).
 
-    numberOfThreads = tbb::task_scheduler_init::
-        default_num_threads();  // By default, this number of threads is chosen in Alpaka for the TBB pool.
+    numberOfThreads =
+        tbb::info::default_concurrency();  // By default, this number of threads is chosen in Alpaka for the TBB pool.
   }
 
 
@@ -14,7 +14,6 @@
 // system include files
 
 // user include files
-#include "tbb/task.h"
 #include <cassert>
 
 #include "WaitingTaskList.h"
@@ -28,6 +27,14 @@ using namespace edm;
 //
 // static data member definitions
 //
+namespace {
+  // only incremented when the lists are contended, so that the counting itself does not add contention
+  std::atomic<unsigned long long> s_overlappingAdds{0};
+  std::atomic<unsigned long long> s_racedAdds{0};
+  std::atomic<unsigned long long> s_linkWaits{0};
+  std::atomic<unsigned long long> s_pauses{0};
+  std::atomic<unsigned long long> s_uncachedNodes{0};
+}  // namespace
 
 //
 // constructors and destructor
@@ -66,7 +73,7 @@ void WaitingTaskList::reset() {
   m_waiting = true;
 }
 
-WaitingTaskList::WaitNode* WaitingTaskList::createNode(WaitingTask* iTask) {
+WaitingTaskList::WaitNode* WaitingTaskList::createNode(tbb::task_group* iGroup, WaitingTask* iTask) {
   unsigned int index = m_lastAssignedCacheIndex++;
 
   WaitNode* returnValue;
@@ -75,8 +82,10 @@ WaitingTaskList::WaitNode* WaitingTaskList::createNode(WaitingTask* iTask) {
   } else {
     returnValue = new WaitNode;
     returnValue->m_fromCache = false;
+    s_uncachedNodes.fetch_add(1, std::memory_order_relaxed);
   }
   returnValue->m_task = iTask;
+  returnValue->m_group = iGroup;
   //No other thread can see m_next yet. The caller to create node
   // will be doing a synchronization operation anyway which will
   // make sure m_task and m_next are synched across threads
@@ -85,20 +94,46 @@ WaitingTaskList::WaitNode* WaitingTaskList::createNode(WaitingTask* iTask) {
   return returnValue;
 }
 
-void WaitingTaskList::add(WaitingTask* iTask) {
+WaitingTaskList::WaitNode* WaitingTaskList::waitForNextNode(WaitNode* iNode) {
+  WaitNode* next = iNode->nextNode();
+  if (iNode == next) {
+    unsigned long long pauses = 0;
+    while (iNode == (next = iNode->nextNode())) {
+      hardware_pause();
+      ++pauses;
+    }
+    s_linkWaits.fetch_add(1, std::memory_order_relaxed);
+    s_pauses.fetch_add(pauses, std::memory_order_relaxed);
+  }
+  return next;
+}
+
+void WaitingTaskList::add(WaitingTaskHolder iTask) {
+  //the list takes its own reference to the task,
+  // the one of the holder is released when it goes out of scope
+  add(iTask.group(), iTask.m_task);
+}
+
+void WaitingTaskList::add(tbb::task_group* iGroup, WaitingTask* iTask) {
   iTask->increment_ref_count();
   if (!m_waiting) {
     if (bool(m_exceptionPtr)) {
       iTask->dependentTaskFailed(m_exceptionPtr);
     }
     if (0 == iTask->decrement_ref_count()) {
-      tbb::task::spawn(*iTask);
+      iGroup->run([iTask]() {
+        TaskSentry s{iTask};
+        iTask->execute();
+      });
     }
   } else {
-    WaitNode* newHead = createNode(iTask);
+    WaitNode* newHead = createNode(iGroup, iTask);
     //This exchange is sequentially consistent thereby
     // ensuring ordering between it and setNextNode
     WaitNode* oldHead = m_head.exchange(newHead);
+    if (oldHead != nullptr and oldHead->nextNode() == oldHead) {
+      s_overlappingAdds.fetch_add(1, std::memory_order_relaxed);
+    }
     newHead->setNextNode(oldHead);
 
     //For the case where oldHead != nullptr,
@@ -110,10 +145,11 @@ void WaitingTaskList::add(WaitingTask* iTask) {
     if (nullptr == oldHead) {
       if (!m_waiting) {
         //if finished waiting right before we did the
-        // exchange our task will not be spawned. Also,
+        // exchange our task will not be run. Also,
         // additional threads may be calling add() and swapping
         // heads and linking us to the new head.
         // It is safe to call announce from multiple threads
+        s_racedAdds.fetch_add(1, std::memory_order_relaxed);
         announce();
       }
     }
@@ -124,10 +160,7 @@ void WaitingTaskList::presetTaskAsFailed(std::exception_ptr iExcept) {
   if (iExcept and m_waiting) {
     WaitNode* node = m_head.load();
     while (node) {
-      WaitNode* next;
-      while (node == (next = node->nextNode())) {
-        hardware_pause();
-      }
+      WaitNode* next = waitForNextNode(node);
       node->m_task->dependentTaskFailed(iExcept);
       node = next;
     }
@@ -145,10 +178,9 @@ void WaitingTaskList::announce() {
     // thread and we have a new 'head' but the old head has not yet been
     // attached to the new head (we identify this since 'nextNode' will return itself).
     //  In that case we have to wait until the link has been established before going on.
-    while (n == (next = n->nextNode())) {
-      hardware_pause();
-    }
+    next = waitForNextNode(n);
     auto t = n->m_task;
+    auto g = n->m_group;
     if (bool(m_exceptionPtr)) {
       t->dependentTaskFailed(m_exceptionPtr);
     }
@@ -158,13 +190,24 @@ void WaitingTaskList::announce() {
     n = next;
 
     //the task may indirectly call WaitingTaskList::reset
-    // so we need to call spawn after we are done using the node.
+    // so we need to call run after we are done using the node.
     if (0 == t->decrement_ref_count()) {
-      tbb::task::spawn(*t);
+      g->run([t]() {
+        TaskSentry s{t};
+        t->execute();
+      });
     }
   }
 }
 
+WaitingTaskList::Contention WaitingTaskList::contention() {
+  return Contention{s_overlappingAdds.load(),
+                    s_racedAdds.load(),
+                    s_linkWaits.load(),
+                    s_pauses.load(),
+                    s_uncachedNodes.load()};
+}
+
 void WaitingTaskList::doneWaiting(std::exception_ptr iPtr) {
   m_exceptionPtr = iPtr;
   m_waiting = false;
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstdlib>
+
 #include "CAHitNtupletGeneratorKernelsImpl.h"
 
 template <>
@@ -10,6 +13,55 @@ void CAHitNtupletGeneratorKernelsCPU::fillHitDetIndices(HitsView const *hv, TkSo
   kernel_fillHitDetIndices(&tracks_d->hitIndices, hv, &tracks_d->detIndices);
 }
 
+namespace cAHitNtupletGenerator {
+
+  GPUCACell *CPUWorkspace::cells(uint32_t n) {
+    if (n > cellsSize_) {
+      // the content is not preserved
+      cells_.reset();
+      cells_.reset(static_cast<GPUCACell *>(std::malloc(n * sizeof(GPUCACell))));
+      assert(cells_);
+      cellsSize_ = n;
+    }
+    return cells_.get();
+  }
+
+  GPUCACell::OuterHitOfCell *CPUWorkspace::isOuterHitOfCell(uint32_t nHits) {
+    if (nHits > isOuterHitOfCellSize_) {
+      isOuterHitOfCell_.reset();
+      isOuterHitOfCell_.reset(
+          static_cast<GPUCACell::OuterHitOfCell *>(std::malloc(nHits * sizeof(GPUCACell::OuterHitOfCell))));
+      assert(isOuterHitOfCell_);
+      isOuterHitOfCellSize_ = nHits;
+    }
+    return isOuterHitOfCell_.get();
+  }
+
+  unsigned char *CPUWorkspace::cellStorage() {
+    if (not cellStorage_) {
+      cellStorage_.reset(
+          static_cast<unsigned char *>(std::malloc(CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellNeighbors) +
+                                                   CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellTracks))));
+      assert(cellStorage_);
+    }
+    return cellStorage_.get();
+  }
+
+  uint32_t CPUWorkspace::cellCapacity(uint32_t nHits, uint32_t maxNumberOfDoublets) const {
+    // about two sigma above the average, plus 25%
+    uint64_t capacity = uint64_t(nHits) * doubletsPerHit_.upper() / doubletsPerHitScale;
+    capacity += capacity / 4;
+    return std::clamp<uint64_t>(capacity, std::min(1024U, maxNumberOfDoublets), maxNumberOfDoublets);
+  }
+
+  void CPUWorkspace::update(uint32_t nHits, uint32_t nDoublets) {
+    if (nHits > 0) {
+      doubletsPerHit_.update(uint64_t(nDoublets) * doubletsPerHitScale / nHits);
+    }
+  }
+
+}  // namespace cAHitNtupletGenerator
+
 template <>
 void CAHitNtupletGeneratorKernelsCPU::buildDoublets(HitsOnCPU const &hh, cudaStream_t stream) {
   auto nhits = hh.nHits();
@@ -18,29 +70,27 @@ void CAHitNtupletGeneratorKernelsCPU::buildDoublets(HitsOnCPU const &hh, cudaStr
   std::cout << "building Doublets out of " << nhits << " Hits" << std::endl;
 #endif
 
-  // in principle we can use "nhits" to heuristically dimension the workspace...
-  // overkill to use template here (std::make_unique would suffice)
-  // device_isOuterHitOfCell_ = Traits:: template make_unique<GPUCACell::OuterHitOfCell[]>(cs, std::max(1U,nhits), stream);
-  device_isOuterHitOfCell_.reset(
-      (GPUCACell::OuterHitOfCell *)malloc(std::max(1U, nhits) * sizeof(GPUCACell::OuterHitOfCell)));
-  assert(device_isOuterHitOfCell_.get());
+  // the buffers are kept by the stream across the events
+  assert(m_cpuWorkspace);
+  device_isOuterHitOfCell_ = m_cpuWorkspace->isOuterHitOfCell(std::max(1U, nhits));
+  assert(device_isOuterHitOfCell_);
 
-  cellStorage_.reset((unsigned char *)malloc(CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellNeighbors) +
-                                             CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellTracks)));
-  device_theCellNeighborsContainer_ = (GPUCACell::CellNeighbors *)cellStorage_.get();
+  cellStorage_ = m_cpuWorkspace->cellStorage();
+  device_theCellNeighborsContainer_ = (GPUCACell::CellNeighbors *)cellStorage_;
   device_theCellTracksContainer_ =
-      (GPUCACell::CellTracks *)(cellStorage_.get() +
+      (GPUCACell::CellTracks *)(cellStorage_ +
                                 CAConstants::maxNumOfActiveDoublets() * sizeof(GPUCACell::CellNeighbors));
 
-  gpuPixelDoublets::initDoublets(device_isOuterHitOfCell_.get(),
+  gpuPixelDoublets::initDoublets(device_isOuterHitOfCell_,
                                  nhits,
                                  device_theCellNeighbors_.get(),
                                  device_theCellNeighborsContainer_,
                                  device_theCellTracks_.get(),
                                  device_theCellTracksContainer_);
 
-  // device_theCells_ = Traits:: template make_unique<GPUCACell[]>(cs, m_params.maxNumberOfDoublets_, stream);
-  device_theCells_.reset((GPUCACell *)malloc(sizeof(GPUCACell) * m_params.maxNumberOfDoublets_));
+  // size the cells from the previous events, rather than for m_params.maxNumberOfDoublets_
+  auto maxNumberOfDoublets = m_cpuWorkspace->cellCapacity(nhits, m_params.maxNumberOfDoublets_);
+  device_theCells_ = m_cpuWorkspace->cells(maxNumberOfDoublets);
   if (0 == nhits)
     return;  // protect against empty events
 
@@ -53,18 +103,34 @@ void CAHitNtupletGeneratorKernelsCPU::buildDoublets(HitsOnCPU const &hh, cudaStr
   }
 
   assert(nActualPairs <= gpuPixelDoublets::nPairs);
-  gpuPixelDoublets::getDoubletsFromHisto(device_theCells_.get(),
-                                         device_nCells_,
-                                         device_theCellNeighbors_.get(),
-                                         device_theCellTracks_.get(),
-                                         hh.view(),
-                                         device_isOuterHitOfCell_.get(),
-                                         nActualPairs,
-                                         m_params.idealConditions_,
-                                         m_params.doClusterCut_,
-                                         m_params.doZ0Cut_,
-                                         m_params.doPtCut_,
-                                         m_params.maxNumberOfDoublets_);
+  while (true) {
+    gpuPixelDoublets::getDoubletsFromHisto(device_theCells_,
+                                           device_nCells_,
+                                           device_theCellNeighbors_.get(),
+                                           device_theCellTracks_.get(),
+                                           hh.view(),
+                                           device_isOuterHitOfCell_,
+                                           nActualPairs,
+                                           m_params.idealConditions_,
+                                           m_params.doClusterCut_,
+                                           m_params.doZ0Cut_,
+                                           m_params.doPtCut_,
+                                           maxNumberOfDoublets);
+    if (*device_nCells_ < maxNumberOfDoublets or maxNumberOfDoublets == m_params.maxNumberOfDoublets_)
+      break;
+
+    // the estimate was too small and some doublets may be missing: build them again with more room
+    maxNumberOfDoublets = std::min(2 * maxNumberOfDoublets, m_params.maxNumberOfDoublets_);
+    device_theCells_ = m_cpuWorkspace->cells(maxNumberOfDoublets);
+    *device_nCells_ = 0;
+    gpuPixelDoublets::initDoublets(device_isOuterHitOfCell_,
+                                   nhits,
+                                   device_theCellNeighbors_.get(),
+                                   device_theCellNeighborsContainer_,
+                                   device_theCellTracks_.get(),
+                                   device_theCellTracksContainer_);
+  }
+  m_cpuWorkspace->update(nhits, *device_nCells_);
 }
 
 template <>
@@ -90,10 +156,10 @@ void CAHitNtupletGeneratorKernelsCPU::launchKernels(HitsOnCPU const &hh, TkSoA *
   kernel_connect(device_hitTuple_apc_,
                  device_hitToTuple_apc_,  // needed only to be reset, ready for next kernel
                  hh.view(),
-                 device_theCells_.get(),
+                 device_theCells_,
                  device_nCells_,
                  device_theCellNeighbors_.get(),
-                 device_isOuterHitOfCell_.get(),
+                 device_isOuterHitOfCell_,
                  m_params.hardCurvCut_,
                  m_params.ptmin_,
                  m_params.CAThetaCutBarrel_,
@@ -103,11 +169,11 @@ void CAHitNtupletGeneratorKernelsCPU::launchKernels(HitsOnCPU const &hh, TkSoA *
 
   if (nhits > 1 && m_params.earlyFishbone_) {
     gpuPixelDoublets::fishbone(
-        hh.view(), device_theCells_.get(), device_nCells_, device_isOuterHitOfCell_.get(), nhits, false);
+        hh.view(), device_theCells_, device_nCells_, device_isOuterHitOfCell_, nhits, false);
   }
 
   kernel_find_ntuplets(hh.view(),
-                       device_theCells_.get(),
+                       device_theCells_,
                        device_nCells_,
                        device_theCellTracks_.get(),
                        tuples_d,
@@ -115,12 +181,12 @@ void CAHitNtupletGeneratorKernelsCPU::launchKernels(HitsOnCPU const &hh, TkSoA *
                        quality_d,
                        m_params.minHitsPerNtuplet_);
   if (m_params.doStats_)
-    kernel_mark_used(hh.view(), device_theCells_.get(), device_nCells_);
+    kernel_mark_used(hh.view(), device_theCells_, device_nCells_);
 
   cms::cuda::finalizeBulk(device_hitTuple_apc_, tuples_d);
 
   // remove duplicates (tracks that share a doublet)
-  kernel_earlyDuplicateRemover(device_theCells_.get(), device_nCells_, tuples_d, quality_d);
+  kernel_earlyDuplicateRemover(device_theCells_, device_nCells_, tuples_d, quality_d);
 
   kernel_countMultiplicity(tuples_d, quality_d, device_tupleMultiplicity_.get());
   cms::cuda::launchFinalize(device_tupleMultiplicity_.get(), cudaStream);
@@ -128,18 +194,18 @@ void CAHitNtupletGeneratorKernelsCPU::launchKernels(HitsOnCPU const &hh, TkSoA *
 
   if (nhits > 1 && m_params.lateFishbone_) {
     gpuPixelDoublets::fishbone(
-        hh.view(), device_theCells_.get(), device_nCells_, device_isOuterHitOfCell_.get(), nhits, true);
+        hh.view(), device_theCells_, device_nCells_, device_isOuterHitOfCell_, nhits, true);
   }
 
   if (m_params.doStats_) {
     kernel_checkOverflows(tuples_d,
                           device_tupleMultiplicity_.get(),
                           device_hitTuple_apc_,
-                          device_theCells_.get(),
+                          device_theCells_,
                           device_nCells_,
                           device_theCellNeighbors_.get(),
                           device_theCellTracks_.get(),
-                          device_isOuterHitOfCell_.get(),
+                          device_isOuterHitOfCell_,
                           nhits,
                           m_params.maxNumberOfDoublets_,
                           counters_);
@@ -156,11 +222,11 @@ void CAHitNtupletGeneratorKernelsCPU::classifyTuples(HitsOnCPU const &hh, TkSoA
 
   if (m_params.lateFishbone_) {
     // apply fishbone cleaning to good tracks
-    kernel_fishboneCleaner(device_theCells_.get(), device_nCells_, quality_d);
+    kernel_fishboneCleaner(device_theCells_, device_nCells_, quality_d);
   }
 
   // remove duplicates (tracks that share a doublet)
-  kernel_fastDuplicateRemover(device_theCells_.get(), device_nCells_, tuples_d, tracks_d);
+  kernel_fastDuplicateRemover(device_theCells_, device_nCells_, tuples_d, tracks_d);
 
   // fill hit->track "map"
   kernel_countHitInTracks(tuples_d, quality_d, device_hitToTuple_.get());
@@ -1,7 +1,11 @@
 #ifndef RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorKernels_h
 #define RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorKernels_h
 
+#include <cstdlib>
+#include <memory>
+
 #include "CUDADataFormats/PixelTrackHeterogeneous.h"
+#include "Framework/RunningAverage.h"
 #include "GPUCACell.h"
 
 // #define DUMP_GPU_TK_TUPLES
@@ -134,6 +138,35 @@ namespace cAHitNtupletGenerator {
 
   };  // Params
 
+  // Workspace of the doublets on the CPU, kept by each stream across the events.
+  // The buffers grow to the high-water mark and are not initialised: the doublet building writes all
+  // the elements that are read later.
+  class CPUWorkspace {
+  public:
+    GPUCACell* cells(uint32_t n);
+    GPUCACell::OuterHitOfCell* isOuterHitOfCell(uint32_t nHits);
+    unsigned char* cellStorage();
+
+    // number of cells for an event with nHits hits, estimated from the doublets per hit of the previous events
+    uint32_t cellCapacity(uint32_t nHits, uint32_t maxNumberOfDoublets) const;
+    void update(uint32_t nHits, uint32_t nDoublets);
+
+  private:
+    struct Free {
+      void operator()(void* ptr) const { std::free(ptr); }
+    };
+
+    // doublets per hit, in units of 1/doubletsPerHitScale
+    static constexpr int doubletsPerHitScale = 16;
+
+    std::unique_ptr<GPUCACell, Free> cells_;
+    uint32_t cellsSize_ = 0;
+    std::unique_ptr<GPUCACell::OuterHitOfCell, Free> isOuterHitOfCell_;
+    uint32_t isOuterHitOfCellSize_ = 0;
+    std::unique_ptr<unsigned char, Free> cellStorage_;
+    edm::RunningAverage doubletsPerHit_{8 * doubletsPerHitScale};
+  };
+
 }  // namespace cAHitNtupletGenerator
 
 template <typename TTraits>
@@ -159,7 +192,9 @@ public:
   using TkSoA = pixelTrack::TrackSoA;
   using HitContainer = pixelTrack::HitContainer;
 
-  CAHitNtupletGeneratorKernels(Params const& params) : m_params(params) {}
+  // the CPU workspace is required, and only used, by the CPU specialisation
+  CAHitNtupletGeneratorKernels(Params const& params, cAHitNtupletGenerator::CPUWorkspace* cpuWorkspace = nullptr)
+      : m_params(params), m_cpuWorkspace(cpuWorkspace) {}
   ~CAHitNtupletGeneratorKernels() = default;
 
   TupleMultiplicity const* tupleMultiplicity() const { return device_tupleMultiplicity_.get(); }
@@ -179,14 +214,20 @@ public:
 
 private:
   // workspace
-  unique_ptr<unsigned char[]> cellStorage_;
+  // On the GPU the buffers are owned by the kernels for one event, on the CPU they are borrowed from the
+  // CPUWorkspace of the stream
+  unique_ptr<unsigned char[]> ownedCellStorage_;
+  unique_ptr<GPUCACell[]> ownedCells_;
+  unique_ptr<GPUCACell::OuterHitOfCell[]> ownedIsOuterHitOfCell_;
+
+  unsigned char* cellStorage_ = nullptr;
   unique_ptr<CAConstants::CellNeighborsVector> device_theCellNeighbors_;
   CAConstants::CellNeighbors* device_theCellNeighborsContainer_;
   unique_ptr<CAConstants::CellTracksVector> device_theCellTracks_;
   CAConstants::CellTracks* device_theCellTracksContainer_;
 
-  unique_ptr<GPUCACell[]> device_theCells_;
-  unique_ptr<GPUCACell::OuterHitOfCell[]> device_isOuterHitOfCell_;
+  GPUCACell* device_theCells_ = nullptr;
+  GPUCACell::OuterHitOfCell* device_isOuterHitOfCell_ = nullptr;
   uint32_t* device_nCells_ = nullptr;
 
   unique_ptr<HitToTuple> device_hitToTuple_;
@@ -199,6 +240,7 @@ private:
   unique_ptr<cms::cuda::AtomicPairCounter::c_type[]> device_storage_;
   // params
   Params const& m_params;
+  cAHitNtupletGenerator::CPUWorkspace* m_cpuWorkspace;
 };
 
 using CAHitNtupletGeneratorKernelsGPU = CAHitNtupletGeneratorKernels<cms::cudacompat::GPUTraits>;
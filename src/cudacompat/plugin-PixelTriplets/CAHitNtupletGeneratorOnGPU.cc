@@ -140,7 +140,7 @@ PixelTrackHeterogeneous CAHitNtupletGeneratorOnGPU::makeTuples(TrackingRecHit2DC
   auto* soa = tracks.get();
   assert(soa);
 
-  CAHitNtupletGeneratorKernelsCPU kernels(m_params);
+  CAHitNtupletGeneratorKernelsCPU kernels(m_params, &m_cpuWorkspace);
   kernels.counters_ = m_counters;
   kernels.allocateOnGPU(nullptr);
 
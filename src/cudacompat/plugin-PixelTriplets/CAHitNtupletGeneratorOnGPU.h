@@ -51,6 +51,9 @@ private:
   Params m_params;
 
   Counters* m_counters = nullptr;
+
+  // buffers of the doublets on the CPU, reused across the events of the stream
+  mutable cAHitNtupletGenerator::CPUWorkspace m_cpuWorkspace;
 };
 
 #endif  // RecoPixelVertexing_PixelTriplets_plugins_CAHitNtupletGeneratorOnGPU_h
@@ -7,7 +7,7 @@
 #include <string>
 #include <vector>
 
-#include <tbb/task_scheduler_init.h>
+#include <tbb/global_control.h>
 
 #include <cuda_runtime.h>
 
@@ -137,7 +137,7 @@ int main(int argc, char** argv) {
             << numberOfThreads << " threads." << std::endl;
 
   // Initialize tasks scheduler (thread pool)
-  tbb::task_scheduler_init tsi(numberOfThreads);
+  tbb::global_control globalControl(tbb::global_control::max_allowed_parallelism, numberOfThreads);
 
   // Run work
   auto start = std::chrono::high_resolution_clock::now();
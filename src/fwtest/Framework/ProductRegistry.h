@@ -42,6 +42,9 @@ namespace edm {
 
     auto size() const { return typeToIndex_.size(); }
 
+    // index of the module being constructed in the path, starting from 1 (0 is the Source)
+    unsigned int currentModuleIndex() const { return currentModuleIndex_; }
+
     // internal interface
     void beginModuleConstruction(int i) {
       currentModuleIndex_ = i;
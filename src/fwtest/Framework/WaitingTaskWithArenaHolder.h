@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 
 namespace edm {
 
@@ -36,7 +37,10 @@ namespace edm {
     // Note that the arena will be the one containing the thread
     // that runs this constructor. This is the arena where you
     // eventually intend for the task to be spawned.
-    explicit WaitingTaskWithArenaHolder(WaitingTask* iTask);
+    explicit WaitingTaskWithArenaHolder(tbb::task_group& iGroup, WaitingTask* iTask);
+
+    // Takes the task and the group of the holder
+    explicit WaitingTaskWithArenaHolder(WaitingTaskHolder&& iTask);
 
     ~WaitingTaskWithArenaHolder();
 
@@ -67,9 +71,12 @@ namespace edm {
     // the problem quickly).
     WaitingTaskHolder makeWaitingTaskHolderAndRelease();
 
+    tbb::task_group* group() const { return m_group; }
+
   private:
     // ---------- member data --------------------------------
     WaitingTask* m_task;
+    tbb::task_group* m_group;
     std::shared_ptr<tbb::task_arena> m_arena;
   };
 
@@ -84,10 +91,9 @@ namespace edm {
     };
   }
 
-  template <typename ALLOC, typename F>
-  auto make_waiting_task_with_holder(ALLOC&& iAlloc, WaitingTaskWithArenaHolder h, F&& f) {
+  template <typename F>
+  auto make_waiting_task_with_holder(WaitingTaskWithArenaHolder h, F&& f) {
     return make_waiting_task(
-        std::forward<ALLOC>(iAlloc),
         [holder = h, func = make_lambda_with_holder(h, std::forward<F>(f))](std::exception_ptr const* excptr) mutable {
           if (excptr) {
             holder.doneWaiting(*excptr);
@@ -0,0 +1,98 @@
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "SyntheticCore/Workload.h"
+
+namespace {
+  synthetic::Workload globalWorkload;
+}
+
+namespace synthetic {
+  Workload::Workload(std::vector<int> const& layerWidths,
+                     int fanIn,
+                     std::chrono::nanoseconds burn,
+                     int externalWorkEvery,
+                     std::chrono::microseconds externalTime)
+      : numberOfLayers_(layerWidths.size()) {
+    int const n = std::accumulate(layerWidths.begin(), layerWidths.end(), 0);
+    if (n < 1 or n > kMaxModules) {
+      throw std::invalid_argument("The synthetic workload must have between 1 and " + std::to_string(kMaxModules) +
+                                  " modules, got " + std::to_string(n));
+    }
+    if (fanIn < 0) {
+      throw std::invalid_argument("The fan-in of the synthetic workload can not be negative, got " +
+                                  std::to_string(fanIn));
+    }
+    modules_.reserve(n);
+
+    int previousBegin = 0;
+    int previousWidth = 0;
+    for (int width : layerWidths) {
+      if (width < 1) {
+        throw std::invalid_argument("The layers of the synthetic workload must have at least one module");
+      }
+      int const begin = modules_.size();
+      int const consumed = (fanIn == 0 or fanIn > previousWidth) ? previousWidth : fanIn;
+      for (int j = 0; j < width; ++j) {
+        ModuleDescription module;
+        // spread the consumers evenly over the modules of the previous layer
+        for (int k = 0; k < consumed; ++k) {
+          module.consumes.push_back(previousBegin + (j + k) % previousWidth);
+        }
+        module.burn = burn;
+        module.externalWork = externalWorkEvery > 0 and (begin + j + 1) % externalWorkEvery == 0;
+        module.externalTime = externalTime;
+        modules_.push_back(std::move(module));
+      }
+      previousBegin = begin;
+      previousWidth = width;
+    }
+  }
+
+  std::vector<int> Workload::parseLayers(std::string const& layers) {
+    std::vector<int> widths;
+    std::string::size_type begin = 0;
+    while (begin <= layers.size()) {
+      auto end = layers.find(',', begin);
+      if (end == std::string::npos) {
+        end = layers.size();
+      }
+      std::string const item = layers.substr(begin, end - begin);
+      int repeat = 1;
+      int width;
+      if (auto x = item.find('x'); x != std::string::npos) {
+        repeat = std::stoi(item.substr(0, x));
+        width = std::stoi(item.substr(x + 1));
+      } else {
+        width = std::stoi(item);
+      }
+      if (repeat < 1) {
+        throw std::invalid_argument("Invalid synthetic layers '" + item + "'");
+      }
+      widths.insert(widths.end(), repeat, width);
+      begin = end + 1;
+    }
+    return widths;
+  }
+
+  int Workload::numberOfExternalWorkModules() const {
+    int n = 0;
+    for (auto const& module : modules_) {
+      n += module.externalWork ? 1 : 0;
+    }
+    return n;
+  }
+
+  std::chrono::nanoseconds Workload::burnPerEvent() const {
+    std::chrono::nanoseconds sum{0};
+    for (auto const& module : modules_) {
+      sum += module.burn;
+    }
+    return sum;
+  }
+
+  void setWorkload(Workload workload) { globalWorkload = std::move(workload); }
+
+  Workload const& workload() { return globalWorkload; }
+}  // namespace synthetic
@@ -0,0 +1,59 @@
+#ifndef SyntheticCore_Workload_h
+#define SyntheticCore_Workload_h
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace synthetic {
+  // Description of one module of a synthetic workload
+  struct ModuleDescription {
+    // indices of the modules whose products are consumed, all smaller than the index of the module
+    std::vector<int> consumes;
+    // CPU time spent in produce() for each event
+    std::chrono::nanoseconds burn{0};
+    // if set, acquire() hands the event over to another thread, that notifies the framework after externalTime
+    bool externalWork = false;
+    std::chrono::microseconds externalTime{0};
+  };
+
+  // DAG of synthetic modules, to measure the overhead of the framework independently of any physics code.
+  // The modules are organised in layers: each module consumes the products of fanIn modules of the
+  // previous layer, so that each module is also consumed by about fanIn modules of the next layer.
+  class Workload {
+  public:
+    static constexpr int kMaxModules = 256;
+
+    Workload() = default;
+
+    // Throws std::invalid_argument if there are no modules or more than kMaxModules.
+    // fanIn 0 (or larger than the previous layer) consumes all the modules of the previous layer.
+    // Every externalWorkEvery-th module uses acquire(), none if 0.
+    explicit Workload(std::vector<int> const& layerWidths,
+                      int fanIn,
+                      std::chrono::nanoseconds burn,
+                      int externalWorkEvery,
+                      std::chrono::microseconds externalTime);
+
+    // Parses the widths of the layers from a comma-separated list, where "LxW" stands for L layers of W
+    // modules, e.g. "1,64,1" for a fan-out followed by a fan-in, or "100x1" for a chain of 100 modules
+    static std::vector<int> parseLayers(std::string const& layers);
+
+    std::vector<ModuleDescription> const& modules() const { return modules_; }
+    int numberOfLayers() const { return numberOfLayers_; }
+    int numberOfExternalWorkModules() const;
+
+    // CPU time spent by all the modules for one event
+    std::chrono::nanoseconds burnPerEvent() const;
+
+  private:
+    std::vector<ModuleDescription> modules_;
+    int numberOfLayers_ = 0;
+  };
+
+  // The workload of the job, to be set before the modules are constructed
+  void setWorkload(Workload workload);
+  Workload const& workload();
+}  // namespace synthetic
+
+#endif
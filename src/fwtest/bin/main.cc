@@ -6,7 +6,12 @@
 #include <string>
 #include <vector>
 
-#include <tbb/task_scheduler_init.h>
+#include <sys/resource.h>
+
+#include <tbb/global_control.h>
+
+#include "Framework/WaitingTaskList.h"
+#include "SyntheticCore/Workload.h"
 
 #include "EventProcessor.h"
 
@@ -15,7 +20,8 @@ namespace {
     std::cout
         << name
         << ": [--numberOfThreads NT] [--numberOfStreams NS] [--maxEvents ME] [--data PATH] [--transfer] [--validation] "
-           "[--empty]\n\n"
+           "[--empty] [--synthetic LAYERS] [--syntheticFanIn K] [--syntheticBurn NS] [--syntheticExternalWork M] "
+           "[--syntheticExternalTime US]\n\n"
         << "Options\n"
         << " --numberOfThreads   Number of threads to use (default 1)\n"
         << " --numberOfStreams   Number of concurrent events (default 0=numberOfThreads)\n"
@@ -24,8 +30,23 @@ namespace {
         << " --transfer          Transfer results from GPU to CPU (default is to leave them on GPU)\n"
         << " --validation        Run (rudimentary) validation at the end (implies --transfer)\n"
         << " --empty             Ignore all producers (for testing only)\n"
+        << " --synthetic         Replace the producers with a synthetic workload, given as the comma-separated number\n"
+        << "                     of modules of each layer, with LxW for L layers of W modules (e.g. 1,64,1 or 100x1)\n"
+        << " --syntheticFanIn    Number of modules of the previous layer consumed by each module (default 0 for all)\n"
+        << " --syntheticBurn     CPU time spent by each module per event, in ns (default 0)\n"
+        << " --syntheticExternalWork  Every M-th module hands its work over to another thread in acquire() (default 0\n"
+        << "                     for none)\n"
+        << " --syntheticExternalTime  Duration of the work handed over to another thread, in us (default 0)\n"
         << std::endl;
   }
+
+  // CPU time used by all the threads of the process, in ns
+  double cpuTime() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    auto ns = [](timeval const& t) { return t.tv_sec * 1e9 + t.tv_usec * 1e3; };
+    return ns(usage.ru_utime) + ns(usage.ru_stime);
+  }
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -38,6 +59,11 @@ int main(int argc, char** argv) {
   bool transfer = false;
   bool validation = false;
   bool empty = false;
+  std::string syntheticLayers;
+  int syntheticFanIn = 0;
+  long syntheticBurn = 0;
+  int syntheticExternalWork = 0;
+  long syntheticExternalTime = 0;
   for (auto i = args.begin() + 1, e = args.end(); i != e; ++i) {
     if (*i == "-h" or *i == "--help") {
       print_help(args.front());
@@ -61,6 +87,21 @@ int main(int argc, char** argv) {
       validation = true;
     } else if (*i == "--empty") {
       empty = true;
+    } else if (*i == "--synthetic") {
+      ++i;
+      syntheticLayers = *i;
+    } else if (*i == "--syntheticFanIn") {
+      ++i;
+      syntheticFanIn = std::stoi(*i);
+    } else if (*i == "--syntheticBurn") {
+      ++i;
+      syntheticBurn = std::stol(*i);
+    } else if (*i == "--syntheticExternalWork") {
+      ++i;
+      syntheticExternalWork = std::stoi(*i);
+    } else if (*i == "--syntheticExternalTime") {
+      ++i;
+      syntheticExternalTime = std::stol(*i);
     } else {
       std::cout << "Invalid parameter " << *i << std::endl << std::endl;
       print_help(args.front());
@@ -78,10 +119,28 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
 
+  bool const isSynthetic = not syntheticLayers.empty();
+  if (isSynthetic) {
+    try {
+      synthetic::setWorkload(synthetic::Workload(synthetic::Workload::parseLayers(syntheticLayers),
+                                                 syntheticFanIn,
+                                                 std::chrono::nanoseconds(syntheticBurn),
+                                                 syntheticExternalWork,
+                                                 std::chrono::microseconds(syntheticExternalTime)));
+    } catch (std::exception& e) {
+      std::cout << "Invalid synthetic workload: " << e.what() << std::endl << std::endl;
+      print_help(args.front());
+      return EXIT_FAILURE;
+    }
+  }
+
   // Initialize EventProcessor
   std::vector<std::string> edmodules;
   std::vector<std::string> esmodules;
-  if (not empty) {
+  if (isSynthetic and not empty) {
+    // the modules find their description from their position in the path
+    edmodules.assign(synthetic::workload().modules().size(), "SyntheticProducer");
+  } else if (not empty) {
     edmodules = {"TestProducer", "TestProducer3", "TestProducer2"};
     esmodules = {"IntESProducer"};
     if (transfer) {
@@ -96,9 +155,11 @@ int main(int argc, char** argv) {
             << numberOfThreads << " threads." << std::endl;
 
   // Initialize tasks scheduler (thread pool)
-  tbb::task_scheduler_init tsi(numberOfThreads);
+  tbb::global_control globalControl(tbb::global_control::max_allowed_parallelism, numberOfThreads);
 
   // Run work
+  auto const contentionStart = edm::WaitingTaskList::contention();
+  double const cpuStart = cpuTime();
   auto start = std::chrono::high_resolution_clock::now();
   try {
     processor.runToCompletion();
@@ -115,6 +176,8 @@ int main(int argc, char** argv) {
     return EXIT_FAILURE;
   }
   auto stop = std::chrono::high_resolution_clock::now();
+  double const cpuStop = cpuTime();
+  auto const contentionStop = edm::WaitingTaskList::contention();
 
   // Run endJob
   try {
@@ -137,5 +200,30 @@ int main(int argc, char** argv) {
   auto time = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(diff).count()) / 1e6;
   std::cout << "Processed " << maxEvents << " events in " << std::scientific << time << " seconds, throughput "
             << std::defaultfloat << (maxEvents / time) << " events/s." << std::endl;
+  if (isSynthetic and not empty) {
+    // The CPU time of the threads not spent in the modules is attributed to the framework, including the time
+    // the TBB threads spin for work. The idle threads, and the wait for the external work, do not use the CPU.
+    auto const& workload = synthetic::workload();
+    int const modules = workload.modules().size();
+    double const threadTime = cpuStop - cpuStart;
+    double const moduleTime = static_cast<double>(workload.burnPerEvent().count()) * maxEvents;
+    double const overhead = (threadTime - moduleTime) / maxEvents;
+    std::cout << "Synthetic workload of " << modules << " modules in " << workload.numberOfLayers() << " layers, "
+              << workload.numberOfExternalWorkModules() << " with external work." << std::endl;
+    std::cout << "Framework overhead " << std::fixed << std::setprecision(1) << (overhead / modules)
+              << " ns per module, " << (overhead / 1000.) << " us per event of CPU time, modules busy "
+              << (100. * moduleTime / threadTime) << "% of the CPU time." << std::endl;
+    auto perEvent = [maxEvents](unsigned long long start, unsigned long long stop) {
+      return static_cast<double>(stop - start) / maxEvents;
+    };
+    std::cout << std::setprecision(3) << "WaitingTaskList contention per event: "
+              << perEvent(contentionStart.overlappingAdds, contentionStop.overlappingAdds)
+              << " overlapping add(), "
+              << perEvent(contentionStart.racedAdds, contentionStop.racedAdds) << " add() racing doneWaiting(), "
+              << perEvent(contentionStart.linkWaits, contentionStop.linkWaits) << " waits for a link ("
+              << perEvent(contentionStart.pauses, contentionStop.pauses) << " pauses), "
+              << perEvent(contentionStart.uncachedNodes, contentionStop.uncachedNodes) << " uncached nodes."
+              << std::endl;
+  }
   return EXIT_SUCCESS;
 }
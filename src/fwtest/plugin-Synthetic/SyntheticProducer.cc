@@ -0,0 +1,158 @@
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Framework/EDProducer.h"
+#include "Framework/Event.h"
+#include "Framework/PluginFactory.h"
+#include "SyntheticCore/Workload.h"
+
+namespace {
+  // The products of the modules must all be of different types
+  template <int I>
+  struct SyntheticProduct {
+    unsigned int value;
+  };
+
+  using Getter = std::function<unsigned int(edm::Event const&)>;
+  using Putter = std::function<void(edm::Event&, unsigned int)>;
+
+  template <int I>
+  Getter consumesProduct(edm::ProductRegistry& reg) {
+    return [token = reg.consumes<SyntheticProduct<I>>()](edm::Event const& event) { return event.get(token).value; };
+  }
+
+  template <int I>
+  Putter producesProduct(edm::ProductRegistry& reg) {
+    return [token = reg.produces<SyntheticProduct<I>>()](edm::Event& event, unsigned int value) {
+      event.emplace(token, SyntheticProduct<I>{value});
+    };
+  }
+
+  template <int... I>
+  constexpr auto consumesTable(std::integer_sequence<int, I...>) {
+    return std::array<Getter (*)(edm::ProductRegistry&), sizeof...(I)>{{&consumesProduct<I>...}};
+  }
+
+  template <int... I>
+  constexpr auto producesTable(std::integer_sequence<int, I...>) {
+    return std::array<Putter (*)(edm::ProductRegistry&), sizeof...(I)>{{&producesProduct<I>...}};
+  }
+
+  constexpr auto consumesByIndex = consumesTable(std::make_integer_sequence<int, synthetic::Workload::kMaxModules>{});
+  constexpr auto producesByIndex = producesTable(std::make_integer_sequence<int, synthetic::Workload::kMaxModules>{});
+
+  // Keeps the thread busy, unlike sleep_for(), and without touching the memory
+  void burn(std::chrono::nanoseconds time) {
+    if (time.count() <= 0) {
+      return;
+    }
+    auto const end = std::chrono::steady_clock::now() + time;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+  }
+
+  // Plays the role of the runtime of an accelerator: notifies the framework from a thread of its own once
+  // the work handed over by acquire() is done. All the work takes the same time, so it ends in FIFO order.
+  class ExternalWorker {
+  public:
+    ExternalWorker() : thread_([this]() { run(); }) {}
+
+    ~ExternalWorker() {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+      }
+      cond_.notify_one();
+      thread_.join();
+    }
+
+    void push(std::chrono::steady_clock::time_point done, edm::WaitingTaskWithArenaHolder holder) {
+      {
+        std::lock_guard<std::mutex> guard(mutex_);
+        queue_.emplace_back(done, std::move(holder));
+      }
+      cond_.notify_one();
+    }
+
+  private:
+    void run() {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        cond_.wait(lock, [this]() { return stop_ or not queue_.empty(); });
+        if (queue_.empty()) {
+          return;
+        }
+        auto work = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        std::this_thread::sleep_until(work.first);
+        work.second.doneWaiting(std::exception_ptr{});
+        lock.lock();
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<std::pair<std::chrono::steady_clock::time_point, edm::WaitingTaskWithArenaHolder>> queue_;
+    bool stop_ = false;
+    std::thread thread_;
+  };
+
+  ExternalWorker& externalWorker() {
+    static ExternalWorker worker;
+    return worker;
+  }
+}  // namespace
+
+// Module of the synthetic workload, configured by the description of its index in the path. The path must
+// contain only SyntheticProducer modules, see synthetic::Workload.
+class SyntheticProducer : public edm::EDProducerExternalWork {
+public:
+  explicit SyntheticProducer(edm::ProductRegistry& reg);
+
+  // Hides the one of the base class, only the modules configured for it go through acquire()
+  bool hasAcquire() const { return description_.externalWork; }
+
+private:
+  void acquire(edm::Event const& event,
+               edm::EventSetup const& eventSetup,
+               edm::WaitingTaskWithArenaHolder holder) override;
+  void produce(edm::Event& event, edm::EventSetup const& eventSetup) override;
+
+  synthetic::ModuleDescription const& description_;
+  std::vector<Getter> getters_;
+  Putter putter_;
+};
+
+SyntheticProducer::SyntheticProducer(edm::ProductRegistry& reg)
+    : description_(synthetic::workload().modules().at(reg.currentModuleIndex() - 1)) {
+  getters_.reserve(description_.consumes.size());
+  for (int index : description_.consumes) {
+    getters_.push_back(consumesByIndex[index](reg));
+  }
+  putter_ = producesByIndex[reg.currentModuleIndex() - 1](reg);
+}
+
+void SyntheticProducer::acquire(edm::Event const& event,
+                                edm::EventSetup const& eventSetup,
+                                edm::WaitingTaskWithArenaHolder holder) {
+  externalWorker().push(std::chrono::steady_clock::now() + description_.externalTime, std::move(holder));
+}
+
+void SyntheticProducer::produce(edm::Event& event, edm::EventSetup const& eventSetup) {
+  unsigned int value = 1;
+  for (auto const& get : getters_) {
+    value += get(event);
+  }
+  burn(description_.burn);
+  putter_(event, value);
+}
+
+DEFINE_FWK_MODULE(SyntheticProducer);
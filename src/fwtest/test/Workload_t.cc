@@ -0,0 +1,59 @@
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "SyntheticCore/Workload.h"
+
+int main() {
+  using synthetic::Workload;
+
+  assert((Workload::parseLayers("1,64,1") == std::vector<int>{1, 64, 1}));
+  assert((Workload::parseLayers("3x2,1") == std::vector<int>{2, 2, 2, 1}));
+
+  // fan-out followed by a fan-in
+  {
+    Workload w({1, 4, 1}, 0, std::chrono::nanoseconds(100), 0, std::chrono::microseconds(0));
+    auto const& m = w.modules();
+    assert(m.size() == 6);
+    assert(w.numberOfLayers() == 3);
+    assert(m[0].consumes.empty());
+    for (int i = 1; i <= 4; ++i) {
+      assert((m[i].consumes == std::vector<int>{0}));
+    }
+    assert((m[5].consumes == std::vector<int>{1, 2, 3, 4}));
+    assert(w.burnPerEvent() == std::chrono::nanoseconds(600));
+    assert(w.numberOfExternalWorkModules() == 0);
+  }
+
+  // each module consumes, and is consumed by, fanIn modules
+  {
+    Workload w({3, 3}, 2, std::chrono::nanoseconds(0), 2, std::chrono::microseconds(10));
+    auto const& m = w.modules();
+    assert((m[3].consumes == std::vector<int>{0, 1}));
+    assert((m[4].consumes == std::vector<int>{1, 2}));
+    assert((m[5].consumes == std::vector<int>{2, 0}));
+    assert(not m[0].externalWork and m[1].externalWork and m[3].externalWork and m[5].externalWork);
+    assert(w.numberOfExternalWorkModules() == 3);
+  }
+
+  bool thrown = false;
+  try {
+    Workload w({Workload::kMaxModules, 1}, 0, std::chrono::nanoseconds(0), 0, std::chrono::microseconds(0));
+  } catch (std::invalid_argument const&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  thrown = false;
+  try {
+    Workload w({1, 2}, -1, std::chrono::nanoseconds(0), 0, std::chrono::microseconds(0));
+  } catch (std::invalid_argument const&) {
+    thrown = true;
+  }
+  assert(thrown);
+
+  std::cout << "TEST PASSED" << std::endl;
+  return 0;
+}
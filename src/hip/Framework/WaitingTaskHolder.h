@@ -21,6 +21,8 @@
 // system include files
 #include <cassert>
 
+#include <tbb/task_group.h>
+
 // user include files
 #include "Framework/WaitingTask.h"
 
@@ -29,28 +31,52 @@
 namespace edm {
   class WaitingTaskHolder {
   public:
-    WaitingTaskHolder() : m_task(nullptr) {}
+    friend class WaitingTaskList;
+    friend class WaitingTaskWithArenaHolder;
+
+    WaitingTaskHolder() : m_task(nullptr), m_group(nullptr) {}
 
-    explicit WaitingTaskHolder(edm::WaitingTask* iTask) : m_task(iTask) { m_task->increment_ref_count(); }
+    explicit WaitingTaskHolder(tbb::task_group& iGroup, edm::WaitingTask* iTask) : m_task(iTask), m_group(&iGroup) {
+      m_task->increment_ref_count();
+    }
     ~WaitingTaskHolder() {
       if (m_task) {
         doneWaiting(std::exception_ptr{});
       }
     }
 
-    WaitingTaskHolder(const WaitingTaskHolder& iHolder) : m_task(iHolder.m_task) { m_task->increment_ref_count(); }
+    WaitingTaskHolder(const WaitingTaskHolder& iHolder) : m_task(iHolder.m_task), m_group(iHolder.m_group) {
+      m_task->increment_ref_count();
+    }
 
-    WaitingTaskHolder(WaitingTaskHolder&& iOther) : m_task(iOther.m_task) { iOther.m_task = nullptr; }
+    WaitingTaskHolder(WaitingTaskHolder&& iOther) : m_task(iOther.m_task), m_group(iOther.m_group) {
+      iOther.m_task = nullptr;
+    }
 
     WaitingTaskHolder& operator=(const WaitingTaskHolder& iRHS) {
       WaitingTaskHolder tmp(iRHS);
       std::swap(m_task, tmp.m_task);
+      std::swap(m_group, tmp.m_group);
+      return *this;
+    }
+
+    WaitingTaskHolder& operator=(WaitingTaskHolder&& iRHS) {
+      WaitingTaskHolder tmp(std::move(iRHS));
+      std::swap(m_task, tmp.m_task);
+      std::swap(m_group, tmp.m_group);
       return *this;
     }
 
     // ---------- const member functions ---------------------
     bool taskHasFailed() const { return m_task->exceptionPtr() != nullptr; }
 
+    bool hasTask() const { return m_task != nullptr; }
+
+    /** since oneTBB doesn't provide a way to get the task group of the running task,
+        the holders carry it to the tasks that are run on their behalf.
+    */
+    tbb::task_group* group() const { return m_group; }
+
     // ---------- static member functions --------------------
 
     // ---------- member functions ---------------------------
@@ -70,20 +96,24 @@ namespace edm {
       if (iExcept) {
         m_task->dependentTaskFailed(iExcept);
       }
-      //spawn can run the task before we finish
+      //run can run the task before we finish
       // doneWaiting and some other thread might
       // try to reuse this object. Resetting
-      // before spawn avoids problems
+      // before run avoids problems
       auto task = m_task;
       m_task = nullptr;
       if (0 == task->decrement_ref_count()) {
-        tbb::task::spawn(*task);
+        m_group->run([task]() {
+          TaskSentry s{task};
+          task->execute();
+        });
       }
     }
 
   private:
     // ---------- member data --------------------------------
     WaitingTask* m_task;
+    tbb::task_group* m_group;
   };
 }  // namespace edm
 
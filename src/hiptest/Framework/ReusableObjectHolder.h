@@ -72,7 +72,6 @@
 #include <memory>
 #include <cassert>
 #include <atomic>
-#include "tbb/task.h"
 #include "tbb/concurrent_queue.h"
 
 namespace edm {
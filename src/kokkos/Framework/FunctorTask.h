@@ -7,10 +7,10 @@
 //
 /**\class FunctorTask FunctorTask.h FWCore/Concurrency/interface/FunctorTask.h
 
- Description: Builds a tbb::task from a lambda.
+ Description: Builds a TaskBase from a lambda.
 
  Usage:
- 
+
 */
 //
 // Original Author:  Chris Jones
@@ -22,30 +22,27 @@
 #include <atomic>
 #include <exception>
 #include <memory>
-#include "tbb/task.h"
 
 // user include files
+#include "Framework/TaskBase.h"
 
 // forward declarations
 
 namespace edm {
   template <typename F>
-  class FunctorTask : public tbb::task {
+  class FunctorTask : public TaskBase {
   public:
     explicit FunctorTask(F f) : func_(std::move(f)) {}
 
-    task* execute() override {
-      func_();
-      return nullptr;
-    };
+    void execute() final { func_(); };
 
   private:
     F func_;
   };
 
-  template <typename ALLOC, typename F>
-  FunctorTask<F>* make_functor_task(ALLOC&& iAlloc, F f) {
-    return new (iAlloc) FunctorTask<F>(std::move(f));
+  template <typename F>
+  FunctorTask<F>* make_functor_task(F f) {
+    return new FunctorTask<F>(std::move(f));
   }
 }  // namespace edm
 
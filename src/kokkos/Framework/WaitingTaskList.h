@@ -11,7 +11,7 @@
 
  Usage:
     This class can be used to have tasks wait to be spawned until a resource is available.
- Tasks that want to use the resource are added to the list by calling add(tbb::task*).
+ Tasks that want to use the resource are added to the list by calling add(WaitingTaskHolder).
  When the resource becomes available one calls doneWaiting() and then any waiting tasks will
  be spawned. If a call to add() is made after doneWaiting() the newly added task will
  immediately be spawned.
@@ -27,7 +27,7 @@
     CalcTask(edm::WaitingTaskList* iWL, Value* v):
     m_waitList(iWL), m_output(v) {}
  
-    tbb::task* execute() {
+    void execute() final {
      std::exception_ptr ptr;
      try {
        *m_output = doCalculation();
@@ -35,7 +35,6 @@
        ptr = std::current_exception();
      }
      m_waitList.doneWaiting(ptr);
-     return nullptr;
     }
     private:
      edm::WaitingTaskList* m_waitList;
@@ -51,16 +50,13 @@
 
  In another part we can start the calculation
  \code
- tbb::task* calc = new(tbb::task::allocate_root()) CalcTask(&waitList,&v);
- tbb::task::spawn(calc);
+ edm::WaitingTaskHolder calc(group, new CalcTask(&waitList,&v));
  \endcode
  
  Finally in some unrelated part of the code we can create tasks that need the calculation
  \code
- tbb::task* t1 = makeTask1(v);
- waitList.add(t1);
- tbb::task* t2 = makeTask2(v);
- waitList.add(t2);
+ waitList.add(edm::WaitingTaskHolder(group, makeTask1(v)));
+ waitList.add(edm::WaitingTaskHolder(group, makeTask2(v)));
  \endcode
 
 */
@@ -75,28 +71,11 @@
 
 // user include files
 #include "Framework/WaitingTask.h"
+#include "Framework/WaitingTaskHolder.h"
 
 // forward declarations
 
 namespace edm {
-  class EmptyWaitingTask : public WaitingTask {
-  public:
-    EmptyWaitingTask() = default;
-
-    tbb::task* execute() override { return nullptr; }
-  };
-
-  namespace waitingtask {
-    struct TaskDestroyer {
-      void operator()(tbb::task* iTask) const { tbb::task::destroy(*iTask); }
-    };
-  }  // namespace waitingtask
-  ///Create an EmptyWaitingTask which will properly be destroyed
-  inline std::unique_ptr<edm::EmptyWaitingTask, waitingtask::TaskDestroyer> make_empty_waiting_task() {
-    return std::unique_ptr<edm::EmptyWaitingTask, waitingtask::TaskDestroyer>(new (tbb::task::allocate_root())
-                                                                                  edm::EmptyWaitingTask{});
-  }
-
   class WaitingTaskList {
   public:
     ///Constructor
@@ -117,12 +96,15 @@ namespace edm {
     void presetTaskAsFailed(std::exception_ptr iExcept);
 
     ///Adds task to the waiting list
-    /**If doneWaiting() has already been called then the added task will immediately be spawned.
+    /**If doneWaiting() has already been called then the added task will immediately be run in its group.
        * If that is not the case then the task will be held until doneWaiting() is called and will
-       * then be spawned.
+       * then be run.
        * Calls to add() and doneWaiting() can safely be done concurrently.
        */
-    void add(WaitingTask*);
+    void add(WaitingTaskHolder);
+
+    ///Adds task to the waiting list, to be run in the given group
+    void add(tbb::task_group*, WaitingTask*);
 
     ///Signals that the resource is now available and tasks should be spawned
     /**The owner of the resource calls this function to allow the waiting tasks to
@@ -141,6 +123,16 @@ namespace edm {
        */
     void reset();
 
+    ///Counters of the contention over all the WaitingTaskLists of the job
+    struct Contention {
+      unsigned long long overlappingAdds;  ///< add() calls that found the previous add() still linking its node
+      unsigned long long racedAdds;        ///< add() calls that lost the race with doneWaiting() and announced
+      unsigned long long linkWaits;        ///< nodes that announce() found not yet linked by their add()
+      unsigned long long pauses;           ///< hardware_pause() calls while waiting for those links
+      unsigned long long uncachedNodes;    ///< nodes allocated because the node cache was full
+    };
+    static Contention contention();
+
   private:
     WaitingTaskList(const WaitingTaskList&) = delete;                   // stop default
     const WaitingTaskList& operator=(const WaitingTaskList&) = delete;  // stop default
@@ -152,6 +144,7 @@ namespace edm {
 
     struct WaitNode {
       WaitingTask* m_task;
+      tbb::task_group* m_group;
       std::atomic<WaitNode*> m_next;
       bool m_fromCache;
 
@@ -160,7 +153,10 @@ namespace edm {
       WaitNode* nextNode() const { return m_next; }
     };
 
-    WaitNode* createNode(WaitingTask* iTask);
+    WaitNode* createNode(tbb::task_group* iGroup, WaitingTask* iTask);
+
+    ///Waits for the add() that made iNode the head to link it to the rest of the list
+    static WaitNode* waitForNextNode(WaitNode* iNode);
 
     // ---------- member data --------------------------------
     std::atomic<WaitNode*> m_head;
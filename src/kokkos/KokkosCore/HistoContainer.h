@@ -117,7 +117,7 @@ namespace cms {
       // because the number of blocks depends on the number of threads.
       //
       // Maybe this would really be a case for RangePolicy?
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
       const auto nblocks = (totSize + ExecSpace::impl_thread_pool_size()) / ExecSpace::impl_thread_pool_size();
       auto tp = hintLightWeight(TeamPolicy(execSpace, nblocks, ExecSpace::impl_thread_pool_size()));
 #else
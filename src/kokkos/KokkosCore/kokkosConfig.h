@@ -10,6 +10,9 @@ using KokkosExecSpace = Kokkos::Serial;
 #elif defined KOKKOS_BACKEND_PTHREAD
 using KokkosExecSpace = Kokkos::Threads;
 #define KOKKOS_NAMESPACE kokkos_pthread
+#elif defined KOKKOS_BACKEND_OPENMP
+using KokkosExecSpace = Kokkos::OpenMP;
+#define KOKKOS_NAMESPACE kokkos_openmp
 #elif defined KOKKOS_BACKEND_CUDA
 using KokkosExecSpace = Kokkos::Cuda;
 #define KOKKOS_NAMESPACE kokkos_cuda
@@ -33,6 +36,12 @@ struct KokkosBackend<Kokkos::Threads> {
   static constexpr auto value = kokkos_common::InitializeScopeGuard::Backend::PTHREAD;
 };
 #endif
+#ifdef KOKKOS_ENABLE_OPENMP
+template <>
+struct KokkosBackend<Kokkos::OpenMP> {
+  static constexpr auto value = kokkos_common::InitializeScopeGuard::Backend::OPENMP;
+};
+#endif
 #ifdef KOKKOS_ENABLE_CUDA
 template <>
 struct KokkosBackend<Kokkos::Cuda> {
@@ -7,7 +7,7 @@
 #include <string>
 #include <vector>
 
-#include <tbb/task_scheduler_init.h>
+#include <tbb/global_control.h>
 
 #include "KokkosCore/kokkosConfigCommon.h"
 #define KOKKOS_MACROS_HPP
@@ -23,6 +23,9 @@ namespace {
 #ifdef KOKKOS_ENABLE_THREADS
         << " [--pthread]"
 #endif
+#ifdef KOKKOS_ENABLE_OPENMP
+        << " [--openmp]"
+#endif
 #ifdef KOKKOS_ENABLE_CUDA
         << " [--cuda]"
 #endif
@@ -36,6 +39,9 @@ namespace {
 #ifdef KOKKOS_ENABLE_THREADS
         << " --pthread               Use CPU pthread backend\n"
 #endif
+#ifdef KOKKOS_ENABLE_OPENMP
+        << " --openmp                Use CPU OpenMP backend\n"
+#endif
 #ifdef KOKKOS_ENABLE_CUDA
         << " --cuda                  Use CUDA backend\n"
 #endif
@@ -75,6 +81,10 @@ int main(int argc, char** argv) {
     } else if (*i == "--pthread") {
       backends.emplace_back(Backend::PTHREAD);
 #endif
+#ifdef KOKKOS_ENABLE_OPENMP
+    } else if (*i == "--openmp") {
+      backends.emplace_back(Backend::OPENMP);
+#endif
 #ifdef KOKKOS_ENABLE_CUDA
     } else if (*i == "--cuda") {
       backends.emplace_back(Backend::CUDA);
@@ -121,7 +131,7 @@ int main(int argc, char** argv) {
   }
 
   // Initialize Kokkos
-#ifdef KOKKOS_ENABLE_THREADS
+#if defined KOKKOS_ENABLE_THREADS || defined KOKKOS_ENABLE_OPENMP
   kokkos_common::InitializeScopeGuard kokkosGuard(backends, numberOfThreads);
 #else
   kokkos_common::InitializeScopeGuard kokkosGuard(backends, 1);
@@ -157,6 +167,7 @@ int main(int argc, char** argv) {
     };
     addModules("kokkos_serial::", Backend::SERIAL);
     addModules("kokkos_pthread::", Backend::PTHREAD);
+    addModules("kokkos_openmp::", Backend::OPENMP);
     addModules("kokkos_cuda::", Backend::CUDA);
     addModules("kokkos_hip::", Backend::HIP);
   }
@@ -168,7 +179,7 @@ int main(int argc, char** argv) {
             << numberOfThreads << " threads." << std::endl;
 
   // Initialize tasks scheduler (thread pool)
-  tbb::task_scheduler_init tsi(numberOfThreads);
+  tbb::global_control globalControl(tbb::global_control::max_allowed_parallelism, numberOfThreads);
 
   // Run work
   auto start = std::chrono::high_resolution_clock::now();
@@ -48,7 +48,7 @@ namespace KOKKOS_NAMESPACE {
     assert(teamSize > 0 && 0 == teamSize % 16);
     teamSize *= stride;
 
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
     // unit team size and stride loop for host execution
     auto policy = hintLightWeight(Kokkos::TeamPolicy<KokkosExecSpace>{execSpace, leagueSize, 1});
     stride = 1;
@@ -100,7 +100,7 @@ namespace KOKKOS_NAMESPACE {
       int stride = 16;
       int blockSize = teamSize / stride;
       int leagueSize = (nhits + blockSize - 1) / blockSize;
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
       // unit team size and stride loop for host execution
       auto policy = hintLightWeight(Kokkos::TeamPolicy<KokkosExecSpace>{execSpace, leagueSize, 1});
       stride = 1;
@@ -178,7 +178,7 @@ namespace KOKKOS_NAMESPACE {
       int stride = 16;
       int blockSize = teamSize / stride;
       int leagueSize = (nhits + blockSize - 1) / blockSize;
-#if defined KOKKOS_BACKEND_SERIAL || KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
       // unit team size and stride loop for host execution
       auto policy = hintLightWeight(Kokkos::TeamPolicy<KokkosExecSpace>{execSpace, leagueSize, 1});
       stride = 1;
@@ -194,7 +194,7 @@ namespace KOKKOS_NAMESPACE {
     if (m_params.doStats_) {
       teamSize = 128;
       leagueSize = (std::max(nhits, m_params.maxNumberOfDoublets_) + teamSize - 1) / teamSize;
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
       policy = hintLightWeight(Kokkos::TeamPolicy<KokkosExecSpace>(execSpace, leagueSize, Kokkos::AUTO()));
 #else
       policy = hintLightWeight(Kokkos::TeamPolicy<KokkosExecSpace>(execSpace, leagueSize, teamSize));
@@ -291,7 +291,7 @@ namespace KOKKOS_NAMESPACE {
     }
 
     assert(nActualPairs <= gpuPixelDoublets::nPairs);
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
     int stride = 1;
     Kokkos::TeamPolicy<KokkosExecSpace,
                        Kokkos::LaunchBounds<gpuPixelDoublets::getDoubletsFromHistoMaxBlockSize,
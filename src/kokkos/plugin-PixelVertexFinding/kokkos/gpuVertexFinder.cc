@@ -135,7 +135,7 @@ namespace KOKKOS_NAMESPACE {
           hintLightWeight(Kokkos::RangePolicy<KokkosExecSpace>(execSpace, 0, TkSoA::stride())),
           KOKKOS_LAMBDA(const size_t i) { loadTracks(tksoa, vertices_d, workspace_d, ptMin, i); });
 
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
       auto policy = TeamPolicy(execSpace, 1, Kokkos::AUTO()).set_scratch_size(0, Kokkos::PerTeam(8192 * 4));
 #else
       auto policy = TeamPolicy(execSpace, 1, 128).set_scratch_size(0, Kokkos::PerTeam(8192 * 4));
@@ -176,7 +176,7 @@ namespace KOKKOS_NAMESPACE {
         // one block per vertex...
         Kokkos::parallel_for(
             "splitVertices",
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
             hintLightWeight(TeamPolicy(execSpace, 1024, Kokkos::AUTO()).set_scratch_size(0, Kokkos::PerTeam(8192 * 4))),
 #else
             hintLightWeight(TeamPolicy(execSpace, 1024, 128).set_scratch_size(0, Kokkos::PerTeam(8192 * 4))),
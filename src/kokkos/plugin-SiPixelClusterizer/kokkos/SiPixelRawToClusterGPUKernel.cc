@@ -695,7 +695,7 @@ namespace KOKKOS_NAMESPACE {
             execSpace, Kokkos::subview(nModules_Clusters_h, 0), Kokkos::subview(clusters_d.moduleStart(), 0));
 
         const uint32_t blocks = ::gpuClustering::MaxNumModules;
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
         Kokkos::TeamPolicy<KokkosExecSpace> teamPolicy(execSpace, blocks, Kokkos::AUTO());
 #else
         Kokkos::TeamPolicy<KokkosExecSpace> teamPolicy(execSpace, blocks, 256);
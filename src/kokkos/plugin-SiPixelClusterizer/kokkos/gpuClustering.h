@@ -131,7 +131,7 @@ namespace KOKKOS_NAMESPACE::gpuClustering {
 
           const uint32_t hist_size = d_hist().size();
 
-#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_PTHREAD || defined KOKKOS_BACKEND_OPENMP
           const uint32_t maxiter = hist_size;
 #else
           const uint32_t maxiter = 16;
@@ -176,6 +176,10 @@ namespace KOKKOS_NAMESPACE {
     std::string fname =
         "histograms_kokkos_pthread_" + std::to_string(KokkosExecSpace::impl_thread_pool_size()) + ".txt";
     std::ofstream out(fname.c_str());
+#elif defined KOKKOS_BACKEND_OPENMP
+    std::string fname =
+        "histograms_kokkos_openmp_" + std::to_string(KokkosExecSpace::impl_thread_pool_size()) + ".txt";
+    std::ofstream out(fname.c_str());
 #elif defined KOKKOS_BACKEND_CUDA
     std::ofstream out("histograms_kokkos_cuda.txt");
 #elif defined KOKKOS_BACKEND_HIP
@@ -33,7 +33,7 @@ void countMultiLocal(Kokkos::View<uint16_t**, ExecSpace, Restrict> const& tk,
   auto nThreads = 256;
   auto nBlocks = (4 * n + nThreads - 1) / nThreads;
 
-#ifndef KOKKOS_BACKEND_SERIAL
+#if !defined KOKKOS_BACKEND_SERIAL && !defined KOKKOS_BACKEND_OPENMP
   TeamPolicy policy(execSpace, nBlocks, nThreads);
 #else
   TeamPolicy policy(execSpace, nBlocks * nThreads, 1);
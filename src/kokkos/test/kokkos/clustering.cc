@@ -273,7 +273,8 @@ void test() {
         });
     KokkosExecSpace().fence();
 
-#ifdef KOKKOS_BACKEND_SERIAL
+#if defined KOKKOS_BACKEND_SERIAL || defined KOKKOS_BACKEND_OPENMP
+    // the OpenMP team size is limited by the number of threads, parallelize over the modules instead
     uint32_t threadsPerModule = 1;
 #else
     uint32_t threadsPerModule = (kkk == 5) ? 512 : ((kkk == 3) ? 128 : 256);
@@ -24,10 +24,10 @@ namespace edm {
     void setItemsToGet(std::vector<Worker*> workers) { itemsToGet_ = std::move(workers); }
 
     // thread safe
-    void prefetchAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask);
+    void prefetchAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask);
 
     // not thread safe
-    virtual void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask) = 0;
+    virtual void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask) = 0;
 
     // definitively not thread safe
     virtual void doWork(Event& event, EventSetup const& eventSetup) = 0;
@@ -54,15 +54,16 @@ namespace edm {
   public:
     explicit WorkerT(ProductRegistry& reg) : producer_(reg), workStarted_{false} {}
 
-    void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTask* iTask) override {
-      waitingTasksWork_.add(iTask);
+    void doWorkAsync(Event& event, EventSetup const& eventSetup, WaitingTaskHolder iTask) override {
+      auto group = iTask.group();
+      waitingTasksWork_.add(std::move(iTask));
       //std::cout << "doWorkAsync for " << this << " with iTask " << iTask << std::endl;
       bool expected = false;
       if (workStarted_.compare_exchange_strong(expected, true)) {
         //std::cout << "first doWorkAsync call" << std::endl;
 
-        WaitingTask* moduleTask = make_waiting_task(
-            tbb::task::allocate_root(), [this, &event, &eventSetup](std::exception_ptr const* iPtr) mutable {
+        WaitingTaskHolder moduleTask(
+            *group, make_waiting_task([this, &event, &eventSetup](std::exception_ptr const* iPtr) mutable {
               if (iPtr) {
                 waitingTasksWork_.doneWaiting(*iPtr);
               } else {
@@ -76,42 +77,40 @@ namespace edm {
                 //std::cout << "waitingTasksWork_.doneWaiting " << this << std::endl;
                 waitingTasksWork_.doneWaiting(exceptionPtr);
               }
-            });
+            }));
         if (producer_.hasAcquire()) {
-          WaitingTaskWithArenaHolder runProduceHolder{moduleTask};
-          moduleTask = make_waiting_task(tbb::task::allocate_root(),
-                                         [this, &event, &eventSetup, runProduceHolder = std::move(runProduceHolder)](
-                                             std::exception_ptr const* iPtr) mutable {
-                                           if (iPtr) {
-                                             runProduceHolder.doneWaiting(*iPtr);
-                                           } else {
-                                             std::exception_ptr exceptionPtr;
-                                             try {
-                                               producer_.doAcquire(event, eventSetup, runProduceHolder);
-                                             } catch (...) {
-                                               exceptionPtr = std::current_exception();
-                                             }
-                                             runProduceHolder.doneWaiting(exceptionPtr);
-                                           }
-                                         });
+          WaitingTaskWithArenaHolder runProduceHolder{std::move(moduleTask)};
+          moduleTask = WaitingTaskHolder(
+              *group,
+              make_waiting_task([this, &event, &eventSetup, runProduceHolder = std::move(runProduceHolder)](
+                                    std::exception_ptr const* iPtr) mutable {
+                if (iPtr) {
+                  runProduceHolder.doneWaiting(*iPtr);
+                } else {
+                  std::exception_ptr exceptionPtr;
+                  try {
+                    producer_.doAcquire(event, eventSetup, runProduceHolder);
+                  } catch (...) {
+                    exceptionPtr = std::current_exception();
+                  }
+                  runProduceHolder.doneWaiting(exceptionPtr);
+                }
+              }));
         }
         //std::cout << "calling prefetchAsync " << this << " with moduleTask " << moduleTask << std::endl;
-        prefetchAsync(event, eventSetup, moduleTask);
+        prefetchAsync(event, eventSetup, std::move(moduleTask));
       }
     }
 
     void doWork(Event& event, EventSetup const& eventSetup) override {
       if (producer_.hasAcquire()) {
-        auto waitTask = make_empty_waiting_task();
-        waitTask->increment_ref_count();
+        tbb::task_group group;
+        FinalWaitingTask waitTask{group};
         {
-          WaitingTaskWithArenaHolder runProducerHolder{waitTask.get()};
+          WaitingTaskWithArenaHolder runProducerHolder{group, &waitTask};
           producer_.doAcquire(event, eventSetup, runProducerHolder);
         }
-        waitTask->wait_for_all();
-        if (waitTask->exceptionPtr()) {
-          std::rethrow_exception(*(waitTask->exceptionPtr()));
-        }
+        waitTask.wait();
       }
       producer_.doProduce(event, eventSetup);
     }
@@ -13,6 +13,10 @@ namespace kokkos_common {
       // Not initializing tends to lead to "use of uninitialized execution space" errors at run time
 #ifdef KOKKOS_ENABLE_THREADS
       Kokkos::Threads::impl_initialize(args.num_threads);
+#endif
+      // Same for OPENMP
+#ifdef KOKKOS_ENABLE_OPENMP
+      Kokkos::OpenMP::impl_initialize(args.num_threads);
 #endif
       if (std::find(backends.begin(), backends.end(), Backend::CUDA) != backends.end()) {
 #ifdef KOKKOS_ENABLE_CUDA
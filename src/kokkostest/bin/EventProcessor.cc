@@ -1,4 +1,5 @@
-#include "Framework/EmptyWaitingTask.h"
+#include <tbb/task_group.h>
+
 #include "Framework/ESPluginFactory.h"
 #include "Framework/WaitingTask.h"
 #include "Framework/WaitingTaskHolder.h"
@@ -30,21 +31,19 @@ namespace edm {
   }
 
   void EventProcessor::runToCompletion() {
-#ifdef KOKKOS_ENABLE_THREADS
+#if defined KOKKOS_ENABLE_THREADS || defined KOKKOS_ENABLE_OPENMP
+    // the host-parallel execution spaces do not support concurrent kernel launches from multiple threads
     for (auto& s : schedules_) {
       s.runToCompletion();
     }
 #else
     // The task that waits for all other work
-    auto globalWaitTask = make_empty_waiting_task();
-    globalWaitTask->increment_ref_count();
+    tbb::task_group group;
+    FinalWaitingTask globalWaitTask{group};
     for (auto& s : schedules_) {
-      s.runToCompletionAsync(WaitingTaskHolder(globalWaitTask.get()));
-    }
-    globalWaitTask->wait_for_all();
-    if (globalWaitTask->exceptionPtr()) {
-      std::rethrow_exception(*(globalWaitTask->exceptionPtr()));
+      s.runToCompletionAsync(WaitingTaskHolder(group, &globalWaitTask));
     }
+    globalWaitTask.wait();
 #endif
   }
 